@@ -9,6 +9,7 @@
 #include "../render/includes/SkyBox.h"
 #include "../render/includes/TestCube.h"
 #include "../render/includes/FrameCommander.h"
+#include "../render/includes/ModelLoader.h"
 #include <set>
 
 namespace Cube
@@ -31,6 +32,8 @@ namespace Cube
 
 		//   
 		void HadleInput(float dt);
+		//       ,   [-1, 1]
+		Model* PickModel(float ndcX, float ndcY);
 
 		//  ImGui
 		void ShowSceneWindow();
@@ -50,6 +53,8 @@ namespace Cube
 		bool projSettWindowOpen = false;
 		bool drawGrid = true;
 		bool nofpslimit = true;
+		size_t frameAllocations = 0u;
+		size_t frameDeviceObjects = 0u;
 
 		//  
 		void doFrame();					
@@ -59,14 +64,20 @@ namespace Cube
 		Timer timer;
 		Camera cam;
 		Lights light;
+		//BVH   :       
+		SceneBVH bvh;
 		std::vector<std::unique_ptr<Model>> models;
-		ID3D11ShaderResourceView* pCubeIco = nullptr;
+		//    models   
+		ModelLoader loader;
+		//,   BVH   ,     
+		std::vector<std::pair<Model*, bool>> visibleModels;
+		std::shared_ptr<const TextureView> pCubeIco;
 		std::unique_ptr<SkyBox> skybox;
-		Model* pSelectedModel;
+		Model* pSelectedModel = nullptr;
 		std::chrono::milliseconds maxfps = std::chrono::milliseconds(14);
 		std::filesystem::path scenePath = "Unnamed Scene";
 
-		FrameCommander fc;
+		FrameCommander fc{ m_Window.Gfx() };
 
 		TestCube cube{ m_Window.Gfx(),4.0f };
 		TestCube cube2{ m_Window.Gfx(),4.0f };
@@ -0,0 +1,59 @@
+//     .    Graphics  RecordingBackend:
+//FrameCommander, Model::Submit  Lights::Bind    ,       .
+//  --headless,   -   .
+//   WARP-,    ,   Windows
+
+#pragma once
+#include "../render/includes/Graphics.h"
+#include "../render/includes/RecordingBackend.h"
+#include "../render/includes/FrameCommander.h"
+#include "../render/includes/PointLight.h"
+#include "../render/includes/Mesh.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace Cube
+{
+	class HeadlessBench
+	{
+	public:
+		struct Settings
+		{
+			std::string modelPath = "models\\cube.obj";
+			//    gridSize x gridSize
+			int gridSize = 8;
+			size_t lightCount = 4u;
+			//   
+			size_t frames = 200u;
+		};
+		//     RecordingBackend
+		struct FrameCounters
+		{
+			size_t draws = 0u;
+			size_t instancedDraws = 0u;
+			size_t binds = 0u;
+			size_t uploadedBytes = 0u;
+			size_t indices = 0u;
+			bool operator==(const FrameCounters& rhs) const noexcept;
+		};
+	public:
+		HeadlessBench(Settings settings);
+		HeadlessBench(const HeadlessBench&) = delete;
+		HeadlessBench& operator=(const HeadlessBench&) = delete;
+		//  ,        
+		int Run();
+	private:
+		FrameCounters DoFrame();
+		void Check(bool condition, const char* what);
+	private:
+		Settings settings;
+		Graphics gfx;
+		RecordingBackend& recorder;
+		FrameCommander fc{ gfx };
+		Lights light;
+		std::vector<std::unique_ptr<Model>> models;
+		int failed = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+//       operator new
+
+#pragma once
+#include <cstddef>
+
+
+class MemoryStats
+{
+public:
+	//     .        
+	static size_t GetAllocationCount() noexcept;
+};
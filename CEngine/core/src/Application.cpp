@@ -1,5 +1,9 @@
 ﻿#include "../includes/Application.h"
 #include "../render/includes/CVertex.h"
+#include "../render/includes/BindableCodex.h"
+#include "../render/includes/AssetCache.h"
+#include "../render/includes/TextureManager.h"
+#include "../includes/MemoryStats.h"
 #include "../includes/Window.h"
 #include "imgui.h"
 #include "imgui_impl_win32.h"
@@ -34,7 +38,7 @@ namespace Cube
 	{
 		/*models.push_back(std::make_unique<Model>(m_Window.Gfx(), "models\\cube.obj", id, "Cube"));
 		++id;*/
-		m_Window.Gfx().SetTexture(&pCubeIco, L"icons\\cubeico2.png");
+		pCubeIco = m_Window.Gfx().LoadTexture("icons\\cubeico2.png");
 		cube.SetPos({ 4.0f,0.0f,0.0f });
 		cube2.SetPos({ 0.0f,4.0f,0.0f });
 		ScriptEngine::Init();
@@ -46,11 +50,11 @@ namespace Cube
 	{
 		if (scenePath != "Unnamed Scene")
 		{
+			loader.Flush(m_Window.Gfx());
 			SceneSerializer serializer(*this);
 			serializer.Serialize(scenePath);
 		}
 		ScriptEngine::Shutdown();
-		pCubeIco->Release();
 		models.clear();
 		ImGuiSaveStyle("style.style", ImGui::GetStyle());
 	}
@@ -164,6 +168,7 @@ namespace Cube
 	{
 
 		auto dt = timer.Mark();
+		loader.Update(m_Window.Gfx());
 		HadleInput(dt);
 		m_Window.Gfx().ClearBuffer(0.07f, 0.07f, 0.07f);
 		m_Window.Gfx().SetCamera(cam.GetMatrix());
@@ -172,7 +177,24 @@ namespace Cube
 		ImGuiDockNode* node = ImGui::DockBuilderGetCentralNode(did);
 		m_Window.Gfx().CreateViewport(node->Size.x, node->Size.y, node->Pos.x, node->Pos.y);
 		m_Window.Gfx().SetProjection(DirectX::XMMatrixPerspectiveFovLH(to_rad(75.0f), node->Size.x / node->Size.y, 0.01f, 300.0f));
+		fc.SetFrustum(Frustum(m_Window.Gfx().GetCamera() * m_Window.Gfx().GetProjection()));
+		fc.SetView(m_Window.Gfx().GetCamera(), m_Window.Gfx().GetProjection());
+		if (!ImGui::GetIO().WantCaptureMouse && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+		{
+			const auto mouse = ImGui::GetMousePos();
+			const float ndcX = (mouse.x - node->Pos.x) / node->Size.x * 2.0f - 1.0f;
+			const float ndcY = 1.0f - (mouse.y - node->Pos.y) / node->Size.y * 2.0f;
+			if (ndcX >= -1.0f && ndcX <= 1.0f && ndcY >= -1.0f && ndcY <= 1.0f)
+			{
+				if (const auto pPicked = PickModel(ndcX, ndcY))
+				{
+					pSelectedModel = pPicked;
+				}
+			}
+		}
 
+		const auto allocationsBefore = MemoryStats::GetAllocationCount();
+		const auto deviceObjectsBefore = m_Window.Gfx().GetDeviceObjectCount();
 	
 
 		if (skybox)
@@ -181,11 +203,39 @@ namespace Cube
 		}
 
 		light.Bind(m_Window.Gfx(), cam.GetMatrix());
+		fc.SetObjectLights(&light.GetObjectLights());
 	
 
-		for (auto& m : models) 
+		//С отсечением обходятся только видимые ветви BVH, и стоимость зависит от числа видимых моделей, а не от размера сцены
+		bvh.Maintain();
+		visibleModels.clear();
+		if (const auto pFrustum = fc.GetFrustum())
+		{
+			bvh.QueryFrustum(*pFrustum, [this](Model& m, bool inside)
+			{
+				visibleModels.push_back({ &m, inside });
+			});
+		}
+		else
+		{
+			for (auto& m : models)
+			{
+				visibleModels.push_back({ m.get(), false });
+			}
+		}
+		//Окклюдеры видимых моделей рисуются в программный буфер глубины до отправки заданий
+		if (const auto pOcclusion = fc.GetOcclusion())
 		{
-			m->Submit(fc);
+			pOcclusion->BeginFrame(m_Window.Gfx().GetCamera() * m_Window.Gfx().GetProjection());
+			for (const auto& v : visibleModels)
+			{
+				v.first->RasterizeOccluders(*pOcclusion);
+			}
+			pOcclusion->BuildHierarchy();
+		}
+		for (const auto& v : visibleModels)
+		{
+			v.first->Submit(fc, v.second);
 		}
 
 		//cube.Submit(fc); 
@@ -194,7 +244,10 @@ namespace Cube
 		light.drawSpheres(fc);
 		
 		fc.Execute(m_Window.Gfx());
+		frameAllocations = MemoryStats::GetAllocationCount() - allocationsBefore;
+		frameDeviceObjects = m_Window.Gfx().GetDeviceObjectCount() - deviceObjectsBefore;
 
+		loader.DrawPlaceholders(m_Window.Gfx());
 		if (drawGrid)
 		{
 			m_Window.Gfx().DrawGrid(cam.pos);
@@ -235,6 +288,10 @@ namespace Cube
 					std::string name = "Delete " + models[i]->modelName;
 					if (ImGui::MenuItem(name.c_str()))
 					{
+						if (pSelectedModel == models[i].get())
+						{
+							pSelectedModel = nullptr;
+						}
 						models.erase(models.begin() + i);
 					}
 				}
@@ -249,6 +306,8 @@ namespace Cube
 			}
 			if (ImGui::MenuItem("Clear Scene"))
 			{
+				pSelectedModel = nullptr;
+				loader.CancelAll();
 				models.clear();
 				light.clearLights();
 			}
@@ -410,6 +469,10 @@ namespace Cube
 						std::string name = "Delete " + models[i]->modelName;
 						if (ImGui::MenuItem(name.c_str()))
 						{
+							if (pSelectedModel == models[i].get())
+							{
+								pSelectedModel = nullptr;
+							}
 							models.erase(models.begin() + i);
 						}
 					}
@@ -424,6 +487,8 @@ namespace Cube
 				}
 				if (ImGui::MenuItem("Clear Scene"))
 				{
+					pSelectedModel = nullptr;
+					loader.CancelAll();
 					models.clear();
 					light.clearLights();
 				}
@@ -568,31 +633,31 @@ namespace Cube
 				ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.0f);
 				if (ImGui::Button("1"))
 				{
-					skybox.release();
+					skybox.reset();
 					skybox = std::make_unique<SkyBox>(m_Window.Gfx(), "textures\\skyboxmain.dds");
 				}
 				ImGui::SameLine();
 				if (ImGui::Button("2"))
 				{
-					skybox.release();
+					skybox.reset();
 					skybox = std::make_unique<SkyBox>(m_Window.Gfx(), "textures\\skybox2.dds");
 				}
 				ImGui::SameLine();
 				if (ImGui::Button("3"))
 				{
-					skybox.release();
+					skybox.reset();
 					skybox = std::make_unique<SkyBox>(m_Window.Gfx(), "textures\\earth.dds");
 				}
 				if (ImGui::Button("Delete Skybox"))
 				{
-					skybox.release();
+					skybox.reset();
 				}
 				if (ImGui::Button("Load Skybox from file..."))
 				{
 					std::filesystem::path filepath = FileDialogs::OpenfileA("DDS files(*.dds)\0*.dds\0\0");
 					if (!filepath.empty())
 					{
-						skybox.release();
+						skybox.reset();
 						skybox = std::make_unique<SkyBox>(m_Window.Gfx(), filepath.string());
 					}
 				}
@@ -633,6 +698,108 @@ namespace Cube
 		AddCube();
 		ImGui::Checkbox("Draw Grid", &drawGrid);
 
+		const auto codexStats = BindableCodex::GetStats();
+		ImGui::Text("Bindables: %zu", codexStats.size);
+		ImGui::Text("Reused: %zu / %zu", codexStats.hits, codexStats.hits + codexStats.misses);
+		const auto cacheStats = AssetCache::GetStats();
+		ImGui::Text("Asset cache: %zu hits, %zu misses", cacheStats.hits, cacheStats.misses);
+		ImGui::Text("Cache size: %llu / %llu MB, entries: %zu",
+			static_cast<unsigned long long>(cacheStats.size >> 20u),
+			static_cast<unsigned long long>(AssetCache::GetSizeLimit() >> 20u), cacheStats.entries);
+		ImGui::Text("Cache writes: %zu, evictions: %zu", cacheStats.writes, cacheStats.evictions);
+		int cacheLimit = static_cast<int>(AssetCache::GetSizeLimit() >> 20u);
+		if (ImGui::SliderInt("Cache Limit, MB", &cacheLimit, 64, 16384, "%d", ImGuiSliderFlags_Logarithmic))
+		{
+			AssetCache::SetSizeLimit(static_cast<uint64_t>(cacheLimit) << 20u);
+		}
+		if (ImGui::Button("Clear Asset Cache"))
+		{
+			AssetCache::Clear();
+		}
+		const auto textureStats = TextureManager::GetStats();
+		ImGui::Text("Textures: %zu, %llu MB", textureStats.textures,
+			static_cast<unsigned long long>(textureStats.residentBytes >> 20u));
+		ImGui::Text("Texture reuse: %zu by path, %zu by content", textureStats.pathHits, textureStats.contentHits);
+		int uploadBudget = static_cast<int>(loader.GetUploadBudget() >> 20u);
+		if (ImGui::SliderInt("Upload Budget, MB", &uploadBudget, 1, 256, "%d", ImGuiSliderFlags_Logarithmic))
+		{
+			loader.SetUploadBudget(static_cast<size_t>(uploadBudget) << 20u);
+		}
+		ImGui::Text("Uploaded: %zu KB", loader.GetLastFrameUpload() / 1024u);
+		for (const auto& p : loader.GetProgress())
+		{
+			static const char* const stageNames[] = { "Queued", "Meshes", "Textures", "Uploading", "Failed" };
+			const std::string label = p.name + ": " + stageNames[static_cast<int>(p.stage)];
+			ImGui::ProgressBar(p.fraction, ImVec2(-1.0f, 0.0f), label.c_str());
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("%s", p.path.c_str());
+			}
+		}
+		const auto& bindStats = m_Window.Gfx().GetBindStats();
+		ImGui::Text("Binds: %zu", bindStats.issued);
+		ImGui::Text("Skipped: %zu", bindStats.skipped);
+
+		bool sortJobs = fc.IsSortingEnabled();
+		if (ImGui::Checkbox("Sort Jobs", &sortJobs))
+		{
+			fc.EnableSorting(sortJobs);
+		}
+		ImGui::Text("Sort: %.3f ms", fc.GetSortTime());
+		ImGui::Text("Transforms: %.3f ms", fc.GetPackTime());
+		bool instancing = fc.IsInstancingEnabled();
+		if (ImGui::Checkbox("Instancing", &instancing))
+		{
+			fc.EnableInstancing(instancing);
+		}
+		ImGui::Text("Draw calls: %zu", m_Window.Gfx().GetDrawCallCount());
+		bool culling = fc.IsCullingEnabled();
+		if (ImGui::Checkbox("Frustum Culling", &culling))
+		{
+			fc.EnableCulling(culling);
+		}
+		const auto& cullStats = fc.GetCullStats();
+		ImGui::Text("Visible: %zu", cullStats.visible);
+		ImGui::Text("Culled: %zu", cullStats.culled);
+		bool occlusion = fc.IsOcclusionEnabled();
+		if (ImGui::Checkbox("Occlusion Culling", &occlusion))
+		{
+			fc.EnableOcclusion(occlusion);
+		}
+		const auto& occlusionStats = fc.GetOcclusionStats();
+		ImGui::Text("Occluded: %zu / %zu", occlusionStats.occluded, occlusionStats.tested);
+		ImGui::Text("Occluder triangles: %zu", occlusionStats.occluderTriangles);
+		bool lod = fc.IsLodEnabled();
+		if (ImGui::Checkbox("LOD", &lod))
+		{
+			fc.EnableLod(lod);
+		}
+		const auto& triangleStats = fc.GetTriangleStats();
+		ImGui::Text("Triangles: %zu / %zu", triangleStats.submitted, triangleStats.full);
+		const auto bvhStats = bvh.GetStats();
+		ImGui::Text("BVH nodes: %zu / %zu", bvhStats.visited, bvhStats.nodes);
+		ImGui::Text("BVH refits: %zu, rebuilds: %zu", bvhStats.refits, bvhStats.rebuilds);
+		const auto& clusterStats = light.GetClusterStats();
+		ImGui::Text("Clustered lights: %zu, max per cluster: %zu", clusterStats.lights, clusterStats.maxPerCluster);
+		ImGui::Text("Light uploads: %zu", light.GetUploadCount());
+		bool lightLists = fc.IsLightListsEnabled();
+		if (ImGui::Checkbox("Per-object Lights", &lightLists))
+		{
+			fc.EnableLightLists(lightLists);
+		}
+		float cutoff = light.GetCutoffLuminance();
+		if (ImGui::SliderFloat("Light Cutoff", &cutoff, 0.001f, 0.1f, "%.4f", ImGuiSliderFlags_Logarithmic))
+		{
+			light.SetCutoffLuminance(cutoff);
+		}
+		const auto& objectLightStats = light.GetObjectLights().GetStats();
+		ImGui::Text("Object lights: %zu for %zu meshes, truncated: %zu", objectLightStats.assigned, objectLightStats.objects, objectLightStats.truncated);
+		ImGui::Text("Allocations: %zu", frameAllocations);
+		ImGui::Text("Created objects: %zu", frameDeviceObjects);
+		const auto& arena = fc.GetArena();
+		ImGui::Text("Frame memory: %zu KB", arena.GetLastFrameUsage() / 1024u);
+		ImGui::Text("Peak: %zu / %zu KB", arena.GetPeak() / 1024u, arena.GetCapacity() / 1024u);
+
 		auto th = ImGui::GetWindowHeight();
 		std::string text = "%.1f FPS";
 		ImGui::SetCursorPosY(th - ImGui::CalcTextSize(text.c_str()).y - 10.0f); 
@@ -641,13 +808,28 @@ namespace Cube
 		ImGui::End();
 	}
 
+	Model* Application::PickModel(float ndcX, float ndcY)
+	{
+		namespace dx = DirectX;
+		const auto invViewProj = dx::XMMatrixInverse(nullptr, m_Window.Gfx().GetCamera() * m_Window.Gfx().GetProjection());
+		const auto nearPoint = dx::XMVector3TransformCoord(dx::XMVectorSet(ndcX, ndcY, 0.0f, 1.0f), invViewProj);
+		const auto farPoint = dx::XMVector3TransformCoord(dx::XMVectorSet(ndcX, ndcY, 1.0f, 1.0f), invViewProj);
+		const auto ray = dx::XMVectorSubtract(farPoint, nearPoint);
+		const float length = dx::XMVectorGetX(dx::XMVector3Length(ray));
+		return bvh.Raycast(nearPoint, dx::XMVectorScale(ray, 1.0f / length), length);
+	}
+
 	void Application::AddObj()
 	{
 
 		std::filesystem::path filepath = FileDialogs::OpenfileA("OBJ files(*.obj)\0*.obj\0GLTF files(*.gltf)\0*.gltf\0FBX files(*.fbx)\0*.fbx\0MD5MESH files(*.md5mesh)\0*.md5mesh\0\0");
 		if (!filepath.empty())
 		{
-			models.push_back(std::make_unique<Model>(m_Window.Gfx(), filepath.string(), id));
+			loader.Request(filepath.string(), id, "Unnamed Object", [this](std::unique_ptr<Model> pModel)
+			{
+				models.push_back(std::move(pModel));
+				models.back()->Attach(bvh);
+			});
 			++id;
 		}
 	}
@@ -655,11 +837,15 @@ namespace Cube
 	void Application::AddCube()
 	{
 
-		ImGui::Image((void*)pCubeIco, ImVec2{ 24.0f, 24.0f });
+		ImGui::Image((void*)pCubeIco->Get(), ImVec2{ 24.0f, 24.0f });
 		ImGui::SameLine();
 		if (ImGui::Button("Add Cube"))
 		{
-			models.push_back(std::make_unique<Model>(m_Window.Gfx(), "models\\cube.obj", id, "Cube"));
+			loader.Request("models\\cube.obj", id, "Cube", [this](std::unique_ptr<Model> pModel)
+			{
+				models.push_back(std::move(pModel));
+				models.back()->Attach(bvh);
+			});
 			++id;
 		}
 	}
@@ -667,8 +853,10 @@ namespace Cube
 
 	void Application::newScene()
 	{
-		skybox.release();
+		skybox.reset();
 		skybox = std::make_unique<SkyBox>(m_Window.Gfx(), "textures\\skyboxmain.dds");
+		pSelectedModel = nullptr;
+		loader.CancelAll();
 		models.clear();
 		light.clearLights();
 		scenePath = "Unnamed Scene";
@@ -687,6 +875,7 @@ namespace Cube
 	}
 	void Application::saveScene()
 	{
+		loader.Flush(m_Window.Gfx());
 		SceneSerializer serializer(*this);
 		serializer.Serialize(scenePath);
 	}
@@ -695,6 +884,7 @@ namespace Cube
 		std::filesystem::path filepath = FileDialogs::Savefile("Cube Scene (*.cubeproj)\0*.cubeproj\0\0");
 		if (!filepath.empty())
 		{
+			loader.Flush(m_Window.Gfx());
 			SceneSerializer serializer(*this);
 			serializer.Serialize(filepath);
 			scenePath = filepath.string();
@@ -2,6 +2,8 @@
 
 #include "../includes/Log.h"
 #include "../includes/Application.h"
+#include "../includes/HeadlessBench.h"
+#include <string>
 
 
 
@@ -11,6 +13,20 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLi
 	// 
 	Cube::Log::init();
 
+	//--headless [  ]:    ,   -   
+	const std::string cmdLine = lpCmdLine;
+	const std::string headlessKey = "--headless";
+	if (cmdLine.compare(0, headlessKey.size(), headlessKey) == 0)
+	{
+		Cube::HeadlessBench::Settings settings;
+		const auto modelStart = cmdLine.find_first_not_of(" \t\"", headlessKey.size());
+		if (modelStart != std::string::npos)
+		{
+			settings.modelPath = cmdLine.substr(modelStart, cmdLine.find_last_not_of(" \t\"") + 1u - modelStart);
+		}
+		return Cube::HeadlessBench(std::move(settings)).Run();
+	}
+
 	//  
 	Cube::Application app(GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN), Cube::WindowType::CUSTOM);	
 
@@ -0,0 +1,155 @@
+#include "../includes/HeadlessBench.h"
+#include "../includes/CMath.h"
+#include "../includes/Log.h"
+#include <chrono>
+#include <cmath>
+
+
+namespace Cube
+{
+	namespace
+	{
+		constexpr int Width = 1280;
+		constexpr int Height = 720;
+		constexpr float Spacing = 3.0f;
+	}
+
+	bool HeadlessBench::FrameCounters::operator==(const FrameCounters& rhs) const noexcept
+	{
+		return draws == rhs.draws && instancedDraws == rhs.instancedDraws && binds == rhs.binds &&
+			uploadedBytes == rhs.uploadedBytes && indices == rhs.indices;
+	}
+
+	HeadlessBench::HeadlessBench(Settings settings_in)
+		:
+		settings(std::move(settings_in)),
+		//   ,       
+		gfx(std::make_unique<RecordingBackend>(false), Width, Height),
+		recorder(static_cast<RecordingBackend&>(gfx.GetBackend())),
+		light(gfx)
+	{
+		namespace dx = DirectX;
+		const float half = float(settings.gridSize - 1) * Spacing * 0.5f;
+		for (int z = 0; z < settings.gridSize; ++z)
+		{
+			for (int x = 0; x < settings.gridSize; ++x)
+			{
+				auto pModel = std::make_unique<Model>(gfx, settings.modelPath, int(models.size()), "Bench Model");
+				pModel->SetRootTransfotm(dx::XMMatrixTranslation(float(x) * Spacing - half, 0.0f, float(z) * Spacing - half));
+				pModel->Update();
+				models.push_back(std::move(pModel));
+			}
+		}
+		while (light.sceneLights.size() < settings.lightCount)
+		{
+			light.AddLight(gfx, "Bench Light");
+		}
+		for (size_t i = 0u; i < light.sceneLights.size(); ++i)
+		{
+			auto cbuf = light.sceneLights[i]->getCbuf();
+			const float angle = to_rad(360.0f) * float(i) / float(light.sceneLights.size());
+			cbuf.pos = { std::cos(angle) * half, 2.0f, std::sin(angle) * half };
+			light.sceneLights[i]->setCbuf(cbuf);
+		}
+		gfx.SetCamera(dx::XMMatrixLookAtLH(dx::XMVectorSet(0.0f, half, -half * 2.0f, 1.0f), dx::XMVectorZero(), dx::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+		gfx.SetProjection(dx::XMMatrixPerspectiveFovLH(to_rad(75.0f), float(Width) / float(Height), 0.01f, 300.0f));
+	}
+
+	int HeadlessBench::Run()
+	{
+		namespace dx = DirectX;
+		CUBE_INFO("Headless bench: {} models of {}, {} lights", models.size(), settings.modelPath, light.sceneLights.size());
+
+		//    ,   Graphics  StateTracker
+		const auto first = DoFrame();
+		Check(first.draws + first.instancedDraws > 0u && first.indices > 0u, "scene produces draw calls");
+		Check(first.draws + first.instancedDraws == gfx.GetDrawCallCount(), "recorded draws match Graphics draw count");
+		Check(first.binds == gfx.GetBindStats().issued, "recorded binds match StateTracker issued binds");
+
+		//    :     ,         
+		const auto second = DoFrame();
+		Check(light.GetUploadCount() == 1u, "unchanged lights are uploaded once");
+		Check(second.uploadedBytes < first.uploadedBytes, "second frame uploads less than the first");
+
+		const auto start = std::chrono::steady_clock::now();
+		FrameCounters last;
+		for (size_t i = 0u; i < settings.frames; ++i)
+		{
+			last = DoFrame();
+		}
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		Check(last == second, "command stream is stable between frames");
+		CUBE_INFO("Headless bench: {:.3f} ms per frame, {} draws ({} instanced), {} binds ({} skipped), {} bytes uploaded, {} indices",
+			settings.frames > 0u ? elapsed.count() / double(settings.frames) : 0.0,
+			last.draws + last.instancedDraws, last.instancedDraws, last.binds, gfx.GetBindStats().skipped, last.uploadedBytes, last.indices);
+
+		//       
+		fc.EnableInstancing(false);
+		const auto single = DoFrame();
+		fc.EnableInstancing(true);
+		Check(single.instancedDraws == 0u, "no instanced draws with instancing disabled");
+		Check(single.indices == last.indices, "instancing keeps the submitted index count");
+		Check(last.draws + last.instancedDraws <= single.draws, "instancing does not add draw calls");
+
+		//   :    
+		const auto camera = gfx.GetCamera();
+		gfx.SetCamera(dx::XMMatrixLookAtLH(dx::XMVectorSet(0.0f, 0.0f, -1000.0f, 1.0f), dx::XMVectorSet(0.0f, 0.0f, -2000.0f, 1.0f), dx::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+		const auto away = DoFrame();
+		gfx.SetCamera(camera);
+		Check(away.indices < last.indices, "frustum culling drops models behind the camera");
+
+		if (failed == 0)
+		{
+			CUBE_INFO("Headless bench: all checks passed");
+		}
+		return failed;
+	}
+
+	HeadlessBench::FrameCounters HeadlessBench::DoFrame()
+	{
+		gfx.ClearBuffer(0.0f, 0.0f, 0.0f);
+		recorder.Clear();
+		fc.SetFrustum(Frustum(gfx.GetCamera() * gfx.GetProjection()));
+		fc.SetView(gfx.GetCamera(), gfx.GetProjection());
+		light.Bind(gfx, gfx.GetCamera());
+		fc.SetObjectLights(&light.GetObjectLights());
+		if (const auto pOcclusion = fc.GetOcclusion())
+		{
+			pOcclusion->BeginFrame(gfx.GetCamera() * gfx.GetProjection());
+			for (const auto& pModel : models)
+			{
+				pModel->RasterizeOccluders(*pOcclusion);
+			}
+			pOcclusion->BuildHierarchy();
+		}
+		for (const auto& pModel : models)
+		{
+			pModel->Submit(fc);
+		}
+		light.drawSpheres(fc);
+		fc.Execute(gfx);
+		gfx.EndFrame();
+		fc.Reset();
+
+		FrameCounters counters;
+		counters.draws = recorder.GetCount(RecordingBackend::CommandType::DrawIndexed);
+		counters.instancedDraws = recorder.GetCount(RecordingBackend::CommandType::DrawIndexedInstanced);
+		counters.binds = recorder.GetBindCount();
+		counters.uploadedBytes = recorder.GetUploadedBytes();
+		counters.indices = recorder.GetIndexCount();
+		return counters;
+	}
+
+	void HeadlessBench::Check(bool condition, const char* what)
+	{
+		if (condition)
+		{
+			CUBE_TRACE("Headless bench check passed: {}", what);
+		}
+		else
+		{
+			CUBE_ERROR("Headless bench check failed: {}", what);
+			++failed;
+		}
+	}
+}
\ No newline at end of file
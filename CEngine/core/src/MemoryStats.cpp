@@ -0,0 +1,54 @@
+#include "../includes/MemoryStats.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<size_t> allocationCount{ 0u };
+
+	void* CountedAlloc(size_t size)
+	{
+		allocationCount.fetch_add(1u, std::memory_order_relaxed);
+		if (void* p = std::malloc(size == 0u ? 1u : size))
+		{
+			return p;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+size_t MemoryStats::GetAllocationCount() noexcept
+{
+	return allocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+	return CountedAlloc(size);
+}
+
+void* operator new[](size_t size)
+{
+	return CountedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	std::free(p);
+}
\ No newline at end of file
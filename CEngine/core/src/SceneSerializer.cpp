@@ -158,7 +158,7 @@ namespace Cube
 		auto skynewabsolute = filepath.parent_path().string() + '\\' + data["Skybox"].as<std::string>(); 
 		if (std::filesystem::exists(skynewabsolute))
 		{
-			pApp->skybox.release();
+			pApp->skybox.reset();
 			pApp->skybox = std::make_unique<SkyBox>(pApp->m_Window.Gfx(), skynewabsolute);
 			CUBE_TRACE(std::string("Loaded skybox file  " + skynewabsolute).c_str());
 		}
@@ -169,43 +169,64 @@ namespace Cube
 
 		if (models)
 		{
+			pApp->pSelectedModel = nullptr;
+			pApp->loader.CancelAll();
 			pApp->models.clear();
 			for (auto model : models)
 			{
 				auto newabsolute = filepath.parent_path().string() + '\\' + model["Path"].as<std::string>();
 				if (std::filesystem::exists(newabsolute))
 				{
-					pApp->models.push_back(std::make_unique<Model>(pApp->m_Window.Gfx(), newabsolute,
-						model["Model"].as<int>(),
-						model["Name"].as<std::string>()));
-					pApp->id++;
-					DirectX::XMFLOAT3 rtc = model["Root Node Translation"].as<DirectX::XMFLOAT3>();
-					DirectX::XMFLOAT3 rsc = model["Root Node Scaling"].as<DirectX::XMFLOAT3>();
-					DirectX::XMFLOAT3 ra = model["Root Node Angles"].as<DirectX::XMFLOAT3>();
-					pApp->models[model["Model"].as<int>()]->SetRootTransfotm(DirectX::XMMatrixRotationRollPitchYaw(ra.x, ra.y, ra.z) *
-						DirectX::XMMatrixScaling(rsc.x, rsc.y, rsc.z) *
-						DirectX::XMMatrixTranslation(rtc.x, rtc.y, rtc.z));
-					pApp->models[model["Model"].as<int>()]->SetRootScaling(DirectX::XMMatrixScaling(rsc.x, rsc.y, rsc.z));
-					auto& childptrs = pApp->models[model["Model"].as<int>()]->getpRoot().getchildPtrs();
+					//   ,   ,    
+					struct ChildTransform
+					{
+						int child;
+						DirectX::XMFLOAT3 tc;
+						DirectX::XMFLOAT3 sc;
+						DirectX::XMFLOAT3 a;
+					};
+					std::vector<ChildTransform> childTransforms;
 					auto childs = model["Child Nodes"];
 					for (auto child : childs)
 					{
 						if (child)
 						{
-							DirectX::XMFLOAT3 tc = child["Translation"].as<DirectX::XMFLOAT3>();
-							DirectX::XMFLOAT3 sc = child["Scaling"].as<DirectX::XMFLOAT3>();
-							DirectX::XMFLOAT3 a = child["Angles"].as<DirectX::XMFLOAT3>();
-							childptrs[child["Child"].as<int>()]->SetAppliedTransform(DirectX::XMMatrixRotationRollPitchYaw(a.x, a.y, a.z) *
-								DirectX::XMMatrixScaling(sc.x, sc.y, sc.z) *
-								DirectX::XMMatrixTranslation(tc.x, tc.y, tc.z));
-							childptrs[child["Child"].as<int>()]->SetAppliedScale(DirectX::XMMatrixScaling(sc.x, sc.y, sc.z));
+							childTransforms.push_back({ child["Child"].as<int>(),
+								child["Translation"].as<DirectX::XMFLOAT3>(),
+								child["Scaling"].as<DirectX::XMFLOAT3>(),
+								child["Angles"].as<DirectX::XMFLOAT3>() });
 						}
 						else
 						{
 							CUBE_ERROR(std::string("Unable to load child " + child["Child"].as<std::string>()));
 						}
 					}
-					CUBE_TRACE(std::string("Loaded model file  " + newabsolute).c_str());
+					DirectX::XMFLOAT3 rtc = model["Root Node Translation"].as<DirectX::XMFLOAT3>();
+					DirectX::XMFLOAT3 rsc = model["Root Node Scaling"].as<DirectX::XMFLOAT3>();
+					DirectX::XMFLOAT3 ra = model["Root Node Angles"].as<DirectX::XMFLOAT3>();
+					DirectX::XMFLOAT4X4 rootTransform;
+					DirectX::XMStoreFloat4x4(&rootTransform, DirectX::XMMatrixRotationRollPitchYaw(ra.x, ra.y, ra.z) *
+						DirectX::XMMatrixScaling(rsc.x, rsc.y, rsc.z) *
+						DirectX::XMMatrixTranslation(rtc.x, rtc.y, rtc.z));
+					const auto handle = pApp->loader.Request(newabsolute, model["Model"].as<int>(), model["Name"].as<std::string>(),
+						[pApp = pApp, rootTransform, rsc, childTransforms, newabsolute](std::unique_ptr<Model> pModel)
+					{
+						pModel->SetRootTransfotm(DirectX::XMLoadFloat4x4(&rootTransform));
+						pModel->SetRootScaling(DirectX::XMMatrixScaling(rsc.x, rsc.y, rsc.z));
+						auto& childptrs = pModel->getpRoot().getchildPtrs();
+						for (const auto& c : childTransforms)
+						{
+							childptrs[c.child]->SetAppliedTransform(DirectX::XMMatrixRotationRollPitchYaw(c.a.x, c.a.y, c.a.z) *
+								DirectX::XMMatrixScaling(c.sc.x, c.sc.y, c.sc.z) *
+								DirectX::XMMatrixTranslation(c.tc.x, c.tc.y, c.tc.z));
+							childptrs[c.child]->SetAppliedScale(DirectX::XMMatrixScaling(c.sc.x, c.sc.y, c.sc.z));
+						}
+						pApp->models.push_back(std::move(pModel));
+						pApp->models.back()->Attach(pApp->bvh);
+						CUBE_TRACE(std::string("Loaded model file  " + newabsolute).c_str());
+					});
+					pApp->loader.SetPlacement(handle, DirectX::XMLoadFloat4x4(&rootTransform));
+					pApp->id++;
 				}
 				else
 				{
@@ -0,0 +1,66 @@
+//   :   .cubemesh      .
+//  -        ,  
+//      ,       - .
+//,     (.mtl, .bin),    :     ,       .
+//    ,  ,      
+
+#pragma once
+#include "MappedFile.h"
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+class AssetCache
+{
+public:
+	struct Stats
+	{
+		size_t hits = 0u;
+		size_t misses = 0u;
+		size_t writes = 0u;
+		size_t evictions = 0u;
+		size_t entries = 0u;
+		uint64_t size = 0u;
+		uint64_t bytesRead = 0u;
+		uint64_t bytesWritten = 0u;
+	};
+	//     .       
+	static constexpr uint32_t EngineVersion = 1u;
+	//    .   -    
+	static std::string MakeKey(const std::filesystem::path& sourcePath, const std::string& settings);
+	//     ,    . false -    
+	static bool HashFile(const std::filesystem::path& path, uint64_t& hash);
+	//    ,         
+	static std::string ExtendKey(const std::string& key, const std::vector<uint64_t>& dependencyHashes);
+	//        .    
+	static bool Open(const std::string& key, const std::string& extension, MappedFile& file);
+	//           
+	static void Store(const std::string& key, const std::string& extension, const void* pData, size_t size);
+	static void SetDirectory(const std::filesystem::path& directory);
+	static void SetSizeLimit(uint64_t bytes);
+	static uint64_t GetSizeLimit();
+	static Stats GetStats();
+	//  ,     
+	static void Clear();
+private:
+	struct Entry
+	{
+		uint64_t size = 0u;
+		std::filesystem::file_time_type lastUse;
+	};
+	static AssetCache& Get();
+	//       ,     
+	void ScanLocked();
+	void EvictLocked(const std::string& keep);
+private:
+	std::mutex mtx;
+	std::filesystem::path directory = "cache";
+	uint64_t sizeLimit = uint64_t(1024u) * 1024u * 1024u;
+	bool scanned = false;
+	std::unordered_map<std::string, Entry> entries;
+	Stats stats;
+};
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #pragma once
 #include "Graphics.h"
+#include <memory>
+#include <string>
 
 class Drawable;
 
@@ -13,8 +15,24 @@ class Drawable;
 		virtual void Bind(Graphics& gfx) noexcept = 0;
 		virtual void InitializeParentReference(const Drawable&) noexcept
 		{}
+		//    BindableCodex.   -   
+		virtual std::string GetUID() const noexcept
+		{
+			return {};
+		}
 		virtual ~Bindable() = default;
 	protected:
 		static ID3D11DeviceContext* GetContext(Graphics& gfx);
 		static ID3D11Device* GetDevice(Graphics& gfx);
+		//     ,      
+		static StateTracker& GetState(Graphics& gfx);
+		//    ,       
+		static RenderBackend& GetBackend(Graphics& gfx);
+	};
+
+	//Bindable,      Drawable      Step
+	class CloningBindable : public Bindable
+	{
+	public:
+		virtual std::unique_ptr<CloningBindable> Clone() const noexcept = 0;
 	};
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "PixelShader.h"
 #include "Topology.h"
 #include "TransformCbuf.h"
+#include "LightListCbuf.h"
 #include "VertexBuffer.h"
 #include "VertexShader.h"
 #include "SkyboxTransformCBuf.h"
@@ -0,0 +1,106 @@
+//  Bindable .         
+
+#pragma once
+#include "Bindable.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+
+	class BindableCodex
+	{
+	public:
+		struct Stats
+		{
+			size_t hits = 0u;
+			size_t misses = 0u;
+			size_t size = 0u;
+		};
+		//   T,     .
+		//  T::GenerateUID    ,    
+		template<class T, typename...Params>
+		static std::shared_ptr<T> Resolve(Graphics& gfx, Params&&...p)
+		{
+			static_assert(std::is_base_of<Bindable, T>::value, "Can only resolve classes derived from Bindable");
+			return Get().ResolveImpl<T>(gfx, std::forward<Params>(p)...);
+		}
+		// ,      :      ,
+		//     .  ,    
+		template<class T, typename...Params>
+		static std::shared_ptr<T> ResolveWeak(Graphics& gfx, Params&&...p)
+		{
+			static_assert(std::is_base_of<Bindable, T>::value, "Can only resolve classes derived from Bindable");
+			return Get().ResolveWeakImpl<T>(gfx, std::forward<Params>(p)...);
+		}
+		static Stats GetStats() noexcept
+		{
+			auto& codex = Get();
+			std::lock_guard<std::mutex> lock(codex.mtx);
+			return { codex.hits, codex.misses, codex.binds.size() + codex.weakBinds.size() };
+		}
+		static void ResetStats() noexcept
+		{
+			auto& codex = Get();
+			std::lock_guard<std::mutex> lock(codex.mtx);
+			codex.hits = 0u;
+			codex.misses = 0u;
+		}
+	private:
+		template<class T, typename...Params>
+		std::shared_ptr<T> ResolveImpl(Graphics& gfx, Params&&...p)
+		{
+			const auto key = T::GenerateUID(p...);
+			std::lock_guard<std::mutex> lock(mtx);
+			const auto i = binds.find(key);
+			if (i == binds.end())
+			{
+				++misses;
+				auto bind = std::make_shared<T>(gfx, std::forward<Params>(p)...);
+				binds[key] = bind;
+				return bind;
+			}
+			++hits;
+			return std::static_pointer_cast<T>(i->second);
+		}
+		template<class T, typename...Params>
+		std::shared_ptr<T> ResolveWeakImpl(Graphics& gfx, Params&&...p)
+		{
+			const auto key = T::GenerateUID(p...);
+			std::lock_guard<std::mutex> lock(mtx);
+			auto& slot = weakBinds[key];
+			if (auto bind = slot.lock())
+			{
+				++hits;
+				return std::static_pointer_cast<T>(bind);
+			}
+			++misses;
+			auto bind = std::make_shared<T>(gfx, std::forward<Params>(p)...);
+			slot = bind;
+			//   ,     ,  
+			if (weakBinds.size() >= weakPurgeSize)
+			{
+				for (auto i = weakBinds.begin(); i != weakBinds.end();)
+				{
+					i = i->second.expired() ? weakBinds.erase(i) : std::next(i);
+				}
+				weakPurgeSize = std::max<size_t>(weakBinds.size() * 2u, 64u);
+			}
+			return bind;
+		}
+		static BindableCodex& Get()
+		{
+			static BindableCodex codex;
+			return codex;
+		}
+	private:
+		std::mutex mtx;
+		std::unordered_map<std::string, std::shared_ptr<Bindable>> binds;
+		std::unordered_map<std::string, std::weak_ptr<Bindable>> weakBinds;
+		size_t weakPurgeSize = 64u;
+		size_t hits = 0u;
+		size_t misses = 0u;
+	};
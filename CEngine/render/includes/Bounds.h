@@ -0,0 +1,54 @@
+//          
+
+#pragma once
+#include <DirectXMath.h>
+#include <cstddef>
+
+
+//AABB      .     
+struct BoundingVolume
+{
+	DirectX::XMFLOAT3 center = { 0.0f,0.0f,0.0f };
+	DirectX::XMFLOAT3 extents = { 0.0f,0.0f,0.0f };
+	float radius = -1.0f;
+
+	bool IsEmpty() const noexcept
+	{
+		return radius < 0.0f;
+	}
+	//   , stride -     
+	static BoundingVolume FromPoints(const DirectX::XMFLOAT3* pPoints, size_t count, size_t stride = sizeof(DirectX::XMFLOAT3)) noexcept;
+	static BoundingVolume Merge(const BoundingVolume& a, const BoundingVolume& b) noexcept;
+	//  : AABB     ,
+	//      
+	BoundingVolume Transform(DirectX::FXMMATRIX transform) const noexcept;
+	//   AABB. tEnter  tExit -      dir, tEnter < 0,    .
+	//false - AABB      
+	bool IntersectRay(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, float& tEnter, float& tExit) const noexcept;
+};
+
+
+class Frustum
+{
+public:
+	enum class Result
+	{
+		Outside,
+		Intersects,
+		Inside
+	};
+public:
+	Frustum() = default;
+	//    view * proj     
+	explicit Frustum(DirectX::FXMMATRIX viewProj) noexcept;
+	Result Test(const BoundingVolume& worldBounds) const noexcept;
+	// ,        transform
+	Result Test(const BoundingVolume& bounds, DirectX::FXMMATRIX transform) const noexcept;
+private:
+	//  :       ,
+	//      .      
+	DirectX::XMFLOAT4A planeX[2] = {};
+	DirectX::XMFLOAT4A planeY[2] = {};
+	DirectX::XMFLOAT4A planeZ[2] = {};
+	DirectX::XMFLOAT4A planeW[2] = {};
+};
\ No newline at end of file
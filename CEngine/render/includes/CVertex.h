@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
+#include <string>
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <cmath>
 #include <type_traits>
 #include "Graphics.h"
 
@@ -28,6 +31,12 @@ namespace CubeR
 			Float3Color,
 			Float4Color,
 			BGRAColor,
+			// :      half,    ,
+			//      Tangent  Bitangent.    
+			Position3DHalf,
+			Texture2DHalf,
+			NormalOct,
+			TangentFrame,
 			Count,
 		};
 		template<ElementType> struct Map;
@@ -36,54 +45,132 @@ namespace CubeR
 			using SysType = DirectX::XMFLOAT2;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32_FLOAT;
 			static constexpr const char* semantic = "Position";
+			static constexpr const char* code = "P2";
 		};
 		template<> struct Map<Position3D>
 		{
 			using SysType = DirectX::XMFLOAT3;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32B32_FLOAT;
 			static constexpr const char* semantic = "Position";
+			static constexpr const char* code = "P3";
 		};
 		template<> struct Map<Texture2D>
 		{
 			using SysType = DirectX::XMFLOAT2;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32_FLOAT;
 			static constexpr const char* semantic = "TexCoord";
+			static constexpr const char* code = "T2";
 		};
 		template<> struct Map<Normal>
 		{
 			using SysType = DirectX::XMFLOAT3;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32B32_FLOAT;
 			static constexpr const char* semantic = "Normal";
+			static constexpr const char* code = "N";
 		};
 		template<> struct Map<Tangent>
 		{
 			using SysType = DirectX::XMFLOAT3;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32B32_FLOAT;
 			static constexpr const char* semantic = "Tangent";
+			static constexpr const char* code = "Nt";
 		};
 		template<> struct Map<Bitangent>
 		{
 			using SysType = DirectX::XMFLOAT3;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32B32_FLOAT;
 			static constexpr const char* semantic = "Bitangent";
+			static constexpr const char* code = "Nb";
 		};
 		template<> struct Map<Float3Color>
 		{
 			using SysType = DirectX::XMFLOAT3;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32B32_FLOAT;
 			static constexpr const char* semantic = "Color";
+			static constexpr const char* code = "C3";
 		};
 		template<> struct Map<Float4Color>
 		{
 			using SysType = DirectX::XMFLOAT4;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R32G32B32A32_FLOAT;
 			static constexpr const char* semantic = "Color";
+			static constexpr const char* code = "C4";
 		};
 		template<> struct Map<BGRAColor>
 		{
 			using SysType = CubeR::BGRAColor;
 			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
 			static constexpr const char* semantic = "Color";
+			static constexpr const char* code = "C8";
+		};
+		template<> struct Map<Position3DHalf>
+		{
+			//    ,  R16G16B16_FLOAT 
+			using SysType = DirectX::PackedVector::XMHALF4;
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16B16A16_FLOAT;
+			static constexpr const char* semantic = "Position";
+			static constexpr const char* code = "P3h";
+			static SysType Encode(const DirectX::XMFLOAT3& p) noexcept
+			{
+				SysType packed;
+				DirectX::PackedVector::XMStoreHalf4(&packed, DirectX::XMVectorSet(p.x, p.y, p.z, 1.0f));
+				return packed;
+			}
+			static DirectX::XMFLOAT3 Decode(const SysType& packed) noexcept
+			{
+				DirectX::XMFLOAT3 p;
+				DirectX::XMStoreFloat3(&p, DirectX::PackedVector::XMLoadHalf4(&packed));
+				return p;
+			}
+		};
+		template<> struct Map<Texture2DHalf>
+		{
+			using SysType = DirectX::PackedVector::XMHALF2;
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16_FLOAT;
+			static constexpr const char* semantic = "TexCoord";
+			static constexpr const char* code = "T2h";
+			static SysType Encode(const DirectX::XMFLOAT2& t) noexcept
+			{
+				return SysType(t.x, t.y);
+			}
+		};
+		template<> struct Map<NormalOct>
+		{
+			using SysType = DirectX::PackedVector::XMSHORTN2;
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16_SNORM;
+			static constexpr const char* semantic = "Normal";
+			static constexpr const char* code = "No";
+			//   |x|+|y|+|z|=1,      
+			static SysType Encode(const DirectX::XMFLOAT3& n) noexcept
+			{
+				const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+				float x = l1 > 0.0f ? n.x / l1 : 0.0f;
+				float y = l1 > 0.0f ? n.y / l1 : 0.0f;
+				if (n.z < 0.0f)
+				{
+					const float ox = x;
+					x = (1.0f - std::abs(y)) * (ox >= 0.0f ? 1.0f : -1.0f);
+					y = (1.0f - std::abs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+				}
+				SysType packed;
+				DirectX::PackedVector::XMStoreShortN2(&packed, DirectX::XMVectorSet(x, y, 0.0f, 0.0f));
+				return packed;
+			}
+		};
+		template<> struct Map<TangentFrame>
+		{
+			using SysType = DirectX::PackedVector::XMUDECN4;
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R10G10B10A2_UNORM;
+			static constexpr const char* semantic = "Tangent";
+			static constexpr const char* code = "Tf";
+			//xyz -  , w -  : bitangent = cross(normal, tangent) * w
+			static SysType Encode(const DirectX::XMFLOAT4& t) noexcept
+			{
+				SysType packed;
+				DirectX::PackedVector::XMStoreUDecN4(&packed, DirectX::XMVectorSet(
+					t.x * 0.5f + 0.5f, t.y * 0.5f + 0.5f, t.z * 0.5f + 0.5f, t.w < 0.0f ? 0.0f : 1.0f));
+				return packed;
+			}
 		};
 		class Element
 		{
@@ -128,6 +215,14 @@ namespace CubeR
 					return sizeof(Map<Float4Color>::SysType);
 				case BGRAColor:
 					return sizeof(Map<BGRAColor>::SysType);
+				case Position3DHalf:
+					return sizeof(Map<Position3DHalf>::SysType);
+				case Texture2DHalf:
+					return sizeof(Map<Texture2DHalf>::SysType);
+				case NormalOct:
+					return sizeof(Map<NormalOct>::SysType);
+				case TangentFrame:
+					return sizeof(Map<TangentFrame>::SysType);
 				}
 				assert("Invalid element type" && false);
 				return 0u;
@@ -136,6 +231,40 @@ namespace CubeR
 			{
 				return type;
 			}
+			const char* GetCode() const noexcept
+			{
+				switch (type)
+				{
+				case Position2D:
+					return Map<Position2D>::code;
+				case Position3D:
+					return Map<Position3D>::code;
+				case Texture2D:
+					return Map<Texture2D>::code;
+				case Normal:
+					return Map<Normal>::code;
+				case Tangent:
+					return Map<Tangent>::code;
+				case Bitangent:
+					return Map<Bitangent>::code;
+				case Float3Color:
+					return Map<Float3Color>::code;
+				case Float4Color:
+					return Map<Float4Color>::code;
+				case BGRAColor:
+					return Map<BGRAColor>::code;
+				case Position3DHalf:
+					return Map<Position3DHalf>::code;
+				case Texture2DHalf:
+					return Map<Texture2DHalf>::code;
+				case NormalOct:
+					return Map<NormalOct>::code;
+				case TangentFrame:
+					return Map<TangentFrame>::code;
+				}
+				assert("Invalid element type" && false);
+				return "Invalid";
+			}
 			D3D11_INPUT_ELEMENT_DESC GetDesc() const noexcept
 			{
 				switch (type)
@@ -158,6 +287,14 @@ namespace CubeR
 					return GenerateDesc<Float4Color>(GetOffset());
 				case BGRAColor:
 					return GenerateDesc<BGRAColor>(GetOffset());
+				case Position3DHalf:
+					return GenerateDesc<Position3DHalf>(GetOffset());
+				case Texture2DHalf:
+					return GenerateDesc<Texture2DHalf>(GetOffset());
+				case NormalOct:
+					return GenerateDesc<NormalOct>(GetOffset());
+				case TangentFrame:
+					return GenerateDesc<TangentFrame>(GetOffset());
 				}
 				assert("Invalid element type" && false);
 				return { "INVALID",0,DXGI_FORMAT_UNKNOWN,0,0,D3D11_INPUT_PER_VERTEX_DATA,0 };
@@ -203,6 +340,16 @@ namespace CubeR
 		{
 			return elements.size();
 		}
+		//   ,     BindableCodex
+		std::string GetCode() const noexcept
+		{
+			std::string code;
+			for (const auto& e : elements)
+			{
+				code += e.GetCode();
+			}
+			return code;
+		}
 		std::vector<D3D11_INPUT_ELEMENT_DESC> GetD3DLayout() const noexcept
 		{
 			std::vector<D3D11_INPUT_ELEMENT_DESC> desc;
@@ -217,6 +364,108 @@ namespace CubeR
 		std::vector<Element> elements;
 	};
 
+	//        Src:        
+	template<VertexLayout::ElementType Type, typename Src, typename = void>
+	struct IsEncodable : std::false_type {};
+	template<VertexLayout::ElementType Type, typename Src>
+	struct IsEncodable<Type, Src, std::void_t<decltype(VertexLayout::Map<Type>::Encode(std::declval<Src>()))>> : std::true_type {};
+
+	//   Type   pAttribute  ,   
+	template<VertexLayout::ElementType Type, typename Src>
+	void WriteAttribute(char* pAttribute, Src&& val) noexcept
+	{
+		using Dest = typename VertexLayout::Map<Type>::SysType;
+		if constexpr (IsEncodable<Type, Src>::value)
+		{
+			*reinterpret_cast<Dest*>(pAttribute) = VertexLayout::Map<Type>::Encode(std::forward<Src>(val));
+		}
+		else if constexpr (std::is_assignable<Dest, Src>::value)
+		{
+			*reinterpret_cast<Dest*>(pAttribute) = val;
+		}
+		else
+		{
+			assert("Parameter attribute type mismatch" && false);
+		}
+	}
+
+	//,   .     - ,   
+	//            .
+	// InputLayout     VertexLayout    
+	template<VertexLayout::ElementType... Types>
+	class StaticVertexLayout
+	{
+	public:
+		static constexpr size_t ElementCount = sizeof...(Types);
+		static constexpr size_t Stride = (VertexLayout::Element::SizeOf(Types) + ... + 0u);
+		static constexpr size_t Size() noexcept
+		{
+			return Stride;
+		}
+		template<VertexLayout::ElementType Type>
+		static constexpr bool Has() noexcept
+		{
+			return ((Types == Type) || ...);
+		}
+		template<VertexLayout::ElementType Type>
+		static constexpr size_t OffsetOf() noexcept
+		{
+			static_assert(Has<Type>(), "Element type is not in the static layout");
+			constexpr VertexLayout::ElementType types[] = { Types... };
+			size_t offset = 0u;
+			for (const auto t : types)
+			{
+				if (t == Type)
+				{
+					break;
+				}
+				offset += VertexLayout::Element::SizeOf(t);
+			}
+			return offset;
+		}
+		static VertexLayout GetLayout()
+		{
+			VertexLayout layout;
+			(layout.Append(Types), ...);
+			return layout;
+		}
+		operator VertexLayout() const
+		{
+			return GetLayout();
+		}
+		//  .   
+		class Vertex
+		{
+		public:
+			using Layout = StaticVertexLayout;
+			template<VertexLayout::ElementType Type>
+			auto& Attr() noexcept
+			{
+				return *reinterpret_cast<typename VertexLayout::Map<Type>::SysType*>(bytes + OffsetOf<Type>());
+			}
+			template<VertexLayout::ElementType Type>
+			const auto& Attr() const noexcept
+			{
+				return *reinterpret_cast<const typename VertexLayout::Map<Type>::SysType*>(bytes + OffsetOf<Type>());
+			}
+			// Attr,       
+			template<VertexLayout::ElementType Type, typename Src>
+			void Set(Src&& val) noexcept
+			{
+				WriteAttribute<Type>(bytes + OffsetOf<Type>(), std::forward<Src>(val));
+			}
+			//    ,  VertexBuffer::EmplaceBack
+			template<typename ...Params>
+			void SetAll(Params&&... params) noexcept
+			{
+				static_assert(sizeof...(Params) == ElementCount, "Param count doesn't match number of vertex elements");
+				(Set<Types>(std::forward<Params>(params)), ...);
+			}
+		private:
+			alignas(4) char bytes[Stride] = {};
+		};
+	};
+
 	class Vertex
 	{
 		friend class VertexBuffer;
@@ -262,6 +511,18 @@ namespace CubeR
 			case VertexLayout::BGRAColor:
 				SetAttribute<VertexLayout::BGRAColor>(pAttribute, std::forward<T>(val));
 				break;
+			case VertexLayout::Position3DHalf:
+				SetAttribute<VertexLayout::Position3DHalf>(pAttribute, std::forward<T>(val));
+				break;
+			case VertexLayout::Texture2DHalf:
+				SetAttribute<VertexLayout::Texture2DHalf>(pAttribute, std::forward<T>(val));
+				break;
+			case VertexLayout::NormalOct:
+				SetAttribute<VertexLayout::NormalOct>(pAttribute, std::forward<T>(val));
+				break;
+			case VertexLayout::TangentFrame:
+				SetAttribute<VertexLayout::TangentFrame>(pAttribute, std::forward<T>(val));
+				break;
 			default:
 				assert("Bad element type" && false);
 			}
@@ -286,15 +547,7 @@ namespace CubeR
 		template<VertexLayout::ElementType DestLayoutType, typename SrcType>
 		void SetAttribute(char* pAttribute, SrcType&& val) noexcept
 		{
-			using Dest = typename VertexLayout::Map<DestLayoutType>::SysType;
-			if constexpr (std::is_assignable<Dest, SrcType>::value)
-			{
-				*reinterpret_cast<Dest*>(pAttribute) = val;
-			}
-			else
-			{
-				assert("Parameter attribute type mismatch" && false);
-			}
+			WriteAttribute<DestLayoutType>(pAttribute, std::forward<SrcType>(val));
 		}
 	private:
 		char* pData = nullptr;
@@ -326,6 +579,15 @@ namespace CubeR
 		{
 			Resize(size);
 		}
+		// ,    
+		template<class V, class = typename V::Layout>
+		explicit VertexBuffer(const std::vector<V>& vertices)
+			:
+			buffer(reinterpret_cast<const char*>(vertices.data()), reinterpret_cast<const char*>(vertices.data() + vertices.size())),
+			layout(V::Layout::GetLayout())
+		{
+			static_assert(sizeof(V) == V::Layout::Size(), "Static vertex must have no padding");
+		}
 		void Resize(size_t newSize) 
 		{
 			const auto size = Size(); 
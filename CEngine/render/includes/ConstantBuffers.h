@@ -2,6 +2,8 @@
 
 #pragma once
 #include "Bindable.h"
+#include "BindableCodex.h"
+#include <typeinfo>
 
 	template<typename C>
 	class ConstantBuffer : public Bindable
@@ -10,14 +12,12 @@
 		void Update(Graphics& gfx, const C& consts, UINT num = 1u)
 		{
 
-			D3D11_MAPPED_SUBRESOURCE msr;
-			GetContext(gfx)->Map(
-				pConstantBuffer.Get(), 0u,
-				D3D11_MAP_WRITE_DISCARD, 0u,
-				&msr
-			);
-			memcpy(msr.pData, &consts, sizeof(consts) * num);
-			GetContext(gfx)->Unmap(pConstantBuffer.Get(), 0u);
+			auto& backend = GetBackend(gfx);
+			if (const auto pData = backend.Map(pConstantBuffer.Get(), D3D11_MAP_WRITE_DISCARD, 0u, sizeof(consts) * num))
+			{
+				memcpy(pData, &consts, sizeof(consts) * num);
+				backend.Unmap(pConstantBuffer.Get());
+			}
 		}
 		ConstantBuffer(Graphics& gfx, const C& consts, UINT slot = 0u) : slot(slot)
 		{
@@ -34,6 +34,12 @@
 			csd.pSysMem = &consts;
 			GetDevice(gfx)->CreateBuffer(&cbd, &csd, &pConstantBuffer);
 		}
+		//      BindableCodex,       :
+		//    
+		ConstantBuffer(Graphics& gfx, const C& consts, UINT slot, std::string tag) : ConstantBuffer(gfx, consts, slot)
+		{
+			this->tag = std::move(tag);
+		}
 		ConstantBuffer(Graphics& gfx, UINT slot = 0u, UINT num = 1u) : slot(slot)
 		{
 
@@ -49,6 +55,7 @@
 	protected:
 		Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
 		UINT slot;
+		std::string tag;
 	};
 
 	template<typename C>
@@ -56,12 +63,12 @@
 	{
 		using ConstantBuffer<C>::pConstantBuffer;
 		using ConstantBuffer<C>::slot;
-		using Bindable::GetContext;
+		using Bindable::GetState;
 	public:
 		using ConstantBuffer<C>::ConstantBuffer;
 		void Bind(Graphics& gfx) noexcept override
 		{
-			GetContext(gfx)->VSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+			GetState(gfx).SetVSConstantBuffer(slot, pConstantBuffer.Get());
 		}
 	};
 
@@ -70,11 +77,26 @@
 	{
 		using ConstantBuffer<C>::pConstantBuffer;
 		using ConstantBuffer<C>::slot;
-		using Bindable::GetContext;
+		using Bindable::GetState;
 	public:
 		using ConstantBuffer<C>::ConstantBuffer;
 		void Bind(Graphics& gfx)  noexcept override
 		{
-			GetContext(gfx)->PSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+			GetState(gfx).SetPSConstantBuffer(slot, pConstantBuffer.Get());
+		}
+		static std::shared_ptr<PixelConstantBuffer> Resolve(Graphics& gfx, const C& consts, UINT slot, const std::string& tag)
+		{
+			return BindableCodex::ResolveWeak<PixelConstantBuffer>(gfx, consts, slot, tag);
+		}
+		static std::string GenerateUID(const C&, UINT slot, const std::string& tag)
+		{
+			using namespace std::string_literals;
+			return typeid(PixelConstantBuffer).name() + "#"s + std::to_string(slot) + "#"s + tag;
+		}
+		std::string GetUID() const noexcept override
+		{
+			using namespace std::string_literals;
+			const auto& tag = ConstantBuffer<C>::tag;
+			return tag.empty() ? std::string{} : typeid(PixelConstantBuffer).name() + "#"s + std::to_string(slot) + "#"s + tag;
 		}
 	};
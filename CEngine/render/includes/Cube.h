@@ -1,8 +1,7 @@
-//        
+//        .
+//Layout - CubeR::StaticVertexLayout,      
 
 #pragma once
-#include <optional>
-#include "IndexedTriangleList.h"
 #include "IndexedTriangleList.h"
 #include <DirectXMath.h>
 #include "CVertex.h"
@@ -12,95 +11,83 @@
 class CCube
 {
 public:
-	static IndexedTriangleList MakeIndependent(CubeR::VertexLayout layout)
+	template<class Layout = CubeR::StaticVertexLayout<CubeR::VertexLayout::Position3D>>
+	static IndexedTriangleList MakeIndependent()
 	{
-		using Type = CubeR::VertexLayout::ElementType;
-
-		constexpr float side = 1.0f / 2.0f;
-
-		CubeR::VertexBuffer vertices(std::move(layout), 24u);
-		vertices[0].Attr<Type::Position3D>() = { -side,-side,-side };
-		vertices[1].Attr<Type::Position3D>() = { side,-side,-side };
-		vertices[2].Attr<Type::Position3D>() = { -side,side,-side };
-		vertices[3].Attr<Type::Position3D>() = { side,side,-side };
-		vertices[4].Attr<Type::Position3D>() = { -side,-side,side };
-		vertices[5].Attr<Type::Position3D>() = { side,-side,side };
-		vertices[6].Attr<Type::Position3D>() = { -side,side,side };
-		vertices[7].Attr<Type::Position3D>() = { side,side,side };
-		vertices[8].Attr<Type::Position3D>() = { -side,-side,-side };
-		vertices[9].Attr<Type::Position3D>() = { -side,side,-side };
-		vertices[10].Attr<Type::Position3D>() = { -side,-side,side };
-		vertices[11].Attr<Type::Position3D>() = { -side,side,side };
-		vertices[12].Attr<Type::Position3D>() = { side,-side,-side };
-		vertices[13].Attr<Type::Position3D>() = { side,side,-side };
-		vertices[14].Attr<Type::Position3D>() = { side,-side,side };
-		vertices[15].Attr<Type::Position3D>() = { side,side,side };
-		vertices[16].Attr<Type::Position3D>() = { -side,-side,-side };
-		vertices[17].Attr<Type::Position3D>() = { side,-side,-side };
-		vertices[18].Attr<Type::Position3D>() = { -side,-side,side };
-		vertices[19].Attr<Type::Position3D>() = { side,-side,side };
-		vertices[20].Attr<Type::Position3D>() = { -side,side,-side };
-		vertices[21].Attr<Type::Position3D>() = { side,side,-side };
-		vertices[22].Attr<Type::Position3D>() = { -side,side,side };
-		vertices[23].Attr<Type::Position3D>() = { side,side,side };
-
-		return{
-			std::move(vertices),{
-				0,2, 1,    2,3,1,
-				4,5, 7,    4,7,6,
-				8,10, 9,  10,11,9,
-				12,13,15, 12,15,14,
-				16,17,18, 18,17,19,
-				20,23,21, 20,22,23
-			}
-		};
+		return { CubeR::VertexBuffer(MakeIndependentVertices<Layout>()), MakeIndependentIndices() };
 	}
+	//        ,    Layout
+	template<class Layout = CubeR::StaticVertexLayout<CubeR::VertexLayout::Position3D, CubeR::VertexLayout::Normal, CubeR::VertexLayout::Texture2D>>
 	static IndexedTriangleList MakeIndependentTextured()
 	{
-		using namespace CubeR;
+		using namespace DirectX;
 		using Type = CubeR::VertexLayout::ElementType;
+		constexpr Type texture = Layout::template Has<Type::Texture2DHalf>() ? Type::Texture2DHalf : Type::Texture2D;
+		constexpr Type normal = Layout::template Has<Type::NormalOct>() ? Type::NormalOct : Type::Normal;
+		constexpr std::array<XMFLOAT2, 4> texCoords = { {
+			{ 0.0f,0.0f },{ 1.0f,0.0f },{ 0.0f,1.0f },{ 1.0f,1.0f }
+		} };
 
-		auto itl = MakeIndependent(std::move(VertexLayout{}
-			.Append(Type::Position3D)
-			.Append(Type::Normal)
-			.Append(Type::Texture2D)
-		));
-
-		itl.vertices[0].Attr<Type::Texture2D>() = { 0.0f,0.0f };
-		itl.vertices[1].Attr<Type::Texture2D>() = { 1.0f,0.0f };
-		itl.vertices[2].Attr<Type::Texture2D>() = { 0.0f,1.0f };
-		itl.vertices[3].Attr<Type::Texture2D>() = { 1.0f,1.0f };
-		itl.vertices[4].Attr<Type::Texture2D>() = { 0.0f,0.0f };
-		itl.vertices[5].Attr<Type::Texture2D>() = { 1.0f,0.0f };
-		itl.vertices[6].Attr<Type::Texture2D>() = { 0.0f,1.0f };
-		itl.vertices[7].Attr<Type::Texture2D>() = { 1.0f,1.0f };
-		itl.vertices[8].Attr<Type::Texture2D>() = { 0.0f,0.0f };
-		itl.vertices[9].Attr<Type::Texture2D>() = { 1.0f,0.0f };
-		itl.vertices[10].Attr<Type::Texture2D>() = { 0.0f,1.0f };
-		itl.vertices[11].Attr<Type::Texture2D>() = { 1.0f,1.0f };
-		itl.vertices[12].Attr<Type::Texture2D>() = { 0.0f,0.0f };
-		itl.vertices[13].Attr<Type::Texture2D>() = { 1.0f,0.0f };
-		itl.vertices[14].Attr<Type::Texture2D>() = { 0.0f,1.0f };
-		itl.vertices[15].Attr<Type::Texture2D>() = { 1.0f,1.0f };
-		itl.vertices[16].Attr<Type::Texture2D>() = { 0.0f,0.0f };
-		itl.vertices[17].Attr<Type::Texture2D>() = { 1.0f,0.0f };
-		itl.vertices[18].Attr<Type::Texture2D>() = { 0.0f,1.0f };
-		itl.vertices[19].Attr<Type::Texture2D>() = { 1.0f,1.0f };
-		itl.vertices[20].Attr<Type::Texture2D>() = { 0.0f,0.0f };
-		itl.vertices[21].Attr<Type::Texture2D>() = { 1.0f,0.0f };
-		itl.vertices[22].Attr<Type::Texture2D>() = { 0.0f,1.0f };
-		itl.vertices[23].Attr<Type::Texture2D>() = { 1.0f,1.0f };
-
-		return itl;
+		auto vertices = MakeIndependentVertices<Layout>();
+		auto indices = MakeIndependentIndices();
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			vertices[i].template Set<texture>(texCoords[i % texCoords.size()]);
+		}
+		const auto positions = GetIndependentPositions();
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			const auto p0 = XMLoadFloat3(&positions[indices[i]]);
+			const auto p1 = XMLoadFloat3(&positions[indices[i + 1]]);
+			const auto p2 = XMLoadFloat3(&positions[indices[i + 2]]);
+			XMFLOAT3 n;
+			XMStoreFloat3(&n, XMVector3Normalize(XMVector3Cross((p1 - p0), (p2 - p0))));
+			for (size_t j = 0; j < 3; j++)
+			{
+				vertices[indices[i + j]].template Set<normal>(n);
+			}
+		}
+		return { CubeR::VertexBuffer(vertices), std::move(indices) };
 	}
 
-	static IndexedTriangleList Make(std::optional<CubeR::VertexLayout> layout = std::nullopt)
+	template<class Layout = CubeR::StaticVertexLayout<CubeR::VertexLayout::Position3D>>
+	static IndexedTriangleList Make()
 	{
-		using Element = CubeR::VertexLayout::ElementType;
-		if (!layout)
+		return MakeIndependent<Layout>();
+	}
+private:
+	static constexpr std::array<DirectX::XMFLOAT3, 24> GetIndependentPositions()
+	{
+		constexpr float side = 1.0f / 2.0f;
+		return { {
+			{ -side,-side,-side },{ side,-side,-side },{ -side,side,-side },{ side,side,-side },
+			{ -side,-side,side },{ side,-side,side },{ -side,side,side },{ side,side,side },
+			{ -side,-side,-side },{ -side,side,-side },{ -side,-side,side },{ -side,side,side },
+			{ side,-side,-side },{ side,side,-side },{ side,-side,side },{ side,side,side },
+			{ -side,-side,-side },{ side,-side,-side },{ -side,-side,side },{ side,-side,side },
+			{ -side,side,-side },{ side,side,-side },{ -side,side,side },{ side,side,side }
+		} };
+	}
+	template<class Layout>
+	static std::vector<typename Layout::Vertex> MakeIndependentVertices()
+	{
+		const auto positions = GetIndependentPositions();
+		std::vector<typename Layout::Vertex> vertices(positions.size());
+		for (size_t i = 0; i < positions.size(); i++)
 		{
-			layout = CubeR::VertexLayout{}.Append(Element::Position3D);
+			vertices[i].template Attr<CubeR::VertexLayout::Position3D>() = positions[i];
 		}
-		return MakeIndependent(std::move(*layout));
+		return vertices;
+	}
+	static std::vector<unsigned short> MakeIndependentIndices()
+	{
+		return {
+			0,2, 1,    2,3,1,
+			4,5, 7,    4,7,6,
+			8,10, 9,  10,11,9,
+			12,13,15, 12,15,14,
+			16,17,18, 18,17,19,
+			20,23,21, 20,22,23
+		};
 	}
 };
\ No newline at end of file
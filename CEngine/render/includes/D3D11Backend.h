@@ -0,0 +1,41 @@
+//,     DirectX 11
+
+#pragma once
+#include "RenderBackend.h"
+#include <d3d11_1.h>
+#include <wrl.h>
+
+
+class D3D11Backend : public RenderBackend
+{
+public:
+	D3D11Backend(ID3D11DeviceContext* pContext) noexcept;
+
+	void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept override;
+	void SetInputLayout(ID3D11InputLayout* pLayout) noexcept override;
+	void SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept override;
+	void SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept override;
+	void SetVertexShader(ID3D11VertexShader* pShader) noexcept override;
+	void SetPixelShader(ID3D11PixelShader* pShader) noexcept override;
+	void SetVSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept override;
+	void SetVSConstantBufferRange(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept override;
+	void SetPSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept override;
+	void SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept override;
+	void SetPSSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept override;
+	void SetBlendState(ID3D11BlendState* pState) noexcept override;
+	void SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept override;
+	void SetRasterizerState(ID3D11RasterizerState* pState) noexcept override;
+	bool SupportsConstantBufferOffsets() const noexcept override;
+
+	void* Map(ID3D11Buffer* pBuffer, D3D11_MAP type, size_t offset, size_t size) noexcept override;
+	void Unmap(ID3D11Buffer* pBuffer) noexcept override;
+	void UpdateSubresource(ID3D11Resource* pResource, const void* pData, UINT rowPitch, size_t size) noexcept override;
+	void GenerateMips(ID3D11ShaderResourceView* pView) noexcept override;
+
+	void DrawIndexed(UINT count, UINT startIndex, INT baseVertex) noexcept override;
+	void DrawIndexedInstanced(UINT count, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) noexcept override;
+private:
+	ID3D11DeviceContext* pContext;
+	// D3D11.1     ,       
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext1> pContext1;
+};
\ No newline at end of file
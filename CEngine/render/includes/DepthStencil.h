@@ -15,6 +15,9 @@
 		};
 		DepthStencil(Graphics& gfx, Mode mode);
 		void Bind(Graphics& gfx)  noexcept override;
+		static std::shared_ptr<DepthStencil> Resolve(Graphics& gfx, Mode mode);
+		static std::string GenerateUID(Mode mode);
+		std::string GetUID() const noexcept override;
 	protected:
 		wrl::ComPtr <ID3D11DepthStencilState> pDss;
 	private:
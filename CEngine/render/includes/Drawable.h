@@ -9,7 +9,7 @@
 
 
 class Material;
-struct aiMesh;
+struct MeshAsset;
 
 
 class IndexBuffer;
@@ -21,17 +21,29 @@ class Drawable
 {
 public:
 	Drawable() = default;
-	Drawable(Graphics& gfx, const Material& mat, const aiMesh& mesh) noexcept;
+	//meshIndex -     ,        
+	Drawable(Graphics& gfx, const Material& mat, const MeshAsset& mesh, size_t meshIndex) noexcept;
 	Drawable(const Drawable&) = delete;
 	void AddTechnique(Technique tech_in) noexcept;
 	virtual DirectX::XMMATRIX GetTransformXM() const noexcept = 0;
 	void Submit(class FrameCommander& frame) const noexcept;
-	void Bind(Graphics& gfx) const noexcept;
-	UINT GetIndexCount() const noexcept;
+	//     .      FrameCommander
+	//lod -  , 0 -  , pLights -    (nullptr -  )
+	void Submit(class FrameCommander& frame, DirectX::FXMMATRIX transform, size_t lod = 0u,
+		const struct ObjectLightList* pLights = nullptr) const noexcept;
+	void Bind(Graphics& gfx, size_t lod = 0u) const noexcept;
+	UINT GetIndexCount(size_t lod = 0u) const noexcept;
+	//      
+	size_t GetLodCount() const noexcept;
+	//       -
+	bool IsSameGeometry(const Drawable& other) const noexcept;
+	uint32_t GetGeometryId(size_t lod = 0u) const noexcept;
 	virtual ~Drawable();
 protected:
-	std::unique_ptr<IndexBuffer> pIndices; 
-	std::unique_ptr<VertexBuffer> pVertices;
-	std::unique_ptr<Topology> pTopology;
+	std::shared_ptr<IndexBuffer> pIndices; 
+	//     1, 2, ...     
+	std::vector<std::shared_ptr<IndexBuffer>> lodIndices;
+	std::shared_ptr<VertexBuffer> pVertices;
+	std::shared_ptr<Topology> pTopology;
 	std::vector<Technique> techniques;
 }; 
\ No newline at end of file
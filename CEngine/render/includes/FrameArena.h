@@ -0,0 +1,146 @@
+//   ,    ( ,  ).
+//       ,   
+// ,     frameCount  NextFrame
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+class FrameArena
+{
+public:
+	FrameArena(size_t capacity, size_t frameCount = 3u);
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+	//   ,    ,   
+	//  ,       
+	void* Allocate(size_t size, size_t alignment) noexcept;
+	template<typename T>
+	T* Allocate(size_t count = 1u) noexcept
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "Frame arena never runs destructors");
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+	//      
+	void NextFrame() noexcept;
+	//,    
+	size_t GetUsed() const noexcept;
+	//,    
+	size_t GetLastFrameUsage() const noexcept;
+	// ,    
+	size_t GetPeak() const noexcept;
+	size_t GetCapacity() const noexcept;
+private:
+	struct Buffer
+	{
+		std::unique_ptr<std::byte[]> pData;
+		size_t capacity = 0u;
+		size_t offset = 0u;
+		size_t overflowBytes = 0u;
+		std::vector<std::unique_ptr<std::byte[]>> overflow;
+	};
+	Buffer& Current() noexcept;
+	const Buffer& Current() const noexcept;
+private:
+	std::vector<Buffer> buffers;
+	size_t current = 0u;
+	size_t lastFrameUsage = 0u;
+	size_t peak = 0u;
+};
+
+
+//  ,    FrameArena.
+//        ,      
+template<typename T>
+class FrameVector
+{
+	static_assert(std::is_trivially_copyable<T>::value, "FrameVector elements are moved with memcpy");
+public:
+	FrameVector(FrameArena& arena) noexcept
+		:
+		pArena(&arena)
+	{}
+	void push_back(const T& value) noexcept
+	{
+		if (count == capacity)
+		{
+			Grow(capacity == 0u ? std::max<size_t>(capacityHint, 16u) : capacity * 2u);
+		}
+		std::memcpy(static_cast<void*>(pData + count), &value, sizeof(T));
+		++count;
+	}
+	// .      
+	void clear() noexcept
+	{
+		capacityHint = std::max(capacityHint, count);
+		pData = nullptr;
+		count = 0u;
+		capacity = 0u;
+	}
+	T* data() noexcept
+	{
+		return pData;
+	}
+	const T* data() const noexcept
+	{
+		return pData;
+	}
+	size_t size() const noexcept
+	{
+		return count;
+	}
+	bool empty() const noexcept
+	{
+		return count == 0u;
+	}
+	T& operator[](size_t i) noexcept
+	{
+		return pData[i];
+	}
+	const T& operator[](size_t i) const noexcept
+	{
+		return pData[i];
+	}
+	T* begin() noexcept
+	{
+		return pData;
+	}
+	T* end() noexcept
+	{
+		return pData + count;
+	}
+	const T* begin() const noexcept
+	{
+		return pData;
+	}
+	const T* end() const noexcept
+	{
+		return pData + count;
+	}
+	FrameArena& GetArena() const noexcept
+	{
+		return *pArena;
+	}
+private:
+	void Grow(size_t newCapacity) noexcept
+	{
+		const auto pNew = static_cast<T*>(pArena->Allocate(sizeof(T) * newCapacity, alignof(T)));
+		if (count != 0u)
+		{
+			std::memcpy(static_cast<void*>(pNew), pData, sizeof(T) * count);
+		}
+		pData = pNew;
+		capacity = newCapacity;
+	}
+private:
+	FrameArena* pArena;
+	T* pData = nullptr;
+	size_t count = 0u;
+	size_t capacity = 0u;
+	size_t capacityHint = 0u;
+};
\ No newline at end of file
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <limits>
 #include "BindableBase.h"
 #include "Graphics.h"
 #include "Job.h"
 #include "Pass.h"
+#include "FrameArena.h"
+#include "InstanceBuffer.h"
+#include "Bounds.h"
+#include "OcclusionCuller.h"
+#include "ObjectLights.h"
 
 
 
@@ -14,6 +21,29 @@ class FrameCommander
 {
 
 public:
+	//  ,     
+	struct PassConfig
+	{
+		DepthStencil::Mode depth = DepthStencil::Mode::Off;
+		bool twoSided = false;
+		bool blending = false;
+		bool nullPixelShader = false;
+	};
+
+	FrameCommander(Graphics& gfx)
+		:
+		arena(256u * 1024u),
+		instances(gfx),
+		passes{ Pass{ arena, instances }, Pass{ arena, instances }, Pass{ arena, instances }, Pass{ arena, instances } },
+		outlineCbuf(gfx, outlineColor, 1u)
+	{
+		configs[0] = { DepthStencil::Mode::skybox, true };
+		configs[1] = { DepthStencil::Mode::Off };
+		configs[2] = { DepthStencil::Mode::Write, false, false, true };
+		configs[3] = { DepthStencil::Mode::Mask };
+		dirty.fill(true);
+		BuildStates(gfx);
+	}
 
 	void Accept(Job job, size_t target) noexcept
 	{
@@ -21,39 +51,358 @@ public:
 		passes[target].Accept(job);
 	}
 
-	void Execute(Graphics& gfx) const noexcept
+	void Execute(Graphics& gfx) noexcept
+	{
+		BuildStates(gfx);
+		instances.BeginFrame(gfx);
+		PackTransforms(gfx);
+
+		for (size_t i = 0; i < passes.size(); ++i)
+		{
+			states[i].Bind(gfx);
+			if (i == 3)
+			{
+				outlineCbuf.Bind(gfx);
+			}
+			passes[i].Execute(gfx);
+		}
+	}
+
+	void Reset() noexcept
 	{
+		for (auto& p : passes)
+		{
+			p.Reset();
+		}
+		arena.NextFrame();
+		cullStats = {};
+		triangleStats = {};
+	}
 
-		std::make_shared<DepthStencil>(gfx, DepthStencil::Mode::skybox)->Bind(gfx);
-		passes[0].Execute(gfx);
+	//   .    
+	void SetFrustum(const Frustum& frustum_in) noexcept
+	{
+		frustum = frustum_in;
+	}
 
-		std::make_shared<DepthStencil>(gfx, DepthStencil::Mode::Off)->Bind(gfx);
-		passes[1].Execute(gfx);
+	//nullptr,   
+	const Frustum* GetFrustum() const noexcept
+	{
+		return culling ? &frustum : nullptr;
+	}
 
-		std::make_shared<DepthStencil>(gfx, DepthStencil::Mode::Write)->Bind(gfx);
-		std::make_shared<NullPixelShader>(gfx)->Bind(gfx);
-		passes[2].Execute(gfx);
+	void EnableCulling(bool enable) noexcept
+	{
+		culling = enable;
+	}
 
+	bool IsCullingEnabled() const noexcept
+	{
+		return culling;
+	}
 
-		std::make_shared<DepthStencil>(gfx, DepthStencil::Mode::Mask)->Bind(gfx);
+	//     .    
+	void SetView(DirectX::FXMMATRIX view_in, DirectX::CXMMATRIX proj) noexcept
+	{
+		DirectX::XMStoreFloat4x4(&view, view_in);
+		projScale = DirectX::XMVectorGetY(proj.r[1]);
+	}
 
-		struct SolidColorBuffer
+	//        .
+	//    ,  
+	float GetScreenSize(const BoundingVolume& bounds, DirectX::FXMMATRIX transform) const noexcept
+	{
+		const auto world = bounds.Transform(transform);
+		const float viewZ = DirectX::XMVectorGetZ(DirectX::XMVector3Transform(
+			DirectX::XMLoadFloat3(&world.center), DirectX::XMLoadFloat4x4(&view)));
+		if (viewZ <= world.radius)
 		{
-			DirectX::XMFLOAT4 color = { 1.0f,0.4f,0.4f,1.0f };
-		} scb;
-		std::make_shared<PixelConstantBuffer<SolidColorBuffer>>(gfx, scb, 1u)->Bind(gfx);
+			return std::numeric_limits<float>::infinity();
+		}
+		return world.radius * projScale / viewZ;
+	}
 
-		passes[3].Execute(gfx);
+	void EnableLod(bool enable) noexcept
+	{
+		lod = enable;
 	}
 
-	void Reset() noexcept
+	bool IsLodEnabled() const noexcept
+	{
+		return lod;
+	}
+
+	//  :        
+	struct TriangleStats
+	{
+		size_t full = 0u;
+		size_t submitted = 0u;
+	};
+
+	void CountTriangles(size_t full, size_t submitted) noexcept
+	{
+		triangleStats.full += full;
+		triangleStats.submitted += submitted;
+	}
+
+	const TriangleStats& GetTriangleStats() const noexcept
+	{
+		return triangleStats;
+	}
+
+	//   . nullptr,   .
+	//      ,      
+	OcclusionCuller* GetOcclusion() noexcept
+	{
+		return occlusionEnabled ? &occlusion : nullptr;
+	}
+
+	void EnableOcclusion(bool enable) noexcept
+	{
+		occlusionEnabled = enable;
+	}
+
+	bool IsOcclusionEnabled() const noexcept
+	{
+		return occlusionEnabled;
+	}
+
+	const OcclusionCuller::Stats& GetOcclusionStats() const noexcept
+	{
+		return occlusion.GetStats();
+	}
+
+	//     .    
+	void SetObjectLights(ObjectLights* pLights) noexcept
+	{
+		pObjectLights = pLights;
+	}
+
+	//        .
+	//nullptr,   :    
+	const ObjectLightList* AssignLights(const BoundingVolume& bounds, DirectX::FXMMATRIX transform) noexcept
+	{
+		if (!lightLists || pObjectLights == nullptr)
+		{
+			return nullptr;
+		}
+		const auto pList = arena.Allocate<ObjectLightList>();
+		pObjectLights->Select(bounds.Transform(transform), *pList);
+		return pList;
+	}
+
+	void EnableLightLists(bool enable) noexcept
+	{
+		lightLists = enable;
+	}
+
+	bool IsLightListsEnabled() const noexcept
+	{
+		return lightLists;
+	}
+
+	// ,        
+	struct CullStats
+	{
+		size_t visible = 0u;
+		size_t culled = 0u;
+	};
+
+	void CountVisible(size_t count) noexcept
+	{
+		cullStats.visible += count;
+	}
+
+	void CountCulled(size_t count) noexcept
+	{
+		cullStats.culled += count;
+	}
+
+	const CullStats& GetCullStats() const noexcept
+	{
+		return cullStats;
+	}
+
+	//   .      Reset
+	template<typename T>
+	T* Allocate(size_t count = 1u) noexcept
+	{
+		return arena.Allocate<T>(count);
+	}
+
+	const DirectX::XMFLOAT4X4* AllocateTransform(DirectX::FXMMATRIX transform) noexcept
+	{
+		const auto pTransform = arena.Allocate<DirectX::XMFLOAT4X4>();
+		DirectX::XMStoreFloat4x4(pTransform, transform);
+		return pTransform;
+	}
+
+	const FrameArena& GetArena() const noexcept
+	{
+		return arena;
+	}
+
+	//  .       
+	void SetPassConfig(size_t pass, const PassConfig& config) noexcept
+	{
+		configs[pass] = config;
+		dirty[pass] = true;
+	}
+
+	const PassConfig& GetPassConfig(size_t pass) const noexcept
+	{
+		return configs[pass];
+	}
+
+	void SetOutlineColor(const DirectX::XMFLOAT4& color) noexcept
 	{
+		outlineColor.color = color;
+		outlineDirty = true;
+	}
+
+	void EnableSorting(bool enable) noexcept
+	{
+		sorting = enable;
 		for (auto& p : passes)
 		{
-			p.Reset();
+			p.EnableSorting(enable);
+		}
+	}
+
+	bool IsSortingEnabled() const noexcept
+	{
+		return sorting;
+	}
+
+	//         DrawIndexedInstanced.
+	//    ,     
+	void EnableInstancing(bool enable) noexcept
+	{
+		instancing = enable;
+		for (auto& p : passes)
+		{
+			p.EnableInstancing(enable);
+		}
+	}
+
+	bool IsInstancingEnabled() const noexcept
+	{
+		return instancing;
+	}
+
+	//       , 
+	float GetPackTime() const noexcept
+	{
+		return packTime;
+	}
+
+	float GetSortTime() const noexcept
+	{
+		float time = 0.0f;
+		for (const auto& p : passes)
+		{
+			time += p.GetSortTime();
+		}
+		return time;
+	}
+
+private:
+	struct PassState
+	{
+		std::shared_ptr<DepthStencil> pDepthStencil;
+		std::shared_ptr<Rasterizer> pRasterizer;
+		std::shared_ptr<Blender> pBlender;
+		std::shared_ptr<NullPixelShader> pNullPixelShader;
+		void Bind(Graphics& gfx) noexcept
+		{
+			pDepthStencil->Bind(gfx);
+			pRasterizer->Bind(gfx);
+			pBlender->Bind(gfx);
+			if (pNullPixelShader)
+			{
+				pNullPixelShader->Bind(gfx);
+			}
+		}
+	};
+
+	struct SolidColorBuffer
+	{
+		DirectX::XMFLOAT4 color = { 1.0f,0.4f,0.4f,1.0f };
+	};
+
+	//           TransformCbuf,
+	//         
+	void PackTransforms(Graphics& gfx) noexcept
+	{
+		const auto start = std::chrono::steady_clock::now();
+		size_t count = 0u;
+		for (const auto& p : passes)
+		{
+			count += p.GetJobCount();
+		}
+		const auto ppModels = arena.Allocate<const DirectX::XMFLOAT4X4*>(count);
+		size_t offset = 0u;
+		for (const auto& p : passes)
+		{
+			p.GatherTransforms(ppModels + offset);
+			offset += p.GetJobCount();
+		}
+		const auto first = TransformCbuf::WriteFrame(gfx, ppModels, UINT(count));
+		offset = 0u;
+		for (auto& p : passes)
+		{
+			p.AssignTransformSlots(first + uint32_t(offset));
+			offset += p.GetJobCount();
+		}
+		packTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//      
+	void BuildStates(Graphics& gfx)
+	{
+		for (size_t i = 0; i < passes.size(); ++i)
+		{
+			if (!dirty[i])
+			{
+				continue;
+			}
+			const auto& cfg = configs[i];
+			auto& state = states[i];
+			state.pDepthStencil = DepthStencil::Resolve(gfx, cfg.depth);
+			state.pRasterizer = Rasterizer::Resolve(gfx, cfg.twoSided);
+			state.pBlender = Blender::Resolve(gfx, cfg.blending);
+			state.pNullPixelShader = cfg.nullPixelShader ? NullPixelShader::Resolve(gfx) : nullptr;
+			dirty[i] = false;
+		}
+		if (outlineDirty)
+		{
+			outlineCbuf.Update(gfx, outlineColor);
+			outlineDirty = false;
 		}
 	}
 
 private:
+	bool sorting = true;
+	bool instancing = true;
+	bool culling = true;
+	bool occlusionEnabled = true;
+	bool lod = true;
+	bool lightLists = true;
+	ObjectLights* pObjectLights = nullptr;
+	DirectX::XMFLOAT4X4 view = {};
+	float projScale = 1.0f;
+	TriangleStats triangleStats;
+	Frustum frustum;
+	OcclusionCuller occlusion;
+	CullStats cullStats;
+	float packTime = 0.0f;
+	FrameArena arena;
+	InstanceBuffer instances;
 	std::array<Pass, 4> passes;
+	std::array<PassConfig, 4> configs;
+	std::array<PassState, 4> states;
+	std::array<bool, 4> dirty;
+	SolidColorBuffer outlineColor;
+	bool outlineDirty = false;
+	PixelConstantBuffer<SolidColorBuffer> outlineCbuf;
 };
\ No newline at end of file
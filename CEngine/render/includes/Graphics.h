@@ -12,13 +12,19 @@
 #include <random>
 #include "imgui_internal.h"
 #include <DirectXMath.h>
+#include "StateTracker.h"
+#include "Bounds.h"
+#include <vector>
 
 namespace wrl = Microsoft::WRL;
 
+struct ObjectLightList;
+class TextureView;
+
 class Graphics
 {
 	friend class Bindable;
-	friend class Texture;
+	friend class TextureManager;
 	friend class DDSTex;
 public:
 	//   
@@ -42,24 +48,41 @@ public:
 	};
 public:
 	Graphics(HWND hwnd, int width, int height);
+	//    GPU    :     (, RecordingBackend)
+	Graphics(std::unique_ptr<RenderBackend> pBackend, int width, int height);
 	Graphics(const Graphics&) = delete;
 	Graphics& operator=(const Graphics&) = delete;
 	~Graphics();
 	void EndFrame();
 	void ClearBuffer(float red, float green, float blue);
 	void DrawIndexed(UINT count);
+	void DrawIndexedInstanced(UINT count, UINT instanceCount, UINT startInstance);
 	void SetProjection(DirectX::FXMMATRIX proj);
 	void SetCamera(DirectX::FXMMATRIX cam) noexcept;
-	void SetTexture(ID3D11ShaderResourceView** tv, const wchar_t* file);
+	// ,     .     Bindable
+	void SetModelTransform(DirectX::FXMMATRIX transform) noexcept;
+	DirectX::XMMATRIX GetModelTransform() const noexcept;
+	//        (TransformRing)
+	void SetTransformSlot(UINT slot) noexcept;
+	UINT GetTransformSlot() const noexcept;
+	//  ,     . nullptr -   
+	void SetObjectLights(const ObjectLightList* pLights) noexcept;
+	const ObjectLightList* GetObjectLights() const noexcept;
+	//   TextureManager,   
+	std::shared_ptr<const TextureView> LoadTexture(const std::string& file);
 	DirectX::XMMATRIX GetCamera() const noexcept;
 	DirectX::XMMATRIX GetProjection() const;
 	void ClearScreen(float factor);
 	void DrawGrid(DirectX::XMFLOAT3 camPos) noexcept;
+	//  AABB       
+	void DrawBoxes(const std::vector<BoundingVolume>& boxes) noexcept;
 
 	ImGuiID ShowDocksape() noexcept;
 	void SetupRenderTarget() noexcept;
 	void CleanupRenderTarget() noexcept;
 	void CreateViewport(float x, float y, float topx, float topy) noexcept;
+	//     
+	const D3D11_VIEWPORT& GetViewport() const noexcept;
 	void EnableImgui() noexcept;
 	void DisableImgui() noexcept;
 	void Resize(UINT width, UINT height) noexcept;
@@ -71,15 +94,33 @@ public:
 
 	int getMonitorFrequency() const noexcept;
 
+	//        
+	const StateTracker::Stats& GetBindStats() const noexcept;
+	//  ,     Bindable
+	size_t GetDeviceObjectCount() const noexcept;
+	//     
+	size_t GetDrawCallCount() const noexcept;
+	RenderBackend& GetBackend() noexcept;
+	bool IsHeadless() const noexcept;
+
 	bool VSYNCenabled = true;
 private:
+	bool headless = false;
 	bool imguiEnabled = true;
 	DirectX::XMMATRIX projection;
 	DirectX::XMMATRIX camera;
+	DirectX::XMMATRIX model = DirectX::XMMatrixIdentity();
+	UINT transformSlot = 0u;
+	const ObjectLightList* pObjectLights = nullptr;
+	D3D11_VIEWPORT viewport = {};
 	ImGuiID dockspace_id;
 	wrl::ComPtr<ID3D11Device> pDevice = nullptr;
 	wrl::ComPtr<IDXGISwapChain> pSwap = nullptr;
 	wrl::ComPtr<ID3D11DeviceContext> pContext;
+	std::unique_ptr<RenderBackend> pBackend;
+	std::unique_ptr<StateTracker> pStateTracker;
+	size_t deviceObjectCount = 0u;
+	size_t drawCallCount = 0u;
 	wrl::ComPtr<ID3D11RenderTargetView> pTarget;
 	wrl::ComPtr<ID3D11DepthStencilView> pDSV;
 	wrl::ComPtr<ID3D11Texture2D> pDepthStencil;
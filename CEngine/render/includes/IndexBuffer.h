@@ -1,15 +1,74 @@
-//         DirectX (Bindable)
+//         DirectX (Bindable).
+//   : unsigned short    65536 , uint32_t   
 
 #pragma once
 #include "Bindable.h"
+#include "BindableCodex.h"
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
 
 	class IndexBuffer : public Bindable
 	{
 	public:
-		IndexBuffer(Graphics& gfx, const std::vector<unsigned short>& indices) noexcept;
+		template<typename T>
+		IndexBuffer(Graphics& gfx, const std::vector<T>& indices) noexcept
+			:
+			IndexBuffer(gfx, std::string{}, indices.data(), indices.size())
+		{}
+		template<typename T>
+		IndexBuffer(Graphics& gfx, std::string tag, const std::vector<T>& indices) noexcept
+			:
+			IndexBuffer(gfx, std::move(tag), indices.data(), indices.size())
+		{}
+		//    ,      
+		template<typename T>
+		IndexBuffer(Graphics& gfx, const T* pIndices, size_t count) noexcept
+			:
+			IndexBuffer(gfx, std::string{}, pIndices, count)
+		{}
+		template<typename T>
+		IndexBuffer(Graphics& gfx, std::string tag, const T* pIndices, size_t count) noexcept
+			:
+			IndexBuffer(gfx, std::move(tag), static_cast<const void*>(pIndices), count, sizeof(T), FormatOf<T>())
+		{}
 		void Bind(Graphics& gfx) noexcept override;
 		UINT GetCount() const;
+		DXGI_FORMAT GetFormat() const noexcept;
+		//   ,       
+		template<typename T>
+		static std::shared_ptr<IndexBuffer> Resolve(Graphics& gfx, const std::string& tag, const std::vector<T>& indices)
+		{
+			return BindableCodex::ResolveWeak<IndexBuffer>(gfx, tag, indices);
+		}
+		template<typename T>
+		static std::shared_ptr<IndexBuffer> Resolve(Graphics& gfx, const std::string& tag, const T* pIndices, size_t count)
+		{
+			return BindableCodex::ResolveWeak<IndexBuffer>(gfx, tag, pIndices, count);
+		}
+		template<typename T>
+		static std::string GenerateUID(const std::string& tag, const std::vector<T>&)
+		{
+			return GenerateUID(tag);
+		}
+		template<typename T>
+		static std::string GenerateUID(const std::string& tag, const T*, size_t)
+		{
+			return GenerateUID(tag);
+		}
+		static std::string GenerateUID(const std::string& tag);
+		std::string GetUID() const noexcept override;
+	private:
+		IndexBuffer(Graphics& gfx, std::string tag, const void* pIndices, size_t count, size_t indexSize, DXGI_FORMAT format) noexcept;
+		template<typename T>
+		static constexpr DXGI_FORMAT FormatOf() noexcept
+		{
+			static_assert(std::is_same<T, unsigned short>::value || std::is_same<T, uint32_t>::value, "Index type must be unsigned short or uint32_t");
+			return sizeof(T) == 2u ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+		}
 	protected:
+		std::string tag;
 		UINT count;
+		DXGI_FORMAT format;
 		Microsoft::WRL::ComPtr<ID3D11Buffer> pIndexBuffer;
-	};
+	};
\ No newline at end of file
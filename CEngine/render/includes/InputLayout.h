@@ -4,16 +4,26 @@
 #include "Bindable.h"
 #include "CVertex.h"
 
+class VertexShader;
+
 
 	class InputLayout : public Bindable
 	{
 	public:
+		//instanced -        (InstanceTransform 0-3)
 		InputLayout(Graphics& gfx,
 			CubeR::VertexLayout layout,
-			ID3DBlob* pVertexShaderBytecode);
+			const VertexShader& vs,
+			bool instanced = false);
 		void Bind(Graphics& gfx)  noexcept override;
 		const CubeR::VertexLayout GetLayout() const noexcept;
+		static std::shared_ptr<InputLayout> Resolve(Graphics& gfx,
+			const CubeR::VertexLayout& layout, const VertexShader& vs, bool instanced = false);
+		static std::string GenerateUID(const CubeR::VertexLayout& layout, const VertexShader& vs, bool instanced = false);
+		std::string GetUID() const noexcept override;
 	protected:
 		CubeR::VertexLayout layout;
+		std::string vertexShaderUID;
+		bool instanced;
 		Microsoft::WRL::ComPtr<ID3D11InputLayout> pInputLayout;
 	};
@@ -0,0 +1,52 @@
+//    - (Bindable).
+//       GPU (NO_OVERWRITE),    
+
+#pragma once
+#include "Bindable.h"
+#include "ConstantBuffers.h"
+#include <DirectXMath.h>
+
+
+	class InstanceBuffer : public Bindable
+	{
+	public:
+		InstanceBuffer(Graphics& gfx, UINT capacity = 4096u);
+		//    ,    - 
+		void BeginFrame(Graphics& gfx) noexcept;
+		void Bind(Graphics& gfx) noexcept override;
+		// count ,   getTransform(i),     
+		// DrawIndexedInstanced. count    GetCapacity()
+		template<typename F>
+		UINT Upload(Graphics& gfx, UINT count, F&& getTransform) noexcept
+		{
+			const auto mapType = Reserve(count);
+			auto& backend = GetBackend(gfx);
+			const auto pData = backend.Map(pInstanceBuffer.Get(), mapType,
+				sizeof(DirectX::XMFLOAT4X4) * cursor, sizeof(DirectX::XMFLOAT4X4) * count);
+			if (pData)
+			{
+				auto pDst = static_cast<DirectX::XMFLOAT4X4*>(pData) + cursor;
+				for (UINT i = 0u; i < count; ++i)
+				{
+					pDst[i] = getTransform(i);
+				}
+				backend.Unmap(pInstanceBuffer.Get());
+			}
+			const auto first = cursor;
+			cursor += count;
+			return first;
+		}
+		UINT GetCapacity() const noexcept;
+	private:
+		D3D11_MAP Reserve(UINT count) noexcept;
+	private:
+		struct ViewProjection
+		{
+			DirectX::XMMATRIX view;
+			DirectX::XMMATRIX proj;
+		};
+		UINT capacity;
+		UINT cursor;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pInstanceBuffer;
+		VertexConstantBuffer<ViewProjection> viewProjCbuf;
+	};
\ No newline at end of file
@@ -1,12 +1,36 @@
 #pragma once
+#include <cstdint>
+#include <cstddef>
+#include <DirectXMath.h>
 
 
 class Job
 {
 public:
-	Job(const class Step* pStep, const class Drawable* pDrawable);
+	Job(const class Step* pStep, const class Drawable* pDrawable, const DirectX::XMFLOAT4X4* pTransform, size_t lod = 0u,
+		const struct ObjectLightList* pLights = nullptr);
 	void Execute(class Graphics& gfx) const noexcept;
+	//         .
+	//    , ,    (   ),
+	//   -      
+	void UpdateSortKey(DirectX::FXMMATRIX view) noexcept;
+	uint64_t GetSortKey() const noexcept;
+	const class Drawable& GetDrawable() const noexcept;
+	const class Step& GetStep() const noexcept;
+	const DirectX::XMFLOAT4X4& GetTransform() const noexcept;
+	// ,    
+	size_t GetLod() const noexcept;
+	//  ,   FrameArena. nullptr -   
+	const struct ObjectLightList* GetLights() const noexcept;
+	//     TransformRing,  FrameCommander   
+	void SetTransformSlot(uint32_t slot) noexcept;
 private:
 	const class Drawable* pDrawable;
 	const class Step* pStep;
+	//  ,   FrameArena   
+	const DirectX::XMFLOAT4X4* pTransform;
+	const struct ObjectLightList* pLights;
+	uint64_t sortKey = 0u;
+	uint32_t transformSlot = 0u;
+	uint32_t lod = 0u;
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+//      .
+//    GridX x GridY    GridZ   ,
+//     ,       .
+//         
+
+#pragma once
+#include <DirectXMath.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+class LightClusters
+{
+public:
+	static constexpr uint32_t GridX = 16u;
+	static constexpr uint32_t GridY = 9u;
+	static constexpr uint32_t GridZ = 24u;
+	static constexpr uint32_t ClusterCount = GridX * GridY * GridZ;
+	//     ,    uint2  
+	struct Range
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+	struct Stats
+	{
+		size_t lights = 0u;
+		size_t indices = 0u;
+		size_t maxPerCluster = 0u;
+	};
+public:
+	//x, y, z -      , radii -   .
+	//        proj (,   XMMatrixPerspectiveFovLH)
+	void Build(const float* x, const float* y, const float* z, const float* radii, size_t count, const DirectX::XMFLOAT4X4& proj);
+	const std::vector<Range>& GetRanges() const noexcept;
+	const std::vector<uint32_t>& GetIndices() const noexcept;
+	//   z  : floor(log(z) * zScale + zBias)
+	float GetZScale() const noexcept;
+	float GetZBias() const noexcept;
+	const Stats& GetStats() const noexcept;
+private:
+	uint32_t Slice(float z) const noexcept;
+private:
+	struct Bounds
+	{
+		uint32_t x0, x1, y0, y1, z0, z1;
+		uint32_t light;
+	};
+	float nearZ = 0.01f;
+	float farZ = 300.0f;
+	float zScale = 0.0f;
+	float zBias = 0.0f;
+	std::vector<Bounds> lightBounds;
+	std::vector<Range> ranges = std::vector<Range>(ClusterCount);
+	std::vector<uint32_t> indices;
+	Stats stats;
+};
\ No newline at end of file
@@ -0,0 +1,22 @@
+//       (Bindable).
+//   Graphics,      ,    
+
+#pragma once
+#include "ConstantBuffers.h"
+#include "ObjectLights.h"
+
+
+	class LightListCbuf : public Bindable
+	{
+	public:
+		LightListCbuf(Graphics& gfx, UINT slot = 3u);
+		void Bind(Graphics& gfx) noexcept override;
+		static std::shared_ptr<LightListCbuf> Resolve(Graphics& gfx);
+		static std::string GenerateUID();
+		std::string GetUID() const noexcept override;
+	private:
+		PixelConstantBuffer<ObjectLightList> cbuf;
+		//  :      
+		ObjectLightList uploaded;
+		bool valid = false;
+	};
\ No newline at end of file
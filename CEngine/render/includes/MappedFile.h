@@ -0,0 +1,31 @@
+//,      .
+//     ,    
+// CreateBuffer     
+
+#pragma once
+#include <windows.h>
+#include <filesystem>
+#include <cstddef>
+
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	~MappedFile();
+	//  .      ,  false
+	bool Open(const std::filesystem::path& path) noexcept;
+	void Close() noexcept;
+	bool IsOpen() const noexcept;
+	const char* GetData() const noexcept;
+	size_t GetSize() const noexcept;
+private:
+	HANDLE hFile = INVALID_HANDLE_VALUE;
+	HANDLE hMapping = nullptr;
+	const char* pData = nullptr;
+	size_t size = 0u;
+};
\ No newline at end of file
@@ -5,23 +5,29 @@
 #include <filesystem>
 #include "Technique.h"
 
-struct aiMaterial;
-struct aiMesh;
+class ModelAsset;
+struct MeshAsset;
 
 
 class Material
 {
 public:
-	Material(Graphics& gfx, const aiMaterial& material, const std::filesystem::path& path);
-	CubeR::VertexBuffer ExtractVertices(const aiMesh& mesh) const noexcept;
-	std::vector<unsigned short> ExtractIndices(const aiMesh& mesh) const noexcept;
-	std::unique_ptr<VertexBuffer> MakeVertexBindable(Graphics& gfx, const aiMesh& mesh) const;
-	std::unique_ptr<IndexBuffer> MakeIndexBindable(Graphics& gfx, const aiMesh& mesh) const;
+	//             (ModelAsset::GetKey)
+	//      .
+	//index -    asset.      asset,    
+	Material(Graphics& gfx, const ModelAsset& asset, const std::filesystem::path& path, size_t index);
+	//     ,      
+	std::shared_ptr<VertexBuffer> MakeVertexBindable(Graphics& gfx, const MeshAsset& mesh, size_t meshIndex) const;
+	std::shared_ptr<IndexBuffer> MakeIndexBindable(Graphics& gfx, const MeshAsset& mesh, size_t meshIndex) const;
+	//    ,    .
+	//    ,    ,  
+	std::vector<std::shared_ptr<IndexBuffer>> MakeLodIndexBindables(Graphics& gfx, const MeshAsset& mesh, size_t meshIndex) const;
 	std::vector<Technique> GetTechniques() const noexcept;
 private:
 	CubeR::VertexLayout vtxLayout;
 	std::vector<Technique> techniques;
-	std::string modelPath;
+	std::string assetKey;
+	std::string tag;
 	std::string name;
 	bool hasSpecMap = false;
 	bool hasNormalMap = false;
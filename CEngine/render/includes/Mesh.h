@@ -4,6 +4,10 @@
 #pragma once
 #include "Drawable.h"
 #include "BindableBase.h"
+#include "Bounds.h"
+#include "SceneBVH.h"
+#include "OcclusionCuller.h"
+#include "ModelAsset.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <optional>
@@ -16,11 +20,24 @@
 class Mesh : public Drawable
 {
 public:
-	Mesh(Graphics& gfx, const Material& mat, const aiMesh& mesh) noexcept;
+	Mesh(Graphics& gfx, const Material& mat, const MeshAsset& mesh, size_t meshIndex) noexcept;
+	//    :      Submit
 	DirectX::XMMATRIX GetTransformXM() const noexcept override;
 	void Submit(FrameCommander& frame, DirectX::FXMMATRIX accumulatedTranform) const noexcept;
+	//     ,   
+	const BoundingVolume& GetBounds() const noexcept;
+	//      
+	void MakeOccluder(const MeshAsset& mesh);
+	//nullptr,       
+	const Occluder* GetOccluder() const noexcept;
 private:
-	mutable DirectX::XMFLOAT4X4 transform;
+	//      .     
+	//  ,         
+	size_t SelectLod(float screenSize) const noexcept;
+private:
+	BoundingVolume bounds;
+	mutable size_t currentLod = 0u;
+	std::unique_ptr<Occluder> pOccluder;
 };
 
 
@@ -33,7 +50,15 @@ public:
 	Node(int id, const std::string& name,std::vector<Mesh*> meshPtrs, const DirectX::XMMATRIX& transform) ;
 	Node(const Node&) = delete;
 	Node& operator=(const Node&) = delete;
-	void Submit(FrameCommander& frame, DirectX::FXMMATRIX accumulatedTransform) const noexcept;
+	//,     ,    .
+	//inside -     ,    
+	void Submit(FrameCommander& frame, DirectX::FXMMATRIX accumulatedTransform, bool inside = false) const noexcept;
+	//  ,   .
+	// true,       
+	bool UpdateBounds() noexcept;
+	void RasterizeOccluders(OcclusionCuller& occlusion, DirectX::FXMMATRIX accumulatedTransform) const;
+	//       ,    distance.  distance 
+	bool Raycast(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, DirectX::FXMMATRIX accumulatedTransform, float& distance) const noexcept;
 	void SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept;
 	void SetAppliedScale(DirectX::FXMMATRIX scale) noexcept;
 	const DirectX::XMFLOAT4X4& GetAppliedTransform() const noexcept;
@@ -51,17 +76,40 @@ private:
 	DirectX::XMFLOAT4X4 baseTransform;
 	DirectX::XMFLOAT4X4 appliedTransform;
 	DirectX::XMFLOAT4X4 appliedScale;
-
+	//          (   )
+	BoundingVolume bounds;
+	size_t subtreeMeshCount = 0u;
+	bool boundsValid = false;
+	bool transformChanged = false;
 };
 
 
 //  ,     
 class Model
 {
+	friend class ModelLoader;
 public:
-	//        ,       
+	//        ,       .
+	//CPU-  (ModelAsset::Load)        WorkerPool,
+	//         .
+	//      ModelLoader
 	Model(Graphics& gfx, const std::string& fileName, int id=0, std::string modelName = "Unnamed Object");
-	void Submit(FrameCommander& frame) const noexcept;
+	Model(const Model&) = delete;
+	Model& operator=(const Model&) = delete;
+	//inside -         BVH 
+	void Submit(FrameCommander& frame, bool inside = false) const noexcept;
+	//   BVH .       
+	void Attach(SceneBVH& bvh);
+	//      .
+	//   ,  BVH   
+	void Update() noexcept;
+	//     
+	BoundingVolume GetWorldBounds() const noexcept;
+	//       
+	void RasterizeOccluders(OcclusionCuller& occlusion) const;
+	//        maxDistance. ,     ,
+	//   ,     (, )    
+	bool Raycast(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, float maxDistance, float& distance) const noexcept;
 	std::unique_ptr<Mesh> ParseMesh(Graphics& gfx, const aiMesh& mesh, const aiMaterial* const* pMaterials, const std::filesystem::path& filePath);
 	void ShowWindow(Graphics& gfx, Model* pSelectedModel) noexcept;
 	void SetRootTransfotm(DirectX::FXMMATRIX tf);
@@ -74,6 +122,10 @@ public:
 	std::string rootPath;
 	int id;
 private:
+	// ,  ModelLoader    
+	Model(const std::string& fileName, int id, std::string modelName);
+	//      :    
+	void Finish(const ModelAsset& asset);
 	CubeR::VertexLayout vtxLayout;
 	std::vector<Technique> techniques;
 	DirectX::XMMATRIX GetTransform() const noexcept;
@@ -81,11 +133,14 @@ private:
 	Node* GetSelectedNode() const noexcept;
 
 	// ParseNode     ,  
-	std::unique_ptr<Node> ParseNode(int& nextId, const aiNode& node);
+	std::unique_ptr<Node> ParseNode(int& nextId, const ModelAsset& asset, size_t nodeIndex);
 
 	std::unique_ptr<Node> pRoot;
 	std::vector<std::unique_ptr<Mesh>> meshPtrs;
-	Node* pSelectedNode;
+	Node* pSelectedNode = nullptr;
+	SceneBVH* pBVH = nullptr;
+	int bvhProxy = -1;
+	bool hasOccluders = false;
 	struct TransformParameters
 	{
 		float roll = 0.0f;
@@ -0,0 +1,44 @@
+//       .
+//      (Tipsify, Sander  . 2007),
+//     ,         .
+//          
+
+#pragma once
+#include <DirectXMath.h>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+class MeshOptimizer
+{
+public:
+	// FIFO- ,         
+	static constexpr size_t CacheSize = 16u;
+	struct Stats
+	{
+		//   :  0.5    3
+		float acmr = 0.0f;
+		//    : 1  
+		float atvr = 0.0f;
+	};
+	struct Report
+	{
+		Stats before;
+		Stats after;
+	};
+public:
+	// FIFO-  cacheSize   
+	static Stats Analyze(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = CacheSize);
+	//       Tipsify.
+	//pClusters   :    ,        
+	static std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+		std::vector<uint32_t>* pClusters = nullptr, size_t cacheSize = CacheSize);
+	//  ,      ACMR (    threshold ),
+	//       :     ,   
+	static std::vector<uint32_t> OptimizeOverdraw(const DirectX::XMFLOAT3* pPositions, size_t vertexCount,
+		const std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters, float threshold = 1.05f, size_t cacheSize = CacheSize);
+	//        .
+	//      ,        
+	static std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount);
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+//       (Garland-Heckbert)   LOD.
+//     :       ,
+//           
+
+#pragma once
+#include <DirectXMath.h>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+class MeshSimplifier
+{
+public:
+	//   ,     targetIndexCount ,   .
+	// ,      ,  .
+	//pError -        
+	static std::vector<uint32_t> Simplify(const DirectX::XMFLOAT3* pPositions, size_t vertexCount,
+		const std::vector<uint32_t>& indices, size_t targetIndexCount, float* pError = nullptr);
+};
\ No newline at end of file
@@ -0,0 +1,137 @@
+//    ,       GPU,     .cubemesh.
+//       Assimp:    
+//CubeR::VertexLayout ,     MeshOptimizer,
+//  ,     AssetCache     ,  Assimp.
+//   .cubemesh  ,       
+
+#pragma once
+#include "CVertex.h"
+#include "Bounds.h"
+#include "MappedFile.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+class TextureData;
+enum class TextureRole;
+
+
+// .       ,   -  
+struct MaterialAsset
+{
+	std::string name;
+	std::string diffuseMap;
+	std::string specularMap;
+	std::string normalMap;
+	DirectX::XMFLOAT4 diffuseColor = { 0.45f, 0.45f, 0.85f, 1.0f };
+	DirectX::XMFLOAT4 specularColor = { 0.18f, 0.18f, 0.18f, 1.0f };
+	float shininess = 2.0f;
+	//      half,         .
+	//    
+	bool halfPositions = true;
+	bool halfTexCoords = true;
+
+	//     :    ,
+	//  -  
+	CubeR::VertexLayout MakeLayout() const;
+};
+
+
+//  .     .cubemesh       .
+// Assimp,    16- ,      MeshAsset   
+struct MeshAsset
+{
+	struct Indices
+	{
+		//unsigned short  uint32_t    MeshAsset::indexSize
+		const void* pData = nullptr;
+		uint32_t count = 0u;
+	};
+	uint32_t materialIndex = 0u;
+	CubeR::VertexLayout layout;
+	const char* pVertices = nullptr;
+	uint32_t vertexCount = 0u;
+	//   : 2,     65536,  4
+	uint32_t indexSize = sizeof(unsigned short);
+	Indices indices;
+	//    1, 2, ...     
+	std::vector<Indices> lods;
+	BoundingVolume bounds;
+};
+
+
+//  .        ,  -  0
+struct NodeAsset
+{
+	std::string name;
+	// ,    DirectXMath
+	DirectX::XMFLOAT4X4 transform;
+	std::vector<uint32_t> meshes;
+	std::vector<uint32_t> children;
+};
+
+
+class ModelAsset
+{
+public:
+	ModelAsset() = default;
+	ModelAsset(const ModelAsset&) = delete;
+	ModelAsset& operator=(const ModelAsset&) = delete;
+	// .cubemesh  ,              
+	// ,       (.mtl, .bin),  ,       .cubemesh  .    false,   GetError.
+	//  CPU-  :  ,       WorkerPool.
+	//  ,        Model
+	bool Load(const std::filesystem::path& sourcePath);
+	//  Load:     ,  
+	bool LoadMeshes(const std::filesystem::path& sourcePath);
+	//  Load:   
+	void PrepareTextures(const std::filesystem::path& sourcePath);
+	//   ,    
+	static std::string GetTexturePath(const std::filesystem::path& sourcePath, const std::string& map);
+	//   , nullptr -     .
+	//          
+	const TextureData* GetTexture(const std::string& path, TextureRole role) const noexcept;
+	// Assimp,      : ,     
+	static std::string GetImportSettings();
+	const std::vector<MaterialAsset>& GetMaterials() const noexcept;
+	const std::vector<MeshAsset>& GetMeshes() const noexcept;
+	const std::vector<NodeAsset>& GetNodes() const noexcept;
+	//         
+	BoundingVolume GetBounds() const noexcept;
+	//true,     .cubemesh  
+	bool IsCooked() const noexcept;
+	// AssetCache,    ,    :
+	//     .
+	//     ,    
+	const std::string& GetKey() const noexcept;
+	const std::string& GetError() const noexcept;
+private:
+	//,  Assimp   .    
+	struct Dependency
+	{
+		std::string path;
+		uint64_t hash = 0u;
+	};
+private:
+	bool Import(const std::filesystem::path& sourcePath);
+	//     .cubemesh     
+	bool CheckDependencies(const std::filesystem::path& sourcePath) const;
+	//     ,     
+	bool Parse(const char* pData, size_t size);
+private:
+	MappedFile file;
+	std::vector<char> image;
+	std::vector<Dependency> dependencies;
+	std::vector<MaterialAsset> materials;
+	std::vector<MeshAsset> meshes;
+	std::vector<NodeAsset> nodes;
+	std::unordered_map<std::string, std::shared_ptr<const TextureData>> textures;
+	bool cooked = false;
+	std::string key;
+	std::string error;
+};
\ No newline at end of file
@@ -0,0 +1,100 @@
+//     .
+//   , CPU- (ModelAsset)    WorkerPool,
+//        Update        .
+//   ,     .        
+
+#pragma once
+#include "Mesh.h"
+#include "Material.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class ModelLoader
+{
+public:
+	using Handle = uint32_t;
+	static constexpr Handle InvalidHandle = 0u;
+	//  Update   ,     
+	using Callback = std::function<void(std::unique_ptr<Model>)>;
+	enum class Stage
+	{
+		Queued,
+		Meshes,
+		Textures,
+		Uploading,
+		Failed
+	};
+	struct Progress
+	{
+		Handle handle;
+		std::string name;
+		std::string path;
+		Stage stage;
+		//    0  1
+		float fraction;
+	};
+public:
+	ModelLoader() = default;
+	ModelLoader(const ModelLoader&) = delete;
+	ModelLoader& operator=(const ModelLoader&) = delete;
+	// CPU-  ,  
+	~ModelLoader();
+	Handle Request(const std::string& path, int id, std::string modelName, Callback onReady);
+	//,        
+	void SetPlacement(Handle handle, DirectX::FXMMATRIX transform) noexcept;
+	// ,    
+	void Cancel(Handle handle) noexcept;
+	void CancelAll() noexcept;
+	// :         
+	//     
+	void Update(Graphics& gfx);
+	//   ,  .    
+	void Flush(Graphics& gfx);
+	//     
+	void DrawPlaceholders(Graphics& gfx) const;
+	bool IsPending(Handle handle) const noexcept;
+	size_t GetPendingCount() const noexcept;
+	std::vector<Progress> GetProgress() const;
+	//  ,         .
+	//     ,     
+	void SetUploadBudget(size_t bytes) noexcept;
+	size_t GetUploadBudget() const noexcept;
+	size_t GetLastFrameUpload() const noexcept;
+private:
+	struct Job
+	{
+		Handle handle = InvalidHandle;
+		std::string path;
+		int id = 0;
+		std::string modelName;
+		Callback onReady;
+		DirectX::XMFLOAT4X4 placement;
+		std::atomic<bool> cancelled{ false };
+		//CPU-   asset, bounds  error    stage  Uploading  Failed.
+		//      ,       
+		std::atomic<Stage> stage{ Stage::Queued };
+		ModelAsset asset;
+		BoundingVolume bounds;
+		std::string error;
+		std::future<void> cpu;
+		//   
+		std::vector<Material> materials;
+		std::unique_ptr<Model> pModel;
+	};
+	//            
+	static size_t Step(Graphics& gfx, Job& job);
+	static size_t GetStepCount(const Job& job) noexcept;
+	static size_t GetStepsDone(const Job& job) noexcept;
+	Job* Find(Handle handle) const noexcept;
+private:
+	std::list<std::unique_ptr<Job>> jobs;
+	Handle nextHandle = 1u;
+	size_t uploadBudget = 32u << 20u;
+	size_t lastFrameUpload = 0u;
+};
\ No newline at end of file
@@ -8,4 +8,6 @@
 		NullPixelShader(Graphics& gfx);
 		void Bind(Graphics& gfx) noexcept override;
 		static std::shared_ptr<NullPixelShader> Resolve(Graphics& gfx);
+		static std::string GenerateUID();
+		std::string GetUID() const noexcept override;
 	};
@@ -0,0 +1,65 @@
+//     .
+//         ,
+//     MaxLights     .  
+//        (LightListCbuf)
+
+#pragma once
+#include "Bounds.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+//   ObjectLightCBuf  LightClusters.hlsli:     uint4
+struct ObjectLightList
+{
+	static constexpr uint32_t MaxLights = 8u;
+	//       
+	static constexpr uint32_t AllLights = 0xFFFFFFFFu;
+	uint32_t count = AllLights;
+	uint32_t padding[3] = {};
+	uint32_t indices[MaxLights] = {};
+
+	bool operator==(const ObjectLightList& other) const noexcept;
+	bool operator!=(const ObjectLightList& other) const noexcept;
+};
+
+
+class ObjectLights
+{
+public:
+	struct Stats
+	{
+		size_t objects = 0u;
+		size_t assigned = 0u;
+		//,    MaxLights :   
+		size_t truncated = 0u;
+	};
+public:
+	// .     ,   
+	void Clear() noexcept;
+	//   
+	void ResetStats() noexcept;
+	//index -      , luminance -    
+	void Add(uint32_t index, const DirectX::XMFLOAT3& worldPos, float range, float luminance,
+		float attConst, float attLin, float attQuad);
+	//  ,     AABB worldBounds,
+	//         
+	void Select(const BoundingVolume& worldBounds, ObjectLightList& list) noexcept;
+	size_t GetCount() const noexcept;
+	const Stats& GetStats() const noexcept;
+private:
+	struct Light
+	{
+		DirectX::XMFLOAT3 pos;
+		float range;
+		float luminance;
+		float attConst;
+		float attLin;
+		float attQuad;
+		uint32_t index;
+	};
+	std::vector<Light> lights;
+	Stats stats;
+};
\ No newline at end of file
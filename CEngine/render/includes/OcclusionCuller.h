@@ -0,0 +1,69 @@
+//     CPU.
+//         ,
+//    (HiZ),      .
+//  ,     
+
+#pragma once
+#include "Bounds.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+//  :        
+struct Occluder
+{
+	std::vector<DirectX::XMFLOAT3> vertices;
+	std::vector<uint32_t> indices;
+};
+
+
+class OcclusionCuller
+{
+public:
+	struct Stats
+	{
+		size_t occluderTriangles = 0u;
+		size_t tested = 0u;
+		size_t occluded = 0u;
+	};
+	//          CPU    
+	static constexpr size_t MaxOccluderTriangles = 1024u;
+	//    .   ,    
+	static constexpr size_t FrameTriangleBudget = 32768u;
+public:
+	//     :     
+	OcclusionCuller(size_t width = 256u, size_t height = 128u);
+	//     view * proj 
+	void BeginFrame(DirectX::FXMMATRIX viewProj) noexcept;
+	void RasterizeOccluder(const Occluder& occluder, DirectX::FXMMATRIX transform);
+	//  HiZ:           
+	void BuildHierarchy() noexcept;
+	//false,     transform   .
+	//,   ,  
+	bool IsVisible(const BoundingVolume& bounds, DirectX::FXMMATRIX transform) noexcept;
+	size_t GetWidth() const noexcept;
+	size_t GetHeight() const noexcept;
+	//  0   ,    
+	float GetDepth(size_t x, size_t y) const noexcept;
+	const Stats& GetStats() const noexcept;
+private:
+	struct Level
+	{
+		size_t width;
+		size_t height;
+		size_t offset;
+	};
+	void RasterizeTriangle(const DirectX::XMFLOAT3& v0, const DirectX::XMFLOAT3& v1, const DirectX::XMFLOAT3& v2) noexcept;
+private:
+	size_t width;
+	size_t height;
+	std::vector<Level> levels;
+	//  ,  0 -   
+	std::vector<float> depth;
+	//     ,   z.      z < 0
+	std::vector<DirectX::XMFLOAT3> screenVertices;
+	DirectX::XMFLOAT4X4 viewProj;
+	Stats stats;
+};
\ No newline at end of file
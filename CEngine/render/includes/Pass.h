@@ -1,26 +1,190 @@
 #pragma once
 #include "Graphics.h"
 #include "Job.h"
-#include <vector>
+#include "FrameArena.h"
+#include "InstanceBuffer.h"
+#include "Step.h"
+#include "Drawable.h"
+#include "ObjectLights.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
 
 class Pass
 {
 public:
+	Pass(FrameArena& arena, InstanceBuffer& instances) noexcept
+		:
+		jobs(arena),
+		instances(instances)
+	{}
 	void Accept(Job job) noexcept
 	{
 		jobs.push_back(job);
 	}
-	void Execute(Graphics& gfx) const noexcept
+	void Execute(Graphics& gfx) noexcept
 	{
-		for (const auto& j : jobs)
+		if (sorting)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			Sort(gfx.GetCamera());
+			sortTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+		else
 		{
-			j.Execute(gfx);
+			sortTime = 0.0f;
+		}
+		for (size_t i = 0u; i < jobs.size();)
+		{
+			const auto n = instancing ? CountInstanceRun(i) : 1u;
+			if (n > 1u)
+			{
+				ExecuteInstanced(gfx, i, n);
+			}
+			else
+			{
+				jobs[i].Execute(gfx);
+			}
+			i += n;
 		}
 	}
 	void Reset() noexcept
 	{
 		jobs.clear();
 	}
+	void EnableSorting(bool enable) noexcept
+	{
+		sorting = enable;
+	}
+	void EnableInstancing(bool enable) noexcept
+	{
+		instancing = enable;
+	}
+	size_t GetJobCount() const noexcept
+	{
+		return jobs.size();
+	}
+	//      
+	void GatherTransforms(const DirectX::XMFLOAT4X4** ppOut) const noexcept
+	{
+		for (size_t i = 0u; i < jobs.size(); ++i)
+		{
+			ppOut[i] = &jobs[i].GetTransform();
+		}
+	}
+	//      ,   first
+	void AssignTransformSlots(uint32_t first) noexcept
+	{
+		for (size_t i = 0u; i < jobs.size(); ++i)
+		{
+			jobs[i].SetTransformSlot(first + uint32_t(i));
+		}
+	}
+	//     , 
+	float GetSortTime() const noexcept
+	{
+		return sortTime;
+	}
+private:
+	//   ,   first,       
+	size_t CountInstanceRun(size_t first) const noexcept
+	{
+		const auto& head = jobs[first];
+		size_t last = first + 1u;
+		while (last < jobs.size() &&
+			jobs[last].GetDrawable().IsSameGeometry(head.GetDrawable()) &&
+			jobs[last].GetLod() == head.GetLod() &&
+			SameLights(jobs[last], head) &&
+			jobs[last].GetStep().IsInstanceCompatible(head.GetStep()))
+		{
+			++last;
+		}
+		return last - first;
+	}
+	//   -    
+	static bool SameLights(const Job& a, const Job& b) noexcept
+	{
+		if (a.GetLights() == b.GetLights())
+		{
+			return true;
+		}
+		return a.GetLights() != nullptr && b.GetLights() != nullptr && *a.GetLights() == *b.GetLights();
+	}
+	// count     (   ) 
+	void ExecuteInstanced(Graphics& gfx, size_t first, size_t count) noexcept
+	{
+		const auto& head = jobs[first];
+		gfx.SetObjectLights(head.GetLights());
+		head.GetDrawable().Bind(gfx, head.GetLod());
+		head.GetStep().BindInstanced(gfx);
+		instances.Bind(gfx);
+		const auto indexCount = head.GetDrawable().GetIndexCount(head.GetLod());
+		while (count > 0u)
+		{
+			const auto batch = UINT(std::min<size_t>(count, instances.GetCapacity()));
+			const auto start = instances.Upload(gfx, batch, [&](UINT i) -> const DirectX::XMFLOAT4X4&
+			{
+				return jobs[first + i].GetTransform();
+			});
+			gfx.DrawIndexedInstanced(indexCount, batch, start);
+			first += batch;
+			count -= batch;
+		}
+	}
+	// (LSD)   64- ,  8   .
+	//,       , 
+	void Sort(DirectX::FXMMATRIX view) noexcept
+	{
+		if (jobs.size() < 2u)
+		{
+			return;
+		}
+		for (auto& j : jobs)
+		{
+			j.UpdateSortKey(view);
+		}
+		std::array<std::array<size_t, 256>, 8> counts = {};
+		for (const auto& j : jobs)
+		{
+			const auto key = j.GetSortKey();
+			for (size_t b = 0u; b < 8u; ++b)
+			{
+				++counts[b][(key >> (b * 8u)) & 0xFFu];
+			}
+		}
+		const auto n = jobs.size();
+		Job* pSrc = jobs.data();
+		Job* pDst = jobs.GetArena().Allocate<Job>(n);
+		for (size_t b = 0u; b < 8u; ++b)
+		{
+			auto& count = counts[b];
+			if (count[(pSrc[0].GetSortKey() >> (b * 8u)) & 0xFFu] == n)
+			{
+				continue;
+			}
+			size_t offset = 0u;
+			for (auto& c : count)
+			{
+				const auto k = c;
+				c = offset;
+				offset += k;
+			}
+			for (size_t i = 0u; i < n; ++i)
+			{
+				std::memcpy(static_cast<void*>(&pDst[count[(pSrc[i].GetSortKey() >> (b * 8u)) & 0xFFu]++]), &pSrc[i], sizeof(Job));
+			}
+			std::swap(pSrc, pDst);
+		}
+		if (pSrc != jobs.data())
+		{
+			std::memcpy(static_cast<void*>(jobs.data()), pSrc, sizeof(Job) * n);
+		}
+	}
 private:
-	std::vector<Job> jobs;
+	bool sorting = true;
+	bool instancing = true;
+	float sortTime = 0.0f;
+	FrameVector<Job> jobs;
+	InstanceBuffer& instances;
 };
\ No newline at end of file
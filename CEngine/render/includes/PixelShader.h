@@ -11,6 +11,10 @@
 	public:
 		PixelShader(Graphics& gfx, const std::wstring& path);
 		void Bind(Graphics& gfx)  noexcept override;
+		static std::shared_ptr<PixelShader> Resolve(Graphics& gfx, const std::wstring& path);
+		static std::string GenerateUID(const std::wstring& path);
+		std::string GetUID() const noexcept override;
 	protected:
+		std::wstring path;
 		Microsoft::WRL::ComPtr<ID3D11PixelShader> pPixelShader;
 	};
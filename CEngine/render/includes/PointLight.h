@@ -1,10 +1,14 @@
 //       .      
-//   
+//   .    :      
+// (LightClusters),       
 
 #pragma once
 #include "Graphics.h"
 #include "SolidSphere.h"
 #include "ConstantBuffers.h"
+#include "StructuredBuffer.h"
+#include "LightClusters.h"
+#include "ObjectLights.h"
 
 
 struct PointLightCBuf
@@ -18,6 +22,30 @@ struct PointLightCBuf
 	float attQuad;
 };
 
+//    ,    PointLight  LightClusters.hlsli
+struct PointLightGPU
+{
+	DirectX::XMFLOAT3 pos;
+	float range;
+	DirectX::XMFLOAT3 diffuseColor;
+	float diffuseIntensity;
+	float attConst;
+	float attLin;
+	float attQuad;
+	float padding;
+};
+
+//           
+struct ClusterCBuf
+{
+	DirectX::XMFLOAT3 ambient;
+	float zScale;
+	DirectX::XMFLOAT2 viewportOrigin;
+	DirectX::XMFLOAT2 tileScale;
+	float zBias;
+	float padding[3];
+};
+
 class Lights
 {
 public:
@@ -29,13 +57,21 @@ public:
 		void Reset() noexcept;
 		void Submit(class FrameCommander& frame) const noexcept;
 		bool DrawSphere(); 
-		PointLightCBuf getCbuf() const;
+		const PointLightCBuf& getCbuf() const;
 		void setCbuf(PointLightCBuf Cbuf);
+		//              Lights
+		bool IsDirty() const noexcept;
+		void ClearDirty() noexcept;
+		//   : ,     (Rec. 709)
+		float GetLuminance() const noexcept;
+		//,        cutoffLuminance
+		float GetRange(float cutoffLuminance) const noexcept;
 		const int id;
 		std::string lightName;
 		bool drawSphere = true;
 	private:
 		PointLightCBuf cbData;
+		bool dirty = true;
 		mutable SolidSphere mesh;
 	};
 	Lights(Graphics& gfx, float radius = 0.5f);
@@ -45,13 +81,51 @@ public:
 	int getId(int i);
 	std::string getName(int i);
 	void DeleteLight(int i);
-	void UpdateCbufs();
 	void spawnWnds();
 	void drawSpheres(class FrameCommander& frame);
+	//    ,          .
+	//   ,    ,   
 	void Bind(Graphics& gfx, DirectX::FXMMATRIX view) noexcept;
+	// ,       GPU
+	size_t GetUploadCount() const noexcept;
+	const LightClusters::Stats& GetClusterStats() const noexcept;
+	//        .   Bind
+	ObjectLights& GetObjectLights() noexcept;
+	//,        .   
+	void SetCutoffLuminance(float luminance) noexcept;
+	float GetCutoffLuminance() const noexcept;
 	std::vector<std::unique_ptr<PointLight>> sceneLights;
+private:
+	//     .       
+	//   ,           
+	struct LightArrays
+	{
+		std::vector<float> x, y, z;
+		std::vector<float> viewX, viewY, viewZ;
+		std::vector<float> range;
+		std::vector<float> luminance;
+		std::vector<PointLightGPU> gpu;
+		size_t count = 0u;
+		void Resize(size_t n);
+	};
+	//    .  true,  - 
+	bool SyncArrays() noexcept;
+	void TransformToView(const DirectX::XMFLOAT4X4& view) noexcept;
 private:
 	int id = 0;
-	PointLightCBuf cbufs[32];
-	mutable PixelConstantBuffer<PointLightCBuf> cbuf;
+	float cutoffLuminance = 1.0f / 256.0f;
+	//    :   
+	bool structureDirty = true;
+	LightArrays arrays;
+	DirectX::XMFLOAT3 ambient = { 0.0f,0.0f,0.0f };
+	DirectX::XMFLOAT4X4 lastView = {};
+	DirectX::XMFLOAT4X4 lastProj = {};
+	D3D11_VIEWPORT lastViewport = {};
+	size_t uploads = 0u;
+	LightClusters clusters;
+	ObjectLights objectLights;
+	PixelConstantBuffer<ClusterCBuf> clusterCbuf;
+	PixelStructuredBuffer<PointLightGPU> lightBuffer;
+	PixelStructuredBuffer<LightClusters::Range> clusterBuffer;
+	PixelStructuredBuffer<uint32_t> indexBuffer;
 };
\ No newline at end of file
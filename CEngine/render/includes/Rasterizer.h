@@ -10,6 +10,10 @@
 	public:
 		Rasterizer(Graphics& gfx, bool twoSided);
 		void Bind(Graphics& gfx)  noexcept override;
+		static std::shared_ptr<Rasterizer> Resolve(Graphics& gfx, bool twoSided);
+		static std::string GenerateUID(bool twoSided);
+		std::string GetUID() const noexcept override;
 	protected:
+		bool twoSided;
 		wrl::ComPtr <ID3D11RasterizerState> RSCull;
 	};
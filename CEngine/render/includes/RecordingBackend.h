@@ -0,0 +1,96 @@
+//  GPU:           .
+//       FrameCommander, Model  Lights  
+
+#pragma once
+#include "RenderBackend.h"
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+
+class RecordingBackend : public RenderBackend
+{
+public:
+	enum class CommandType
+	{
+		Topology,
+		InputLayout,
+		IndexBuffer,
+		VertexBuffer,
+		VertexShader,
+		PixelShader,
+		VSConstantBuffer,
+		PSConstantBuffer,
+		PSShaderResource,
+		PSSampler,
+		BlendState,
+		DepthStencilState,
+		RasterizerState,
+		Map,
+		Unmap,
+		UpdateSubresource,
+		GenerateMips,
+		DrawIndexed,
+		DrawIndexedInstanced,
+		Count
+	};
+	//  .     :
+	//, , ,      ..
+	struct Command
+	{
+		CommandType type;
+		const void* pObject;
+		UINT args[4];
+	};
+public:
+	// recordLog == false,   ,        
+	RecordingBackend(bool recordLog = true) noexcept;
+
+	void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept override;
+	void SetInputLayout(ID3D11InputLayout* pLayout) noexcept override;
+	void SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept override;
+	void SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept override;
+	void SetVertexShader(ID3D11VertexShader* pShader) noexcept override;
+	void SetPixelShader(ID3D11PixelShader* pShader) noexcept override;
+	void SetVSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept override;
+	void SetVSConstantBufferRange(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept override;
+	void SetPSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept override;
+	void SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept override;
+	void SetPSSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept override;
+	void SetBlendState(ID3D11BlendState* pState) noexcept override;
+	void SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept override;
+	void SetRasterizerState(ID3D11RasterizerState* pState) noexcept override;
+	bool SupportsConstantBufferOffsets() const noexcept override;
+
+	//    ,     Map   
+	void* Map(ID3D11Buffer* pBuffer, D3D11_MAP type, size_t offset, size_t size) noexcept override;
+	void Unmap(ID3D11Buffer* pBuffer) noexcept override;
+	void UpdateSubresource(ID3D11Resource* pResource, const void* pData, UINT rowPitch, size_t size) noexcept override;
+	void GenerateMips(ID3D11ShaderResourceView* pView) noexcept override;
+
+	void DrawIndexed(UINT count, UINT startIndex, INT baseVertex) noexcept override;
+	void DrawIndexedInstanced(UINT count, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) noexcept override;
+
+	const std::vector<Command>& GetCommands() const noexcept;
+	size_t GetCount(CommandType type) const noexcept;
+	//   
+	size_t GetBindCount() const noexcept;
+	//,   Map  UpdateSubresource
+	size_t GetUploadedBytes() const noexcept;
+	//,   ,    
+	size_t GetIndexCount() const noexcept;
+	// ,     Map,  nullptr
+	const std::vector<std::byte>* GetMappedData(ID3D11Buffer* pBuffer) const noexcept;
+	//   ,    
+	void Clear() noexcept;
+private:
+	void Record(CommandType type, const void* pObject, UINT a = 0u, UINT b = 0u, UINT c = 0u, UINT d = 0u) noexcept;
+private:
+	bool recordLog;
+	std::vector<Command> commands;
+	std::array<size_t, size_t(CommandType::Count)> counts = {};
+	size_t uploadedBytes = 0u;
+	size_t indexCount = 0u;
+	std::unordered_map<ID3D11Buffer*, std::vector<std::byte>> mapped;
+};
\ No newline at end of file
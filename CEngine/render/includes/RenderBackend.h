@@ -0,0 +1,42 @@
+// ,   Graphics  Bindable    .
+// -   ID3D11Device,  ,      
+//  ,    , ,     GPU (RecordingBackend)
+
+#pragma once
+#include <d3d11.h>
+#include <cstddef>
+
+
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() = default;
+
+	//.   StateTracker    
+	virtual void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept = 0;
+	virtual void SetInputLayout(ID3D11InputLayout* pLayout) noexcept = 0;
+	virtual void SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept = 0;
+	virtual void SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept = 0;
+	virtual void SetVertexShader(ID3D11VertexShader* pShader) noexcept = 0;
+	virtual void SetPixelShader(ID3D11PixelShader* pShader) noexcept = 0;
+	virtual void SetVSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept = 0;
+	virtual void SetVSConstantBufferRange(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept = 0;
+	virtual void SetPSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept = 0;
+	virtual void SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept = 0;
+	virtual void SetPSSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept = 0;
+	virtual void SetBlendState(ID3D11BlendState* pState) noexcept = 0;
+	virtual void SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept = 0;
+	virtual void SetRasterizerState(ID3D11RasterizerState* pState) noexcept = 0;
+	virtual bool SupportsConstantBufferOffsets() const noexcept = 0;
+
+	//   .       nullptr,     .
+	//offset  size - ,    ( NO_OVERWRITE   )
+	virtual void* Map(ID3D11Buffer* pBuffer, D3D11_MAP type, size_t offset, size_t size) noexcept = 0;
+	virtual void Unmap(ID3D11Buffer* pBuffer) noexcept = 0;
+	//     USAGE_DEFAULT. size -   
+	virtual void UpdateSubresource(ID3D11Resource* pResource, const void* pData, UINT rowPitch, size_t size) noexcept = 0;
+	virtual void GenerateMips(ID3D11ShaderResourceView* pView) noexcept = 0;
+
+	virtual void DrawIndexed(UINT count, UINT startIndex, INT baseVertex) noexcept = 0;
+	virtual void DrawIndexedInstanced(UINT count, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) noexcept = 0;
+};
\ No newline at end of file
@@ -0,0 +1,161 @@
+//    (BVH)   .
+//     ,       
+
+#pragma once
+#include "Bounds.h"
+#include <vector>
+#include <cstddef>
+
+class Model;
+
+class SceneBVH
+{
+public:
+	struct Stats
+	{
+		size_t leaves = 0u;
+		size_t nodes = 0u;
+		size_t visited = 0u;
+		size_t refits = 0u;
+		size_t rebuilds = 0u;
+	};
+public:
+	SceneBVH() = default;
+	SceneBVH(const SceneBVH&) = delete;
+	SceneBVH& operator=(const SceneBVH&) = delete;
+	//     bounds,   
+	int Insert(Model* pModel, const BoundingVolume& bounds);
+	void Remove(int proxy) noexcept;
+	//   AABB,      .
+	//      AABB,       
+	void Move(int proxy, const BoundingVolume& bounds) noexcept;
+	//   .     
+	void Rebuild();
+	// ,           
+	void Maintain();
+	//  ,  . f(Model&, bool inside)    ,
+	//inside -    ,      
+	template<typename F>
+	void QueryFrustum(const Frustum& frustum, F&& f)
+	{
+		stats.visited = 0u;
+		if (root < 0)
+		{
+			return;
+		}
+		stack.clear();
+		stack.push_back({ root, false });
+		while (!stack.empty())
+		{
+			const auto entry = stack.back();
+			stack.pop_back();
+			++stats.visited;
+			const auto& node = nodes[entry.index];
+			bool inside = entry.inside;
+			if (!inside)
+			{
+				const auto result = frustum.Test(ToVolume(node));
+				if (result == Frustum::Result::Outside)
+				{
+					continue;
+				}
+				inside = result == Frustum::Result::Inside;
+			}
+			if (node.IsLeaf())
+			{
+				f(*node.pModel, inside);
+			}
+			else
+			{
+				stack.push_back({ node.right, inside });
+				stack.push_back({ node.left, inside });
+			}
+		}
+	}
+	// f(Model&)  ,    
+	template<typename F>
+	void QueryRange(const BoundingVolume& range, F&& f)
+	{
+		stats.visited = 0u;
+		if (root < 0 || range.IsEmpty())
+		{
+			return;
+		}
+		const auto box = ToBox(range);
+		stack.clear();
+		stack.push_back({ root, false });
+		while (!stack.empty())
+		{
+			const auto& node = nodes[stack.back().index];
+			stack.pop_back();
+			++stats.visited;
+			if (!Overlaps(node.box, box))
+			{
+				continue;
+			}
+			if (node.IsLeaf())
+			{
+				f(*node.pModel);
+			}
+			else
+			{
+				stack.push_back({ node.right, false });
+				stack.push_back({ node.left, false });
+			}
+		}
+	}
+	// ,      ,  nullptr. dir   .
+	// AABB    ,       Model::Raycast
+	Model* Raycast(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, float maxDistance, float* pDistance = nullptr);
+	Stats GetStats() const noexcept;
+private:
+	struct Box
+	{
+		DirectX::XMFLOAT3 min;
+		DirectX::XMFLOAT3 max;
+	};
+	struct TreeNode
+	{
+		Box box;
+		// AABB   , box      
+		Box tight;
+		int parent = -1;
+		int left = -1;
+		int right = -1;
+		Model* pModel = nullptr;
+		bool IsLeaf() const noexcept
+		{
+			return left < 0;
+		}
+	};
+	struct StackEntry
+	{
+		int index;
+		bool inside;
+	};
+private:
+	static Box ToBox(const BoundingVolume& bv) noexcept;
+	//AABB   ,       
+	static Box Fatten(const Box& b) noexcept;
+	static BoundingVolume ToVolume(const TreeNode& node) noexcept;
+	static Box Union(const Box& a, const Box& b) noexcept;
+	static bool Contains(const Box& outer, const Box& inner) noexcept;
+	static bool Overlaps(const Box& a, const Box& b) noexcept;
+	static float Area(const Box& b) noexcept;
+	int AllocateNode();
+	void FreeNode(int index) noexcept;
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf) noexcept;
+	void Refit(int index) noexcept;
+	int Build(int* pLeaves, size_t count, int parent);
+private:
+	std::vector<TreeNode> nodes;
+	std::vector<int> freeNodes;
+	std::vector<StackEntry> stack;
+	std::vector<int> leafScratch;
+	int root = -1;
+	size_t leafCount = 0u;
+	//       
+	size_t changes = 0u;
+	Stats stats;
+};
\ No newline at end of file
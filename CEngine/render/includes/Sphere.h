@@ -4,13 +4,14 @@
 #include "IndexedTriangleList.h"
 #include <DirectXMath.h>
 #include "../core/includes/CMath.h"
-#include <optional>
-#include "Vertex.h"
+#include "CVertex.h"
 
 class Sphere
 {
 public:
-	static IndexedTriangleList MakeTesselated(CubeR::VertexLayout layout, int latDiv, int longDiv)
+	//Layout - CubeR::StaticVertexLayout  ,    
+	template<class Layout = CubeR::StaticVertexLayout<CubeR::VertexLayout::Position3D>>
+	static IndexedTriangleList MakeTesselated(int latDiv, int longDiv)
 	{
 		namespace dx = DirectX;
 		assert(latDiv >= 3);
@@ -21,7 +22,12 @@ public:
 		const float lattitudeAngle = PI / latDiv;
 		const float longitudeAngle = 2.0f * PI / longDiv;
 
-		CubeR::VertexBuffer vb{ std::move(layout) };
+		std::vector<typename Layout::Vertex> vb;
+		vb.reserve(size_t(latDiv - 1) * longDiv + 2u);
+		const auto emplacePosition = [&vb](const dx::XMFLOAT3& pos)
+		{
+			vb.emplace_back().template Attr<CubeR::VertexLayout::Position3D>() = pos;
+		};
 		for (int iLat = 1; iLat < latDiv; iLat++)
 		{
 			const auto latBase = dx::XMVector3Transform(
@@ -36,21 +42,21 @@ public:
 					dx::XMMatrixRotationZ(longitudeAngle * iLong)
 				);
 				dx::XMStoreFloat3(&calculatedPos, v);
-				vb.EmplaceBack(calculatedPos);
+				emplacePosition(calculatedPos);
 			}
 		}
 
-		const auto iNorthPole = (unsigned short)vb.Size();
+		const auto iNorthPole = (unsigned short)vb.size();
 		{
 			dx::XMFLOAT3 northPos;
 			dx::XMStoreFloat3(&northPos, base);
-			vb.EmplaceBack(northPos);
+			emplacePosition(northPos);
 		}
-		const auto iSouthPole = (unsigned short)vb.Size();
+		const auto iSouthPole = (unsigned short)vb.size();
 		{
 			dx::XMFLOAT3 southPos;
 			dx::XMStoreFloat3(&southPos, dx::XMVectorNegate(base));
-			vb.EmplaceBack(southPos);
+			emplacePosition(southPos);
 		}
 
 		const auto calcIdx = [latDiv, longDiv](unsigned short iLat, unsigned short iLong)
@@ -93,15 +99,11 @@ public:
 		indices.push_back(calcIdx(latDiv - 2, longDiv - 1));
 		indices.push_back(iSouthPole);
 
-		return { std::move(vb),std::move(indices) };
+		return { CubeR::VertexBuffer(vb),std::move(indices) };
 	}
-	static IndexedTriangleList Make(std::optional<CubeR::VertexLayout> layout = std::nullopt)
+	template<class Layout = CubeR::StaticVertexLayout<CubeR::VertexLayout::Position3D>>
+	static IndexedTriangleList Make()
 	{
-		using Element = CubeR::VertexLayout::ElementType;
-		if (!layout)
-		{
-			layout = CubeR::VertexLayout{}.Append(Element::Position3D);
-		}
-		return MakeTesselated(std::move(*layout), 12, 24);
+		return MakeTesselated<Layout>(12, 24);
 	}
 };
\ No newline at end of file
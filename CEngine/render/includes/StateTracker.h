@@ -0,0 +1,134 @@
+//,    DirectX       
+
+#pragma once
+#include "RenderBackend.h"
+#include <array>
+
+
+class StateTracker
+{
+public:
+	struct Stats
+	{
+		size_t issued = 0u;
+		size_t skipped = 0u;
+	};
+	//    ,    .
+	//          
+	static constexpr UINT TrackedSlots = 16u;
+public:
+	StateTracker(RenderBackend& backend) noexcept;
+	StateTracker(const StateTracker&) = delete;
+	StateTracker& operator=(const StateTracker&) = delete;
+
+	void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept;
+	void SetInputLayout(ID3D11InputLayout* pLayout) noexcept;
+	void SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept;
+	void SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept;
+	void SetVertexShader(ID3D11VertexShader* pShader) noexcept;
+	void SetPixelShader(ID3D11PixelShader* pShader) noexcept;
+	void SetVSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept;
+	//    (D3D11.1). firstConstant  numConstants  16
+	void SetVSConstantBufferRange(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept;
+	//       
+	bool SupportsConstantBufferOffsets() const noexcept;
+	void SetPSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept;
+	void SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept;
+	void SetPSSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept;
+	void SetBlendState(ID3D11BlendState* pState) noexcept;
+	void SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept;
+	void SetRasterizerState(ID3D11RasterizerState* pState) noexcept;
+
+	//  .   ,  
+	//    (ImGui, DirectXTK)
+	void Invalidate() noexcept;
+	void ResetStats() noexcept;
+	const Stats& GetStats() const noexcept;
+private:
+	//    .   ,   
+	template<typename T>
+	struct Tracked
+	{
+		T value{};
+		bool known = false;
+	};
+	template<typename T>
+	bool Update(Tracked<T>& slot, const T& value) noexcept
+	{
+		if (slot.known && slot.value == value)
+		{
+			++stats.skipped;
+			return false;
+		}
+		slot.value = value;
+		slot.known = true;
+		++stats.issued;
+		return true;
+	}
+	template<typename T>
+	bool Update(std::array<Tracked<T>, TrackedSlots>& slots, UINT slot, const T& value) noexcept
+	{
+		if (slot >= TrackedSlots)
+		{
+			++stats.issued;
+			return true;
+		}
+		return Update(slots[slot], value);
+	}
+	struct IndexBinding
+	{
+		ID3D11Buffer* pBuffer;
+		DXGI_FORMAT format;
+		UINT offset;
+		bool operator==(const IndexBinding& rhs) const noexcept
+		{
+			return pBuffer == rhs.pBuffer && format == rhs.format && offset == rhs.offset;
+		}
+	};
+	struct VertexBinding
+	{
+		ID3D11Buffer* pBuffer;
+		UINT stride;
+		UINT offset;
+		bool operator==(const VertexBinding& rhs) const noexcept
+		{
+			return pBuffer == rhs.pBuffer && stride == rhs.stride && offset == rhs.offset;
+		}
+	};
+	struct ConstantBinding
+	{
+		ID3D11Buffer* pBuffer;
+		UINT firstConstant;
+		UINT numConstants;
+		bool operator==(const ConstantBinding& rhs) const noexcept
+		{
+			return pBuffer == rhs.pBuffer && firstConstant == rhs.firstConstant && numConstants == rhs.numConstants;
+		}
+	};
+	struct DepthStencilBinding
+	{
+		ID3D11DepthStencilState* pState;
+		UINT stencilRef;
+		bool operator==(const DepthStencilBinding& rhs) const noexcept
+		{
+			return pState == rhs.pState && stencilRef == rhs.stencilRef;
+		}
+	};
+private:
+	RenderBackend& backend;
+	Stats stats;
+
+	Tracked<D3D11_PRIMITIVE_TOPOLOGY> topology;
+	Tracked<ID3D11InputLayout*> inputLayout;
+	Tracked<IndexBinding> indexBuffer;
+	std::array<Tracked<VertexBinding>, TrackedSlots> vertexBuffers;
+	Tracked<ID3D11VertexShader*> vertexShader;
+	Tracked<ID3D11PixelShader*> pixelShader;
+	std::array<Tracked<ConstantBinding>, TrackedSlots> vsConstantBuffers;
+	std::array<Tracked<ID3D11Buffer*>, TrackedSlots> psConstantBuffers;
+	std::array<Tracked<ID3D11ShaderResourceView*>, TrackedSlots> psResources;
+	std::array<Tracked<ID3D11SamplerState*>, TrackedSlots> psSamplers;
+	Tracked<ID3D11BlendState*> blendState;
+	Tracked<DepthStencilBinding> depthStencilState;
+	Tracked<ID3D11RasterizerState*> rasterizerState;
+};
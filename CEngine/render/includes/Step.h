@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <cstdint>
 #include "Bindable.h"
 #include "Graphics.h"
 
@@ -12,6 +13,34 @@ public:
 		:
 		targetPass{ targetPass_in }
 	{}
+	// Bindable   ,    Drawable (CloningBindable) - ,
+	//  Drawable   
+	Step(const Step& src) noexcept
+		:
+		targetPass{ src.targetPass },
+		programId{ src.programId },
+		textureSetId{ src.textureSetId },
+		blended{ src.blended },
+		instanceBindables{ src.instanceBindables },
+		pInstancedVS{ src.pInstancedVS },
+		pInstancedLayout{ src.pInstancedLayout }
+	{
+		bindables.reserve(src.bindables.size());
+		for (const auto& pb : src.bindables)
+		{
+			if (const auto pc = dynamic_cast<const CloningBindable*>(pb.get()))
+			{
+				bindables.push_back(pc->Clone());
+			}
+			else
+			{
+				bindables.push_back(pb);
+			}
+		}
+	}
+	Step(Step&&) = default;
+	Step& operator=(const Step&) = delete;
+	Step& operator=(Step&&) = default;
 	//template<class B>
 	//B* QueryBindable() noexcept
 	//{
@@ -24,11 +53,9 @@ public:
 	//	}
 	//	return nullptr;
 	//}
-	void AddBindable(std::shared_ptr<Bindable> bind_in) noexcept
-	{
-		bindables.push_back(std::move(bind_in));
-	}
-	void Submit(class FrameCommander& frame, const class Drawable& drawable) const;
+	void AddBindable(std::shared_ptr<Bindable> bind_in) noexcept;
+	void Submit(class FrameCommander& frame, const class Drawable& drawable, const DirectX::XMFLOAT4X4* pTransform, size_t lod = 0u,
+		const struct ObjectLightList* pLights = nullptr) const;
 	void Bind(Graphics& gfx) const
 	{
 		for (const auto& b : bindables)
@@ -37,7 +64,40 @@ public:
 		}
 	}
 	void InitializeParentReferences(const class Drawable& parent) noexcept;
+	//   -:     ,  
+	//   .  Bindable,  CloningBindable,   
+	void SetInstancedVariant(std::shared_ptr<class VertexShader> pVS, std::shared_ptr<class InputLayout> pLayout) noexcept;
+	bool SupportsInstancing() const noexcept
+	{
+		return pInstancedVS != nullptr;
+	}
+	//     -,      Bindable
+	bool IsInstanceCompatible(const Step& other) const noexcept;
+	void BindInstanced(Graphics& gfx) const;
+	//  :  ,     
+	uint32_t GetProgramId() const noexcept
+	{
+		return programId;
+	}
+	uint32_t GetTextureSetId() const noexcept
+	{
+		return textureSetId;
+	}
+	bool IsBlended() const noexcept
+	{
+		return blended;
+	}
+	size_t GetTargetPass() const noexcept
+	{
+		return targetPass;
+	}
 private:
 	size_t targetPass;
+	uint32_t programId = 0u;
+	uint32_t textureSetId = 0u;
+	bool blended = false;
+	std::vector<std::shared_ptr<Bindable>> instanceBindables;
+	std::shared_ptr<Bindable> pInstancedVS;
+	std::shared_ptr<Bindable> pInstancedLayout;
 	std::vector<std::shared_ptr<Bindable>> bindables;
 };
\ No newline at end of file
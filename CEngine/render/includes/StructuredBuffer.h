@@ -0,0 +1,69 @@
+// ,     StructuredBuffer<T> (Bindable).
+//   ,       
+
+#pragma once
+#include "Bindable.h"
+#include <algorithm>
+
+	template<typename T>
+	class PixelStructuredBuffer : public Bindable
+	{
+	public:
+		PixelStructuredBuffer(Graphics& gfx, UINT slot, UINT capacity = 64u) : slot(slot)
+		{
+			Create(gfx, std::max(capacity, 1u));
+		}
+		void Update(Graphics& gfx, const T* pData, UINT count)
+		{
+			if (count > capacity)
+			{
+				Create(gfx, std::max(count, capacity * 2u));
+			}
+			if (count == 0u)
+			{
+				return;
+			}
+			auto& backend = GetBackend(gfx);
+			if (const auto pDst = backend.Map(pBuffer.Get(), D3D11_MAP_WRITE_DISCARD, 0u, sizeof(T) * count))
+			{
+				memcpy(pDst, pData, sizeof(T) * count);
+				backend.Unmap(pBuffer.Get());
+			}
+		}
+		void Bind(Graphics& gfx) noexcept override
+		{
+			GetState(gfx).SetPSShaderResource(slot, pView.Get());
+		}
+		UINT GetCapacity() const noexcept
+		{
+			return capacity;
+		}
+	private:
+		void Create(Graphics& gfx, UINT capacity_in)
+		{
+			capacity = capacity_in;
+			pView.Reset();
+			pBuffer.Reset();
+
+			D3D11_BUFFER_DESC bd;
+			bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+			bd.Usage = D3D11_USAGE_DYNAMIC;
+			bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+			bd.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+			bd.ByteWidth = sizeof(T) * capacity;
+			bd.StructureByteStride = sizeof(T);
+			GetDevice(gfx)->CreateBuffer(&bd, nullptr, &pBuffer);
+
+			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+			srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+			srvDesc.Buffer.FirstElement = 0u;
+			srvDesc.Buffer.NumElements = capacity;
+			GetDevice(gfx)->CreateShaderResourceView(pBuffer.Get(), &srvDesc, &pView);
+		}
+	private:
+		UINT slot;
+		UINT capacity = 0u;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pBuffer;
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pView;
+	};
\ No newline at end of file
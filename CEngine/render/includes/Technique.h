@@ -6,7 +6,8 @@
 class Technique
 {
 public:
-	void Submit(class FrameCommander& frame, const class Drawable& drawable) const noexcept;
+	void Submit(class FrameCommander& frame, const class Drawable& drawable, const DirectX::XMFLOAT4X4* pTransform, size_t lod = 0u,
+		const struct ObjectLightList* pLights = nullptr) const noexcept;
 	void AddStep(Step step) noexcept
 	{
 		steps.push_back(std::move(step));
@@ -3,19 +3,63 @@
 
 #pragma once
 #include "Bindable.h"
+#include "MappedFile.h"
+#include "TextureManager.h"
 #include "../core/includes/Log.h"
+#include <vector>
 
 
+	//,     : DDS      .
+	//    ,        
+	class TextureData
+	{
+		friend class TextureManager;
+	public:
+		//  .dds   AssetCache,   ,  ,
+		//   BC-       .
+		//Diffuse - BC1,   BC3; Specular - BC1,     BC7;
+		//Normal - BC5 (z   ),     BC7.
+		//     4   B8G8R8A8
+		static std::shared_ptr<const TextureData> Load(const std::string& name, TextureRole role = TextureRole::Diffuse);
+		bool IsValid() const noexcept;
+		// ,   :   TextureManager       .
+		//  -    
+		const std::string& GetContentKey() const noexcept;
+		TextureRole GetRole() const noexcept;
+		// DDS   :        
+		size_t GetSize() const noexcept;
+	private:
+		const char* GetData() const noexcept;
+	private:
+		MappedFile mapped;
+		//   DDS,      
+		std::vector<char> bytes;
+		bool sourceDds = false;
+		TextureRole role = TextureRole::Diffuse;
+		std::string contentKey;
+	};
+
+
+	//   TextureManager  .       
+	//    
 	class Texture : public Bindable
 	{
 	public:
-		Texture(Graphics& gfx, const std::string name, unsigned int slot = 0);
+		Texture(Graphics& gfx, const std::string name, unsigned int slot = 0, TextureRole role = TextureRole::Diffuse);
+		//   :      ,    
+		Texture(Graphics& gfx, const std::string name, unsigned int slot, const TextureData& data);
 		void Bind(Graphics& gfx) noexcept;
 		bool HasAlpha() const noexcept;
+		// ,    ,      
+		static std::shared_ptr<Texture> Resolve(Graphics& gfx, const std::string& name, unsigned int slot = 0, TextureRole role = TextureRole::Diffuse);
+		static std::shared_ptr<Texture> Resolve(Graphics& gfx, const std::string& name, unsigned int slot, const TextureData& data);
+		//   :          -    
+		static std::string GenerateUID(const std::string& name, unsigned int slot = 0, TextureRole role = TextureRole::Diffuse);
+		static std::string GenerateUID(const std::string& name, unsigned int slot, const TextureData& data);
+		std::string GetUID() const noexcept override;
 	private:
+		std::string name;
 		unsigned int slot;
-	protected:
-		bool hasAlpha = false;
-	private:
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTextureView;
+		TextureRole role;
+		std::shared_ptr<const TextureView> pView;
 	};
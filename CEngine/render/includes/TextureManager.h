@@ -0,0 +1,87 @@
+//      .
+//     ,      TextureData, 
+//      ,           .
+//    :      
+
+#pragma once
+#include "Graphics.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+class TextureData;
+
+
+//   ,       
+enum class TextureRole
+{
+	Diffuse,
+	Specular,
+	Normal
+};
+
+
+// ,    
+class TextureView
+{
+	friend class TextureManager;
+public:
+	TextureView(const TextureView&) = delete;
+	TextureView& operator=(const TextureView&) = delete;
+	~TextureView();
+	//nullptr,     
+	ID3D11ShaderResourceView* Get() const noexcept;
+	bool HasAlpha() const noexcept;
+	//        
+	uint64_t GetSize() const noexcept;
+	const std::string& GetPath() const noexcept;
+private:
+	TextureView() = default;
+private:
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pView;
+	bool hasAlpha = false;
+	uint64_t size = 0u;
+	std::string path;
+};
+
+
+class TextureManager
+{
+	friend class TextureView;
+public:
+	struct Stats
+	{
+		//      
+		size_t textures = 0u;
+		uint64_t residentBytes = 0u;
+		//  ,      ,  
+		size_t pathHits = 0u;
+		size_t contentHits = 0u;
+		size_t misses = 0u;
+		size_t freed = 0u;
+	};
+public:
+	//  ,      TextureData::Load.
+	//      -,    
+	static std::shared_ptr<const TextureView> Acquire(Graphics& gfx, const std::string& path, TextureRole role = TextureRole::Diffuse);
+	//     :      
+	static std::shared_ptr<const TextureView> Acquire(Graphics& gfx, const std::string& path, const TextureData& data);
+	//   .  ..   :  Windows      
+	static std::string GetCanonicalPath(const std::string& path);
+	static Stats GetStats() noexcept;
+private:
+	static TextureManager& Get();
+	std::shared_ptr<const TextureView> AcquireImpl(Graphics& gfx, const std::string& path, TextureRole role, const TextureData* pData);
+	static std::shared_ptr<TextureView> Create(Graphics& gfx, const std::string& path, const TextureData& data);
+	void Release(const TextureView& view) noexcept;
+	//   ,   mtx
+	void PurgeLocked();
+private:
+	std::mutex mtx;
+	std::unordered_map<std::string, std::weak_ptr<const TextureView>> byPath;
+	std::unordered_map<std::string, std::weak_ptr<const TextureView>> byContent;
+	Stats stats;
+};
\ No newline at end of file
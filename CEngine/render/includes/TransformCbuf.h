@@ -4,10 +4,11 @@
 #pragma once
 #include "ConstantBuffers.h"
 #include "Drawable.h"
+#include "TransformRing.h"
 #include <DirectXMath.h>
 
 
-	class TransformCbuf : public Bindable
+	class TransformCbuf : public CloningBindable
 	{
 	protected:
 		struct Transforms
@@ -19,10 +20,15 @@
 		TransformCbuf(Graphics& gfx, UINT slot = 0u);
 		void Bind(Graphics& gfx)  noexcept override;
 		void InitializeParentReference(const Drawable& parent) noexcept override;
+		std::unique_ptr<CloningBindable> Clone() const noexcept override;
+		//           .
+		//,    ,      ,  
+		static UINT WriteFrame(Graphics& gfx, const DirectX::XMFLOAT4X4* const* ppModels, UINT count) noexcept;
 	protected:
 		void UpdateBindImpl(Graphics& gfx, const Transforms& tf);
 		Transforms GetTransforms(Graphics& gfx);
 	private:
 		static std::unique_ptr<VertexConstantBuffer<Transforms>> pVcbuf;
+		static std::unique_ptr<TransformRing> pRing;
 		const Drawable* pParent = nullptr;
 	};
\ No newline at end of file
@@ -0,0 +1,24 @@
+//  modelView  modelViewProj      .
+//   ,        
+
+#pragma once
+#include <DirectXMath.h>
+#include <cstddef>
+
+
+	class TransformPacker
+	{
+	public:
+		//  ,    cbuffer CBuf  PhongVS
+		struct Transforms
+		{
+			DirectX::XMFLOAT4X4A modelView;
+			DirectX::XMFLOAT4X4A modelViewProj;
+		};
+		//   .     D3D11.1   16  (256 )
+		static constexpr size_t Stride = 256u;
+		static constexpr unsigned int ConstantsPerEntry = static_cast<unsigned int>(Stride / 16u);
+		// count     pDst   Stride. pDst   16 
+		static void Pack(const DirectX::XMFLOAT4X4* const* ppModels, size_t count,
+			DirectX::FXMMATRIX view, DirectX::CXMMATRIX proj, void* pDst) noexcept;
+	};
\ No newline at end of file
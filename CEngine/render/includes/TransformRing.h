@@ -0,0 +1,33 @@
+//        (Bindable).
+//   Map  ,          
+
+#pragma once
+#include "Bindable.h"
+#include "TransformPacker.h"
+#include <wrl.h>
+
+
+	class TransformRing : public Bindable
+	{
+	public:
+		TransformRing(Graphics& gfx, UINT slot = 0u, UINT capacity = 4096u);
+		// D3D11.1  ,  TransformCbuf      
+		bool IsSupported() const noexcept;
+		//  count      
+		UINT Write(Graphics& gfx, const DirectX::XMFLOAT4X4* const* ppModels, UINT count) noexcept;
+		//,    
+		bool Contains(UINT entry) const noexcept;
+		// ,     Graphics::SetTransformSlot
+		void Bind(Graphics& gfx) noexcept override;
+	private:
+		void Create(Graphics& gfx, UINT capacity_in);
+	private:
+		UINT slot;
+		UINT capacity = 0u;
+		UINT cursor = 0u;
+		UINT frameFirst = 0u;
+		UINT frameCount = 0u;
+		bool supported = false;
+		bool noOverwrite = false;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pRingBuffer;
+	};
\ No newline at end of file
@@ -29,7 +29,13 @@
 		}
 		VertexBuffer(Graphics& gfx, const CubeR::VertexBuffer& vbuf)
 			:
-			stride((UINT)vbuf.GetLayout().Size())
+			VertexBuffer(gfx, vbuf.GetLayout(), vbuf.GetData(), vbuf.Size())
+		{}
+		//     layout ,      
+		VertexBuffer(Graphics& gfx, const CubeR::VertexLayout& layout, const char* pData, size_t vertexCount)
+			:
+			stride((UINT)layout.Size()),
+			layout(layout)
 		{
 
 			D3D11_BUFFER_DESC bd = {};
@@ -37,14 +43,33 @@
 			bd.Usage = D3D11_USAGE_DEFAULT;
 			bd.CPUAccessFlags = 0u;
 			bd.MiscFlags = 0u;
-			bd.ByteWidth = UINT(vbuf.SizeBytes());
+			bd.ByteWidth = UINT(stride * vertexCount);
 			bd.StructureByteStride = stride;
 			D3D11_SUBRESOURCE_DATA sd = {};
-			sd.pSysMem = vbuf.GetData();
+			sd.pSysMem = pData;
 			GetDevice(gfx)->CreateBuffer(&bd, &sd, &pVertexBuffer);
 		}
+		//   (,     )   BindableCodex,       
+		VertexBuffer(Graphics& gfx, const std::string& tag, const CubeR::VertexBuffer& vbuf)
+			:
+			VertexBuffer(gfx, vbuf)
+		{
+			this->tag = tag;
+		}
+		VertexBuffer(Graphics& gfx, const std::string& tag, const CubeR::VertexLayout& layout, const char* pData, size_t vertexCount)
+			:
+			VertexBuffer(gfx, layout, pData, vertexCount)
+		{
+			this->tag = tag;
+		}
 		void Bind(Graphics& gfx)  noexcept  override;
+		static std::shared_ptr<VertexBuffer> Resolve(Graphics& gfx, const std::string& tag, const CubeR::VertexBuffer& vbuf);
+		static std::shared_ptr<VertexBuffer> Resolve(Graphics& gfx, const std::string& tag, const CubeR::VertexLayout& layout, const char* pData, size_t vertexCount);
+		static std::string GenerateUID(const std::string& tag, const CubeR::VertexBuffer& vbuf);
+		static std::string GenerateUID(const std::string& tag, const CubeR::VertexLayout& layout, const char* pData, size_t vertexCount);
+		std::string GetUID() const noexcept override;
 	protected:
+		std::string tag;
 		UINT stride;
 		Microsoft::WRL::ComPtr<ID3D11Buffer> pVertexBuffer;
 		CubeR::VertexLayout layout;
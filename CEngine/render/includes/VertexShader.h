@@ -11,7 +11,11 @@
 		VertexShader(Graphics& gfx, const std::wstring& path);
 		void Bind(Graphics& gfx)  noexcept override;
 		ID3DBlob* GetBytecode() const;
+		static std::shared_ptr<VertexShader> Resolve(Graphics& gfx, const std::wstring& path);
+		static std::string GenerateUID(const std::wstring& path);
+		std::string GetUID() const noexcept override;
 	protected:
+		std::wstring path;
 		Microsoft::WRL::ComPtr<ID3DBlob> pBytecodeBlob;
 		Microsoft::WRL::ComPtr<ID3D11VertexShader> pVertexShader;
 	};
@@ -0,0 +1,48 @@
+//    CPU-  :     .
+//  COM,        WIC
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class WorkerPool
+{
+public:
+	explicit WorkerPool(size_t threadCount);
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+	~WorkerPool();
+	// :    ,  ,        ParallelFor
+	static WorkerPool& Get();
+	//   .      future
+	template<typename F>
+	auto Submit(F&& f) -> std::future<decltype(f())>
+	{
+		using Result = decltype(f());
+		auto pTask = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+		auto future = pTask->get_future();
+		Enqueue([pTask]() { (*pTask)(); });
+		return future;
+	}
+	// f(i)   i  [0, count)       .
+	//     ,    .
+	//    :          
+	void ParallelFor(size_t count, const std::function<void(size_t)>& f);
+	size_t GetThreadCount() const noexcept;
+private:
+	void Enqueue(std::function<void()> task);
+	void WorkerLoop();
+private:
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::deque<std::function<void()>> tasks;
+	std::vector<std::thread> threads;
+	bool stopping = false;
+};
\ No newline at end of file
@@ -0,0 +1,82 @@
+#define CLUSTER_GRID_X 16
+#define CLUSTER_GRID_Y 9
+#define CLUSTER_GRID_Z 24
+
+struct PointLight
+{
+    float3 lightPos;
+    float range;
+    float3 diffuseColor;
+    float diffuseIntensity;
+    float attConst;
+    float attLin;
+    float attQuad;
+    float padding;
+};
+
+cbuffer ClusterCBuf : register(b0)
+{
+    float3 ambient;
+    float zScale;
+    float2 viewportOrigin;
+    float2 tileScale;
+    float zBias;
+};
+
+#define ALL_LIGHTS 0xFFFFFFFF
+
+cbuffer ObjectLightCBuf : register(b3)
+{
+    uint objectLightCount;
+    uint3 objectLightPadding;
+    uint4 objectLights[2];
+};
+
+StructuredBuffer<PointLight> pointLights : register(t4);
+StructuredBuffer<uint2> clusterRanges : register(t5);
+StructuredBuffer<uint> clusterLightIndices : register(t6);
+
+uint2 GetClusterRange(float4 screenPos, float viewZ)
+{
+    const uint2 tile = min(uint2(max(screenPos.xy - viewportOrigin, 0.0f) * tileScale), uint2(CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1));
+    const uint slice = (uint) clamp(floor(log(max(viewZ, 0.0001f)) * zScale + zBias), 0.0f, CLUSTER_GRID_Z - 1.0f);
+    return clusterRanges[(slice * CLUSTER_GRID_Y + tile.y) * CLUSTER_GRID_X + tile.x];
+}
+
+struct LightList
+{
+    uint offset;
+    uint count;
+    bool perObject;
+};
+
+LightList GetLightList(float4 screenPos, float viewZ)
+{
+    LightList list;
+    if (objectLightCount != ALL_LIGHTS)
+    {
+        list.offset = 0;
+        list.count = objectLightCount;
+        list.perObject = true;
+    }
+    else
+    {
+        const uint2 cluster = GetClusterRange(screenPos, viewZ);
+        list.offset = cluster.x;
+        list.count = cluster.y;
+        list.perObject = false;
+    }
+    return list;
+}
+
+uint GetLightIndex(LightList list, uint i)
+{
+    return list.perObject ? objectLights[i >> 2][i & 3] : clusterLightIndices[list.offset + i];
+}
+
+float Attenuate(PointLight light, float distToL)
+{
+    const float att = 1.0f / (light.attConst + light.attLin * distToL + light.attQuad * (distToL * distToL));
+    const float fade = saturate(1.0f - pow(distToL / light.range, 4.0f));
+    return att * fade * fade;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "VertexCompression.hlsli"
+
+cbuffer CBuf
+{
+    matrix view;
+    matrix proj;
+};
+
+struct VSOut
+{
+    float3 viewPos : Position;
+    float3 normal : Normal;
+    float4 pos : SV_Position;
+};
+
+VSOut main(float3 pos : Position, float2 n : Normal, float4x4 world : InstanceTransform)
+{
+    const float3 normal = DecodeNormal(n);
+    const matrix modelView = mul(world, view);
+    const matrix modelViewProj = mul(modelView, proj);
+    VSOut vso;
+    vso.viewPos = (float3) mul(float4(pos, 1.0f), modelView);
+    vso.normal = mul(normal, (float3x3) modelView);
+    vso.pos = mul(float4(pos, 1.0f), modelViewProj);
+    return vso;
+}
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include "VertexCompression.hlsli"
+
 cbuffer CBuf
 {
     matrix modelView;
@@ -11,11 +13,12 @@ struct VSOut
     float4 pos : SV_Position;
 };
 
-VSOut main(float3 pos : Position, float3 n : Normal)
+VSOut main(float3 pos : Position, float2 n : Normal)
 {
+    const float3 normal = DecodeNormal(n);
     VSOut vso;
     vso.viewPos = (float3) mul(float4(pos, 1.0f), modelView);
-    vso.normal = mul(n, (float3x3) modelView);
+    vso.normal = mul(normal, (float3x3) modelView);
     vso.pos = mul(float4(pos, 1.0f), modelViewProj);
     return vso;
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "VertexCompression.hlsli"
+
+cbuffer CBuf
+{
+    matrix view;
+    matrix proj;
+};
+
+struct VSOut
+{
+    float3 viewPos : Position;
+    float3 normal : Normal;
+    float3 tan : Tangent;
+    float3 bitan : Bitangent;
+    float2 texc : TexCoord;
+    float4 pos : SV_Position;
+};
+
+VSOut main(float3 pos : Position, float2 n : Normal, float4 tan : Tangent, float2 texc : TexCoord, float4x4 world : InstanceTransform)
+{
+    const float3 normal = DecodeNormal(n);
+    const float3 tangent = DecodeTangent(tan);
+    const float3 bitangent = DecodeBitangent(normal, tangent, tan);
+    const matrix modelView = mul(world, view);
+    const matrix modelViewProj = mul(modelView, proj);
+    VSOut vso;
+    vso.viewPos = (float3) mul(float4(pos, 1.0f), modelView);
+    vso.normal = mul(normal, (float3x3) modelView);
+    vso.tan = mul(tangent, (float3x3) modelView);
+    vso.bitan = mul(bitangent, (float3x3) modelView);
+    vso.pos = mul(float4(pos, 1.0f), modelViewProj);
+    vso.texc = texc;
+    return vso;
+}
\ No newline at end of file
@@ -1,21 +1,6 @@
-struct LightCBuf
-{
-    float3 lightPos;
-    float3 ambient;
-    float3 diffuseColor;
-    float diffuseIntensity;
-    float attConst;
-    float attLin;
-    float attQuad;
-};
-
-#define NR_POINT_LIGHTS 32
-cbuffer PLightCbuf
-{
-    LightCBuf pLights[NR_POINT_LIGHTS];
-};
+#include "LightClusters.hlsli"
 
-cbuffer ObjectCBuf
+cbuffer ObjectCBuf : register(b1)
 {
     float specularIntensity;
     float specularPower;
@@ -23,7 +8,7 @@ cbuffer ObjectCBuf
     float padding[1];
 };
 
-cbuffer TransformCBuf
+cbuffer TransformCBuf : register(b2)
 {
     matrix modelView;
     matrix modelViewProj;
@@ -34,20 +19,13 @@ Texture2D nmap : register(t2);
 
 SamplerState splr;
 
-float3 CalcPointLight(LightCBuf light, float3 viewPos, float3 n, float2 texc)
+float3 CalcPointLight(PointLight light, float3 viewPos, float3 n, float3 albedo)
 {
-    if (normalMapEnabled)
-    {
-        const float3 normalSample = nmap.Sample(splr, texc).xyz;
-        const float3 objectNormal = normalSample * 2.0f - 1.0f;
-        n = normalize(mul(objectNormal, (float3x3) modelView));
-    }
-    
     const float3 vToL = light.lightPos - viewPos;
     const float distToL = length(vToL);
     const float3 dirToL = vToL / distToL;
     
-    const float att = 1.0f / (light.attConst + light.attLin * distToL + light.attQuad * (distToL * distToL));
+    const float att = Attenuate(light, distToL);
 
     const float3 diffuse = light.diffuseColor * light.diffuseIntensity * att * max(0.0f, dot(dirToL, n));
     
@@ -55,19 +33,25 @@ float3 CalcPointLight(LightCBuf light, float3 viewPos, float3 n, float2 texc)
     const float3 r = w * 2.0f - vToL;
     const float3 specular = att * (light.diffuseColor * light.diffuseIntensity) * specularIntensity * pow(max(0.0f, dot(normalize(-r), normalize(viewPos))), specularPower);
     
-    return float3(saturate((diffuse + light.ambient) * tex.Sample(splr, texc).rgb + specular));
+    return diffuse * albedo + specular;
 }
 
-float4 main(float3 viewPos : Position, float3 n : Normal, float2 texc : TexCoord) : SV_Target
+float4 main(float3 viewPos : Position, float3 n : Normal, float2 texc : TexCoord, float4 pos : SV_Position) : SV_Target
 {
-    float3 result = 0;
-    for (int i = 0; i < NR_POINT_LIGHTS; ++i)
+    if (normalMapEnabled)
+    {
+        const float3 normalSample = nmap.Sample(splr, texc).xyz;
+        const float3 objectNormal = normalSample * 2.0f - 1.0f;
+        n = normalize(mul(objectNormal, (float3x3) modelView));
+    }
+    const float3 albedo = tex.Sample(splr, texc).rgb;
+
+    float3 result = ambient * albedo;
+    const LightList lights = GetLightList(pos, viewPos.z);
+    for (uint i = 0; i < lights.count; ++i)
     {
-        if (pLights[i].diffuseIntensity != 0.0f || (pLights[i].ambient.r != 0.0f || pLights[i].ambient.g != 0.0f || pLights[i].ambient.b != 0.0f))
-        {
-            result += CalcPointLight(pLights[i], viewPos, n, texc);
-        }
+        result += CalcPointLight(pointLights[GetLightIndex(lights, i)], viewPos, n, albedo);
     }
     
-    return float4(result, 1.0f);
+    return float4(saturate(result), 1.0f);
 }
\ No newline at end of file
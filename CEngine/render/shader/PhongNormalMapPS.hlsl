@@ -1,21 +1,6 @@
-struct LightCBuf
-{
-    float3 lightPos;
-    float3 ambient;
-    float3 diffuseColor;
-    float diffuseIntensity;
-    float attConst;
-    float attLin;
-    float attQuad;
-};
+#include "LightClusters.hlsli"
 
-#define NR_POINT_LIGHTS 32
-cbuffer PLightCbuf
-{
-    LightCBuf pLights[NR_POINT_LIGHTS];
-};
-
-cbuffer ObjectCBuf
+cbuffer ObjectCBuf : register(b1)
 {
     float specularIntensity;
     float specularPower;
@@ -29,27 +14,13 @@ Texture2D nmap : register(t2);
 
 SamplerState splr;
 
-float4 CalcPointLight(LightCBuf light, float3 viewPos, float3 n, float3 tan, float3 bitan, float2 texc)
+float3 CalcPointLight(PointLight light, float3 viewPos, float3 n, float3 albedo)
 {
-    float4 dtex = tex.Sample(splr, texc);
-    clip(dtex.a < 0.1f ? -1 : 1);
-    n = normalize(n);
-    if(normalMapEnabled)
-    {
-        const float3x3 tanToView = float3x3(
-            normalize(tan),
-            normalize(bitan),
-            normalize(n)
-        );
-        const float3 normalSample = nmap.Sample(splr, texc).xyz;
-        float3 tanNormal = normalSample * 2.0f - 1.0f;
-        n = normalize(mul(tanNormal, tanToView));
-    }
     const float3 vToL = light.lightPos - viewPos;
     const float distToL = length(vToL);
     const float3 dirToL = vToL / distToL;
     
-    const float att = 1.0f / (light.attConst + light.attLin * distToL + light.attQuad * (distToL * distToL));
+    const float att = Attenuate(light, distToL);
 
     const float3 diffuse = light.diffuseColor * light.diffuseIntensity * att * max(0.0f, dot(dirToL, n));
     
@@ -57,19 +28,34 @@ float4 CalcPointLight(LightCBuf light, float3 viewPos, float3 n, float3 tan, flo
     const float3 r = w * 2.0f - vToL;
     const float3 specular = att * (light.diffuseColor * light.diffuseIntensity) * specularIntensity * pow(max(0.0f, dot(normalize(-r), normalize(viewPos))), specularPower);
     
-    return float4(saturate((diffuse + light.ambient) * dtex.rgb + specular), dtex.a);
+    return diffuse * albedo + specular;
 }
 
-float4 main(float3 viewPos : Position, float3 n : Normal, float3 tan : Tangent, float3 bitan : Bitangent, float2 texc : TexCoord) : SV_Target
+float4 main(float3 viewPos : Position, float3 n : Normal, float3 tan : Tangent, float3 bitan : Bitangent, float2 texc : TexCoord, float4 pos : SV_Position) : SV_Target
 {
-    float4 result = 0;
-    for (int i = 0; i < NR_POINT_LIGHTS; ++i)
+    const float4 dtex = tex.Sample(splr, texc);
+    clip(dtex.a < 0.1f ? -1 : 1);
+    n = normalize(n);
+    if(normalMapEnabled)
+    {
+        const float3x3 tanToView = float3x3(
+            normalize(tan),
+            normalize(bitan),
+            normalize(n)
+        );
+        const float2 normalSample = nmap.Sample(splr, texc).xy;
+        float3 tanNormal;
+        tanNormal.xy = normalSample * 2.0f - 1.0f;
+        tanNormal.z = sqrt(saturate(1.0f - dot(tanNormal.xy, tanNormal.xy)));
+        n = normalize(mul(tanNormal, tanToView));
+    }
+
+    float3 result = ambient * dtex.rgb;
+    const LightList lights = GetLightList(pos, viewPos.z);
+    for (uint i = 0; i < lights.count; ++i)
     {
-        if (pLights[i].diffuseIntensity != 0.0f || (pLights[i].ambient.r != 0.0f || pLights[i].ambient.g != 0.0f || pLights[i].ambient.b != 0.0f))
-        {
-            result += CalcPointLight(pLights[i], viewPos, n, tan, bitan, texc);
-        }
+        result += CalcPointLight(pointLights[GetLightIndex(lights, i)], viewPos, n, dtex.rgb);
     }
     
-    return result;
+    return float4(saturate(result), dtex.a);
 }
\ No newline at end of file
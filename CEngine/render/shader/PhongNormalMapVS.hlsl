@@ -1,3 +1,5 @@
+#include "VertexCompression.hlsli"
+
 cbuffer CBuf
 {
     matrix modelView;
@@ -14,13 +16,16 @@ struct VSOut
     float4 pos : SV_Position;
 };
 
-VSOut main(float3 pos : Position, float3 n : Normal, float3 tan : Tangent, float3 bitan : Bitangent, float2 texc : TexCoord)
+VSOut main(float3 pos : Position, float2 n : Normal, float4 tan : Tangent, float2 texc : TexCoord)
 {
+    const float3 normal = DecodeNormal(n);
+    const float3 tangent = DecodeTangent(tan);
+    const float3 bitangent = DecodeBitangent(normal, tangent, tan);
     VSOut vso;
     vso.viewPos = (float3) mul(float4(pos, 1.0f), modelView);
-    vso.normal = mul(n, (float3x3) modelView);
-    vso.tan = mul(tan, (float3x3) modelView);
-    vso.bitan = mul(bitan, (float3x3) modelView);
+    vso.normal = mul(normal, (float3x3) modelView);
+    vso.tan = mul(tangent, (float3x3) modelView);
+    vso.bitan = mul(bitangent, (float3x3) modelView);
     vso.pos = mul(float4(pos, 1.0f), modelViewProj);
     vso.texc = texc;
     return vso;
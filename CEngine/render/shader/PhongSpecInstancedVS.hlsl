@@ -0,0 +1,28 @@
+#include "VertexCompression.hlsli"
+
+cbuffer CBuf
+{
+    matrix view;
+    matrix proj;
+};
+
+struct VSOut
+{
+    float3 viewPos : Position;
+    float3 normal : Normal;
+    float2 texc : TexCoord;
+    float4 pos : SV_Position;
+};
+
+VSOut main(float3 pos : Position, float2 n : Normal, float2 texc : TexCoord, float4x4 world : InstanceTransform)
+{
+    const float3 normal = DecodeNormal(n);
+    const matrix modelView = mul(world, view);
+    const matrix modelViewProj = mul(modelView, proj);
+    VSOut vso;
+    vso.viewPos = (float3) mul(float4(pos, 1.0f), modelView);
+    vso.normal = mul(normal, (float3x3) modelView);
+    vso.pos = mul(float4(pos, 1.0f), modelViewProj);
+    vso.texc = texc;
+    return vso;
+}
\ No newline at end of file
@@ -1,21 +1,6 @@
-struct LightCBuf
-{
-    float3 lightPos;
-    float3 ambient;
-    float3 diffuseColor;
-    float diffuseIntensity;
-    float attConst;
-    float attLin;
-    float attQuad;
-};
-
-#define NR_POINT_LIGHTS 32
-cbuffer PLightCbuf
-{
-    LightCBuf pLights[NR_POINT_LIGHTS];
-};
+#include "LightClusters.hlsli"
 
-cbuffer ObjectCBuf
+cbuffer ObjectCBuf : register(b1)
 {
     bool normalMapEnabled;
     bool specularMapEnabled;
@@ -30,9 +15,26 @@ Texture2D spec;
 Texture2D nmap;
 SamplerState splr;
 
-float4 CalcPointLight(LightCBuf light, float3 viewPos, float3 n, float3 tan, float3 bitan, float2 texc)
+float3 CalcPointLight(PointLight light, float3 viewPos, float3 n, float3 albedo, float3 specularReflectionColor, float specularPower)
+{
+    const float3 vToL = light.lightPos - viewPos;
+    const float distToL = length(vToL);
+    const float3 dirToL = vToL / distToL;
+    
+    const float att = Attenuate(light, distToL);
+
+    const float3 diffuse = light.diffuseColor * light.diffuseIntensity * att * max(0.0f, dot(dirToL, n));
+    
+    const float3 w = n * dot(vToL, n);
+    const float3 r = normalize(w * 2.0f - vToL);
+    const float3 specular = att * (light.diffuseColor * light.diffuseIntensity) * pow(max(0.0f, dot(normalize(-r), normalize(viewPos))), specularPower);
+    
+    return diffuse * albedo + specular * specularReflectionColor;
+}
+
+float4 main(float3 viewPos : Position, float3 n : Normal, float3 tan : Tangent, float3 bitan : Bitangent, float2 texc : TexCoord, float4 pos : SV_Position) : SV_Target
 {
-    float4 dtex = tex.Sample(splr, texc);
+    const float4 dtex = tex.Sample(splr, texc);
     clip(dtex.a < 0.1f ? -1 : 1);
     n = normalize(n);
     if (normalMapEnabled)
@@ -42,20 +44,12 @@ float4 CalcPointLight(LightCBuf light, float3 viewPos, float3 n, float3 tan, flo
             normalize(bitan),
             normalize(n)
         );
-        const float3 normalSample = nmap.Sample(splr, texc).xyz;
-        float3 tanNormal = normalSample * 2.0f - 1.0f;
+        const float2 normalSample = nmap.Sample(splr, texc).xy;
+        float3 tanNormal;
+        tanNormal.xy = normalSample * 2.0f - 1.0f;
+        tanNormal.z = sqrt(saturate(1.0f - dot(tanNormal.xy, tanNormal.xy)));
         n = normalize(mul(tanNormal, tanToView));
     }
-    const float3 vToL = light.lightPos - viewPos;
-    const float distToL = length(vToL);
-    const float3 dirToL = vToL / distToL;
-    
-    const float att = 1.0f / (light.attConst + light.attLin * distToL + light.attQuad * (distToL * distToL));
-
-    const float3 diffuse = light.diffuseColor * light.diffuseIntensity * att * max(0.0f, dot(dirToL, n));
-    
-    const float3 w = n * dot(vToL, n);
-    const float3 r = normalize(w * 2.0f - vToL);
     float3 specularReflectionColor;
     float specularPower = specularPowerConst;
     if (specularMapEnabled)
@@ -71,21 +65,13 @@ float4 CalcPointLight(LightCBuf light, float3 viewPos, float3 n, float3 tan, flo
     {
         specularReflectionColor = specularColor;
     }
-    const float3 specular = att * (light.diffuseColor * light.diffuseIntensity) * pow(max(0.0f, dot(normalize(-r), normalize(viewPos))), specularPower);
-    
-    return float4(saturate((diffuse + light.ambient) * dtex.rgb + specular * specularReflectionColor), dtex.a);
-}
 
-float4 main(float3 viewPos : Position, float3 n : Normal, float3 tan : Tangent, float3 bitan : Bitangent, float2 texc : TexCoord) : SV_Target
-{
-    float4 result = 0;
-    for (int i = 0; i < NR_POINT_LIGHTS; ++i)
+    float3 result = ambient * dtex.rgb;
+    const LightList lights = GetLightList(pos, viewPos.z);
+    for (uint i = 0; i < lights.count; ++i)
     {
-        if (pLights[i].diffuseIntensity != 0.0f || (pLights[i].ambient.r != 0.0f || pLights[i].ambient.g != 0.0f || pLights[i].ambient.b != 0.0f))
-        {
-            result += CalcPointLight(pLights[i], viewPos, n, tan, bitan, texc);
-        }
+        result += CalcPointLight(pointLights[GetLightIndex(lights, i)], viewPos, n, dtex.rgb, specularReflectionColor, specularPower);
     }
     
-    return result;
+    return float4(saturate(result), dtex.a);
 }
\ No newline at end of file
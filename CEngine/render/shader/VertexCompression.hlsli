@@ -0,0 +1,17 @@
+float3 DecodeNormal(float2 e)
+{
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    const float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+float3 DecodeTangent(float4 frame)
+{
+    return normalize(frame.xyz * 2.0f - 1.0f);
+}
+
+float3 DecodeBitangent(float3 normal, float3 tangent, float4 frame)
+{
+    return cross(normal, tangent) * (frame.w > 0.5f ? 1.0f : -1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "../includes/AssetCache.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+
+namespace
+{
+	//  8       MurmurHash64.   ,
+	//      
+	uint64_t HashBytes(const void* pData, size_t size, uint64_t seed) noexcept
+	{
+		constexpr uint64_t m = 0xc6a4a7935bd1e995ull;
+		constexpr int r = 47;
+		uint64_t h = seed ^ (size * m);
+		const auto p = static_cast<const unsigned char*>(pData);
+		const size_t blocks = size / 8u;
+		for (size_t i = 0u; i < blocks; ++i)
+		{
+			uint64_t k;
+			std::memcpy(&k, p + i * 8u, sizeof(k));
+			k *= m;
+			k ^= k >> r;
+			k *= m;
+			h ^= k;
+			h *= m;
+		}
+		const auto tail = p + blocks * 8u;
+		const size_t rest = size & 7u;
+		if (rest != 0u)
+		{
+			uint64_t k = 0u;
+			std::memcpy(&k, tail, rest);
+			h ^= k;
+			h *= m;
+		}
+		h ^= h >> r;
+		h *= m;
+		h ^= h >> r;
+		return h;
+	}
+
+	std::string ToHex(uint64_t value)
+	{
+		constexpr char digits[] = "0123456789abcdef";
+		std::string s(16u, '0');
+		for (size_t i = 0u; i < 16u; ++i)
+		{
+			s[15u - i] = digits[value & 0xFu];
+			value >>= 4u;
+		}
+		return s;
+	}
+}
+
+
+std::string AssetCache::MakeKey(const std::filesystem::path& sourcePath, const std::string& settings)
+{
+	MappedFile source;
+	if (!source.Open(sourcePath))
+	{
+		return {};
+	}
+	const auto fullSettings = settings + ";engine=" + std::to_string(EngineVersion);
+	const uint64_t settingsHash = HashBytes(fullSettings.data(), fullSettings.size(), 0u);
+	const uint64_t contentHash = HashBytes(source.GetData(), source.GetSize(), settingsHash);
+	return ToHex(contentHash) + ToHex(settingsHash);
+}
+
+bool AssetCache::HashFile(const std::filesystem::path& path, uint64_t& hash)
+{
+	MappedFile file;
+	if (file.Open(path))
+	{
+		hash = HashBytes(file.GetData(), file.GetSize(), 0u);
+		return true;
+	}
+	//     ,     
+	std::error_code ec;
+	if (std::filesystem::is_regular_file(path, ec) && std::filesystem::file_size(path, ec) == 0u && !ec)
+	{
+		hash = HashBytes(nullptr, 0u, 0u);
+		return true;
+	}
+	return false;
+}
+
+std::string AssetCache::ExtendKey(const std::string& key, const std::vector<uint64_t>& dependencyHashes)
+{
+	if (key.empty() || dependencyHashes.empty())
+	{
+		return key;
+	}
+	return key + ToHex(HashBytes(dependencyHashes.data(), dependencyHashes.size() * sizeof(uint64_t), 0u));
+}
+
+bool AssetCache::Open(const std::string& key, const std::string& extension, MappedFile& file)
+{
+	auto& cache = Get();
+	std::lock_guard<std::mutex> lock(cache.mtx);
+	cache.ScanLocked();
+	const auto name = key + extension;
+	const auto i = cache.entries.find(name);
+	if (i == cache.entries.end())
+	{
+		++cache.stats.misses;
+		return false;
+	}
+	//        
+	std::error_code ec;
+	i->second.lastUse = std::filesystem::file_time_type::clock::now();
+	std::filesystem::last_write_time(cache.directory / name, i->second.lastUse, ec);
+	if (!file.Open(cache.directory / name))
+	{
+		//    
+		cache.stats.size -= i->second.size;
+		cache.entries.erase(i);
+		++cache.stats.misses;
+		return false;
+	}
+	++cache.stats.hits;
+	cache.stats.bytesRead += file.GetSize();
+	return true;
+}
+
+void AssetCache::Store(const std::string& key, const std::string& extension, const void* pData, size_t size)
+{
+	auto& cache = Get();
+	std::lock_guard<std::mutex> lock(cache.mtx);
+	cache.ScanLocked();
+	std::error_code ec;
+	std::filesystem::create_directories(cache.directory, ec);
+	const auto name = key + extension;
+	const auto path = cache.directory / name;
+	auto tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		out.write(static_cast<const char*>(pData), static_cast<std::streamsize>(size));
+		if (!out)
+		{
+			out.close();
+			std::filesystem::remove(tempPath, ec);
+			return;
+		}
+	}
+	std::filesystem::rename(tempPath, path, ec);
+	if (ec)
+	{
+		std::filesystem::remove(tempPath, ec);
+		return;
+	}
+	auto& entry = cache.entries[name];
+	cache.stats.size += size - entry.size;
+	entry.size = size;
+	entry.lastUse = std::filesystem::file_time_type::clock::now();
+	++cache.stats.writes;
+	cache.stats.bytesWritten += size;
+	cache.EvictLocked(name);
+}
+
+void AssetCache::SetDirectory(const std::filesystem::path& directory)
+{
+	auto& cache = Get();
+	std::lock_guard<std::mutex> lock(cache.mtx);
+	cache.directory = directory;
+	cache.scanned = false;
+}
+
+void AssetCache::SetSizeLimit(uint64_t bytes)
+{
+	auto& cache = Get();
+	std::lock_guard<std::mutex> lock(cache.mtx);
+	cache.sizeLimit = bytes;
+	cache.ScanLocked();
+	cache.EvictLocked({});
+}
+
+uint64_t AssetCache::GetSizeLimit()
+{
+	auto& cache = Get();
+	std::lock_guard<std::mutex> lock(cache.mtx);
+	return cache.sizeLimit;
+}
+
+AssetCache::Stats AssetCache::GetStats()
+{
+	auto& cache = Get();
+	std::lock_guard<std::mutex> lock(cache.mtx);
+	cache.ScanLocked();
+	auto stats = cache.stats;
+	stats.entries = cache.entries.size();
+	return stats;
+}
+
+void AssetCache::Clear()
+{
+	auto& cache = Get();
+	std::lock_guard<std::mutex> lock(cache.mtx);
+	cache.ScanLocked();
+	for (auto i = cache.entries.begin(); i != cache.entries.end();)
+	{
+		std::error_code ec;
+		if (std::filesystem::remove(cache.directory / i->first, ec))
+		{
+			cache.stats.size -= i->second.size;
+			++cache.stats.evictions;
+			i = cache.entries.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+AssetCache& AssetCache::Get()
+{
+	static AssetCache cache;
+	return cache;
+}
+
+void AssetCache::ScanLocked()
+{
+	if (scanned)
+	{
+		return;
+	}
+	scanned = true;
+	entries.clear();
+	stats.size = 0u;
+	std::error_code ec;
+	for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+	{
+		if (!it->is_regular_file(ec) || it->path().extension() == ".tmp")
+		{
+			continue;
+		}
+		Entry entry;
+		entry.size = it->file_size(ec);
+		entry.lastUse = it->last_write_time(ec);
+		stats.size += entry.size;
+		entries[it->path().filename().string()] = entry;
+	}
+}
+
+void AssetCache::EvictLocked(const std::string& keep)
+{
+	if (stats.size <= sizeLimit)
+	{
+		return;
+	}
+	std::vector<std::pair<std::filesystem::file_time_type, std::string>> order;
+	order.reserve(entries.size());
+	for (const auto& e : entries)
+	{
+		if (e.first != keep)
+		{
+			order.emplace_back(e.second.lastUse, e.first);
+		}
+	}
+	std::sort(order.begin(), order.end());
+	for (const auto& o : order)
+	{
+		if (stats.size <= sizeLimit)
+		{
+			break;
+		}
+		//    Windows   ,     
+		std::error_code ec;
+		if (std::filesystem::remove(directory / o.second, ec))
+		{
+			const auto i = entries.find(o.second);
+			stats.size -= i->second.size;
+			entries.erase(i);
+			++stats.evictions;
+		}
+	}
+}
\ No newline at end of file
@@ -7,5 +7,17 @@ ID3D11DeviceContext* Bindable::GetContext(Graphics& gfx)
 
 ID3D11Device* Bindable::GetDevice(Graphics& gfx)
 {
+	++gfx.deviceObjectCount;
 	return gfx.pDevice.Get();
 }
+
+StateTracker& Bindable::GetState(Graphics& gfx)
+{
+	return *gfx.pStateTracker;
+}
+
+
+RenderBackend& Bindable::GetBackend(Graphics& gfx)
+{
+	return *gfx.pBackend;
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "../includes/Blender.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
 
 
@@ -30,5 +32,26 @@ Blender::Blender(Graphics& gfx, bool blending)
 
 void Blender::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->OMSetBlendState(pBlender.Get(), nullptr, 0xFFFFFFFFu);
+	GetState(gfx).SetBlendState(pBlender.Get());
+}
+
+std::shared_ptr<Blender> Blender::Resolve(Graphics& gfx, bool blending)
+{
+	return BindableCodex::Resolve<Blender>(gfx, blending);
+}
+
+std::string Blender::GenerateUID(bool blending)
+{
+	using namespace std::string_literals;
+	return typeid(Blender).name() + "#"s + (blending ? "b" : "n");
+}
+
+bool Blender::IsBlending() const noexcept
+{
+	return blending;
+}
+
+std::string Blender::GetUID() const noexcept
+{
+	return GenerateUID(blending);
 }
@@ -0,0 +1,182 @@
+#include "../includes/Bounds.h"
+#include <algorithm>
+
+namespace dx = DirectX;
+
+
+BoundingVolume BoundingVolume::FromPoints(const dx::XMFLOAT3* pPoints, size_t count, size_t stride) noexcept
+{
+	BoundingVolume bv;
+	if (count == 0u)
+	{
+		return bv;
+	}
+	const auto At = [pPoints, stride](size_t i)
+	{
+		return dx::XMLoadFloat3(reinterpret_cast<const dx::XMFLOAT3*>(reinterpret_cast<const char*>(pPoints) + i * stride));
+	};
+	dx::XMVECTOR vMin = At(0u);
+	dx::XMVECTOR vMax = vMin;
+	for (size_t i = 1u; i < count; ++i)
+	{
+		const auto p = At(i);
+		vMin = dx::XMVectorMin(vMin, p);
+		vMax = dx::XMVectorMax(vMax, p);
+	}
+	const auto center = dx::XMVectorScale(dx::XMVectorAdd(vMin, vMax), 0.5f);
+	//    AABB,    AABB   
+	dx::XMVECTOR maxDistSq = dx::XMVectorZero();
+	for (size_t i = 0u; i < count; ++i)
+	{
+		maxDistSq = dx::XMVectorMax(maxDistSq, dx::XMVector3LengthSq(dx::XMVectorSubtract(At(i), center)));
+	}
+	dx::XMStoreFloat3(&bv.center, center);
+	dx::XMStoreFloat3(&bv.extents, dx::XMVectorScale(dx::XMVectorSubtract(vMax, vMin), 0.5f));
+	bv.radius = dx::XMVectorGetX(dx::XMVectorSqrt(maxDistSq));
+	return bv;
+}
+
+BoundingVolume BoundingVolume::Merge(const BoundingVolume& a, const BoundingVolume& b) noexcept
+{
+	if (a.IsEmpty())
+	{
+		return b;
+	}
+	if (b.IsEmpty())
+	{
+		return a;
+	}
+	const auto ca = dx::XMLoadFloat3(&a.center);
+	const auto cb = dx::XMLoadFloat3(&b.center);
+	const auto ea = dx::XMLoadFloat3(&a.extents);
+	const auto eb = dx::XMLoadFloat3(&b.extents);
+	const auto vMin = dx::XMVectorMin(dx::XMVectorSubtract(ca, ea), dx::XMVectorSubtract(cb, eb));
+	const auto vMax = dx::XMVectorMax(dx::XMVectorAdd(ca, ea), dx::XMVectorAdd(cb, eb));
+	const auto center = dx::XMVectorScale(dx::XMVectorAdd(vMin, vMax), 0.5f);
+	const auto extents = dx::XMVectorScale(dx::XMVectorSubtract(vMax, vMin), 0.5f);
+
+	BoundingVolume bv;
+	dx::XMStoreFloat3(&bv.center, center);
+	dx::XMStoreFloat3(&bv.extents, extents);
+	const float ra = dx::XMVectorGetX(dx::XMVector3Length(dx::XMVectorSubtract(ca, center))) + a.radius;
+	const float rb = dx::XMVectorGetX(dx::XMVector3Length(dx::XMVectorSubtract(cb, center))) + b.radius;
+	//         AABB
+	bv.radius = std::min(std::max(ra, rb), dx::XMVectorGetX(dx::XMVector3Length(extents)));
+	return bv;
+}
+
+BoundingVolume BoundingVolume::Transform(dx::FXMMATRIX transform) const noexcept
+{
+	if (IsEmpty())
+	{
+		return *this;
+	}
+	BoundingVolume bv;
+	const auto center = dx::XMVector3Transform(dx::XMLoadFloat3(&this->center), transform);
+	const auto e = dx::XMLoadFloat3(&extents);
+	auto worldExtents = dx::XMVectorMultiply(dx::XMVectorAbs(transform.r[0]), dx::XMVectorSplatX(e));
+	worldExtents = dx::XMVectorMultiplyAdd(dx::XMVectorAbs(transform.r[1]), dx::XMVectorSplatY(e), worldExtents);
+	worldExtents = dx::XMVectorMultiplyAdd(dx::XMVectorAbs(transform.r[2]), dx::XMVectorSplatZ(e), worldExtents);
+	const auto scaleSq = dx::XMVectorMax(dx::XMVector3LengthSq(transform.r[0]),
+		dx::XMVectorMax(dx::XMVector3LengthSq(transform.r[1]), dx::XMVector3LengthSq(transform.r[2])));
+	dx::XMStoreFloat3(&bv.center, center);
+	dx::XMStoreFloat3(&bv.extents, worldExtents);
+	bv.radius = radius * dx::XMVectorGetX(dx::XMVectorSqrt(scaleSq));
+	return bv;
+}
+
+bool BoundingVolume::IntersectRay(dx::FXMVECTOR origin, dx::FXMVECTOR dir, float& tEnter, float& tExit) const noexcept
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+	const auto c = dx::XMLoadFloat3(&center);
+	const auto e = dx::XMLoadFloat3(&extents);
+	const auto invDir = dx::XMVectorReciprocal(dir);
+	const auto t1 = dx::XMVectorMultiply(dx::XMVectorSubtract(dx::XMVectorSubtract(c, e), origin), invDir);
+	const auto t2 = dx::XMVectorMultiply(dx::XMVectorSubtract(dx::XMVectorAdd(c, e), origin), invDir);
+	dx::XMFLOAT3 tMin;
+	dx::XMFLOAT3 tMax;
+	dx::XMStoreFloat3(&tMin, dx::XMVectorMin(t1, t2));
+	dx::XMStoreFloat3(&tMax, dx::XMVectorMax(t1, t2));
+	tEnter = std::max({ tMin.x, tMin.y, tMin.z });
+	tExit = std::min({ tMax.x, tMax.y, tMax.z });
+	return tEnter <= tExit && tExit >= 0.0f;
+}
+
+
+Frustum::Frustum(dx::FXMMATRIX viewProj) noexcept
+{
+	//   -  view * proj.  D3D     [0, w]
+	const auto m = dx::XMMatrixTranspose(viewProj);
+	dx::XMFLOAT4A planes[8];
+	dx::XMStoreFloat4A(&planes[0], dx::XMPlaneNormalize(dx::XMVectorAdd(m.r[3], m.r[0])));
+	dx::XMStoreFloat4A(&planes[1], dx::XMPlaneNormalize(dx::XMVectorSubtract(m.r[3], m.r[0])));
+	dx::XMStoreFloat4A(&planes[2], dx::XMPlaneNormalize(dx::XMVectorAdd(m.r[3], m.r[1])));
+	dx::XMStoreFloat4A(&planes[3], dx::XMPlaneNormalize(dx::XMVectorSubtract(m.r[3], m.r[1])));
+	dx::XMStoreFloat4A(&planes[4], dx::XMPlaneNormalize(m.r[2]));
+	dx::XMStoreFloat4A(&planes[5], dx::XMPlaneNormalize(dx::XMVectorSubtract(m.r[3], m.r[2])));
+	planes[6] = planes[0];
+	planes[7] = planes[0];
+	for (size_t g = 0u; g < 2u; ++g)
+	{
+		const auto& p0 = planes[g * 4u];
+		const auto& p1 = planes[g * 4u + 1u];
+		const auto& p2 = planes[g * 4u + 2u];
+		const auto& p3 = planes[g * 4u + 3u];
+		planeX[g] = { p0.x, p1.x, p2.x, p3.x };
+		planeY[g] = { p0.y, p1.y, p2.y, p3.y };
+		planeZ[g] = { p0.z, p1.z, p2.z, p3.z };
+		planeW[g] = { p0.w, p1.w, p2.w, p3.w };
+	}
+}
+
+Frustum::Result Frustum::Test(const BoundingVolume& worldBounds) const noexcept
+{
+	if (worldBounds.IsEmpty())
+	{
+		return Result::Outside;
+	}
+	const auto c = dx::XMLoadFloat3(&worldBounds.center);
+	const auto e = dx::XMLoadFloat3(&worldBounds.extents);
+	const auto cx = dx::XMVectorSplatX(c);
+	const auto cy = dx::XMVectorSplatY(c);
+	const auto cz = dx::XMVectorSplatZ(c);
+	const auto ex = dx::XMVectorSplatX(e);
+	const auto ey = dx::XMVectorSplatY(e);
+	const auto ez = dx::XMVectorSplatZ(e);
+	const auto radius = dx::XMVectorReplicate(worldBounds.radius);
+	const auto zero = dx::XMVectorZero();
+	bool intersects = false;
+	for (size_t g = 0u; g < 2u; ++g)
+	{
+		const auto px = dx::XMLoadFloat4A(&planeX[g]);
+		const auto py = dx::XMLoadFloat4A(&planeY[g]);
+		const auto pz = dx::XMLoadFloat4A(&planeZ[g]);
+		const auto pw = dx::XMLoadFloat4A(&planeW[g]);
+		//     
+		auto dist = dx::XMVectorMultiplyAdd(px, cx, pw);
+		dist = dx::XMVectorMultiplyAdd(py, cy, dist);
+		dist = dx::XMVectorMultiplyAdd(pz, cz, dist);
+		// AABB  .     AABB  ,   
+		auto r = dx::XMVectorMultiply(dx::XMVectorAbs(px), ex);
+		r = dx::XMVectorMultiplyAdd(dx::XMVectorAbs(py), ey, r);
+		r = dx::XMVectorMultiplyAdd(dx::XMVectorAbs(pz), ez, r);
+		r = dx::XMVectorMin(r, radius);
+		if (dx::XMComparisonAnyTrue(dx::XMVector4GreaterR(zero, dx::XMVectorAdd(dist, r))))
+		{
+			return Result::Outside;
+		}
+		if (dx::XMComparisonAnyTrue(dx::XMVector4GreaterR(zero, dx::XMVectorSubtract(dist, r))))
+		{
+			intersects = true;
+		}
+	}
+	return intersects ? Result::Intersects : Result::Inside;
+}
+
+Frustum::Result Frustum::Test(const BoundingVolume& bounds, dx::FXMMATRIX transform) const noexcept
+{
+	return Test(bounds.Transform(transform));
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "../includes/D3D11Backend.h"
+
+
+D3D11Backend::D3D11Backend(ID3D11DeviceContext* pContext) noexcept
+	:
+	pContext(pContext)
+{
+	pContext->QueryInterface(__uuidof(ID3D11DeviceContext1), &pContext1);
+}
+
+void D3D11Backend::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept
+{
+	pContext->IASetPrimitiveTopology(topology);
+}
+
+void D3D11Backend::SetInputLayout(ID3D11InputLayout* pLayout) noexcept
+{
+	pContext->IASetInputLayout(pLayout);
+}
+
+void D3D11Backend::SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept
+{
+	pContext->IASetIndexBuffer(pBuffer, format, offset);
+}
+
+void D3D11Backend::SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept
+{
+	pContext->IASetVertexBuffers(slot, 1u, &pBuffer, &stride, &offset);
+}
+
+void D3D11Backend::SetVertexShader(ID3D11VertexShader* pShader) noexcept
+{
+	pContext->VSSetShader(pShader, nullptr, 0u);
+}
+
+void D3D11Backend::SetPixelShader(ID3D11PixelShader* pShader) noexcept
+{
+	pContext->PSSetShader(pShader, nullptr, 0u);
+}
+
+void D3D11Backend::SetVSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+	pContext->VSSetConstantBuffers(slot, 1u, &pBuffer);
+}
+
+void D3D11Backend::SetVSConstantBufferRange(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept
+{
+	pContext1->VSSetConstantBuffers1(slot, 1u, &pBuffer, &firstConstant, &numConstants);
+}
+
+void D3D11Backend::SetPSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+	pContext->PSSetConstantBuffers(slot, 1u, &pBuffer);
+}
+
+void D3D11Backend::SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept
+{
+	pContext->PSSetShaderResources(slot, 1u, &pView);
+}
+
+void D3D11Backend::SetPSSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept
+{
+	pContext->PSSetSamplers(slot, 1u, &pSampler);
+}
+
+void D3D11Backend::SetBlendState(ID3D11BlendState* pState) noexcept
+{
+	pContext->OMSetBlendState(pState, nullptr, 0xFFFFFFFFu);
+}
+
+void D3D11Backend::SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept
+{
+	pContext->OMSetDepthStencilState(pState, stencilRef);
+}
+
+void D3D11Backend::SetRasterizerState(ID3D11RasterizerState* pState) noexcept
+{
+	pContext->RSSetState(pState);
+}
+
+bool D3D11Backend::SupportsConstantBufferOffsets() const noexcept
+{
+	return pContext1 != nullptr;
+}
+
+void* D3D11Backend::Map(ID3D11Buffer* pBuffer, D3D11_MAP type, size_t, size_t) noexcept
+{
+	D3D11_MAPPED_SUBRESOURCE msr;
+	if (FAILED(pContext->Map(pBuffer, 0u, type, 0u, &msr)))
+	{
+		return nullptr;
+	}
+	return msr.pData;
+}
+
+void D3D11Backend::Unmap(ID3D11Buffer* pBuffer) noexcept
+{
+	pContext->Unmap(pBuffer, 0u);
+}
+
+void D3D11Backend::UpdateSubresource(ID3D11Resource* pResource, const void* pData, UINT rowPitch, size_t) noexcept
+{
+	pContext->UpdateSubresource(pResource, 0u, nullptr, pData, rowPitch, 0u);
+}
+
+void D3D11Backend::GenerateMips(ID3D11ShaderResourceView* pView) noexcept
+{
+	pContext->GenerateMips(pView);
+}
+
+void D3D11Backend::DrawIndexed(UINT count, UINT startIndex, INT baseVertex) noexcept
+{
+	pContext->DrawIndexed(count, startIndex, baseVertex);
+}
+
+void D3D11Backend::DrawIndexedInstanced(UINT count, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) noexcept
+{
+	pContext->DrawIndexedInstanced(count, instanceCount, startIndex, baseVertex, startInstance);
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "../includes/DepthStencil.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
 
 DepthStencil::DepthStencil(Graphics& gfx, Mode mode) : mode(mode)
@@ -32,5 +34,21 @@ DepthStencil::DepthStencil(Graphics& gfx, Mode mode) : mode(mode)
 
 void DepthStencil::Bind(Graphics& gfx)  noexcept
 {
-	GetContext(gfx)->OMSetDepthStencilState(pDss.Get(), 0xFF);
+	GetState(gfx).SetDepthStencilState(pDss.Get(), 0xFF);
+}
+
+std::shared_ptr<DepthStencil> DepthStencil::Resolve(Graphics& gfx, Mode mode)
+{
+	return BindableCodex::Resolve<DepthStencil>(gfx, mode);
+}
+
+std::string DepthStencil::GenerateUID(Mode mode)
+{
+	using namespace std::string_literals;
+	return typeid(DepthStencil).name() + "#"s + std::to_string(static_cast<int>(mode));
+}
+
+std::string DepthStencil::GetUID() const noexcept
+{
+	return GenerateUID(mode);
 }
\ No newline at end of file
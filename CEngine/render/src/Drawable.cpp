@@ -2,15 +2,18 @@
 #include "../includes/IndexBuffer.h"
 #include "../includes/BindableBase.h"
 #include "../includes/Material.h"
+#include "../includes/FrameCommander.h"
 #include <cassert>
 #include <typeinfo>
+#include <functional>
 
 
-Drawable::Drawable(Graphics& gfx, const Material& mat, const aiMesh& mesh) noexcept
+Drawable::Drawable(Graphics& gfx, const Material& mat, const MeshAsset& mesh, size_t meshIndex) noexcept
 {
-	pVertices = mat.MakeVertexBindable(gfx, mesh);
-	pIndices = mat.MakeIndexBindable(gfx, mesh);
-	pTopology = std::make_unique<Topology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pVertices = mat.MakeVertexBindable(gfx, mesh, meshIndex);
+	pIndices = mat.MakeIndexBindable(gfx, mesh, meshIndex);
+	lodIndices = mat.MakeLodIndexBindables(gfx, mesh, meshIndex);
+	pTopology = Topology::Resolve(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	for (auto& t : mat.GetTechniques())
 	{
@@ -20,9 +23,15 @@ Drawable::Drawable(Graphics& gfx, const Material& mat, const aiMesh& mesh) noexc
 
 void Drawable::Submit(FrameCommander& frame) const noexcept
 {
+	Submit(frame, GetTransformXM());
+}
+
+void Drawable::Submit(FrameCommander& frame, DirectX::FXMMATRIX transform, size_t lod, const ObjectLightList* pLights) const noexcept
+{
+	const auto pTransform = frame.AllocateTransform(transform);
 	for (const auto& tech : techniques)
 	{
-		tech.Submit(frame, *this);
+		tech.Submit(frame, *this, pTransform, lod, pLights);
 	}
 }
 
@@ -32,16 +41,32 @@ void Drawable::AddTechnique(Technique tech_in) noexcept
 	techniques.push_back(std::move(tech_in));
 }
 
-void Drawable::Bind(Graphics& gfx) const noexcept
+void Drawable::Bind(Graphics& gfx, size_t lod) const noexcept
 {
 	pTopology->Bind(gfx);
-	pIndices->Bind(gfx);
+	(lod == 0u ? pIndices : lodIndices[lod - 1u])->Bind(gfx);
 	pVertices->Bind(gfx);
 }
 
-UINT Drawable::GetIndexCount() const noexcept
+UINT Drawable::GetIndexCount(size_t lod) const noexcept
+{
+	return (lod == 0u ? pIndices : lodIndices[lod - 1u])->GetCount();
+}
+
+size_t Drawable::GetLodCount() const noexcept
+{
+	return lodIndices.size() + 1u;
+}
+
+bool Drawable::IsSameGeometry(const Drawable& other) const noexcept
+{
+	return pVertices == other.pVertices && pIndices == other.pIndices && pTopology == other.pTopology;
+}
+
+uint32_t Drawable::GetGeometryId(size_t lod) const noexcept
 {
-	return pIndices->GetCount();
+	const auto& pLodIndices = lod == 0u ? pIndices : lodIndices[lod - 1u];
+	return static_cast<uint32_t>(std::hash<const void*>{}(pLodIndices.get()));
 }
 
 Drawable::~Drawable()
@@ -0,0 +1,86 @@
+#include "../includes/FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+	size_t AlignUp(size_t value, size_t alignment) noexcept
+	{
+		return (value + alignment - 1u) & ~(alignment - 1u);
+	}
+}
+
+FrameArena::FrameArena(size_t capacity, size_t frameCount)
+	:
+	buffers(std::max<size_t>(frameCount, 1u))
+{
+	for (auto& b : buffers)
+	{
+		b.pData = std::make_unique<std::byte[]>(capacity);
+		b.capacity = capacity;
+	}
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) noexcept
+{
+	auto& b = Current();
+	const auto base = reinterpret_cast<uintptr_t>(b.pData.get());
+	const auto offset = AlignUp(base + b.offset, alignment) - base;
+	if (offset + size <= b.capacity)
+	{
+		b.offset = offset + size;
+		return b.pData.get() + offset;
+	}
+	b.overflow.push_back(std::make_unique<std::byte[]>(size + alignment));
+	b.overflowBytes += size;
+	const auto p = reinterpret_cast<uintptr_t>(b.overflow.back().get());
+	return reinterpret_cast<void*>(AlignUp(p, alignment));
+}
+
+void FrameArena::NextFrame() noexcept
+{
+	lastFrameUsage = GetUsed();
+	peak = std::max(peak, lastFrameUsage);
+
+	current = (current + 1u) % buffers.size();
+	auto& b = Current();
+	b.offset = 0u;
+	b.overflowBytes = 0u;
+	b.overflow.clear();
+	if (b.capacity < peak)
+	{
+		b.capacity = peak + peak / 2u;
+		b.pData = std::make_unique<std::byte[]>(b.capacity);
+	}
+}
+
+size_t FrameArena::GetUsed() const noexcept
+{
+	const auto& b = Current();
+	return b.offset + b.overflowBytes;
+}
+
+size_t FrameArena::GetLastFrameUsage() const noexcept
+{
+	return lastFrameUsage;
+}
+
+size_t FrameArena::GetPeak() const noexcept
+{
+	return peak;
+}
+
+size_t FrameArena::GetCapacity() const noexcept
+{
+	return Current().capacity;
+}
+
+FrameArena::Buffer& FrameArena::Current() noexcept
+{
+	return buffers[current];
+}
+
+const FrameArena::Buffer& FrameArena::Current() const noexcept
+{
+	return buffers[current];
+}
\ No newline at end of file
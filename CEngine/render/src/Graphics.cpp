@@ -4,8 +4,9 @@
 #include <DirectXMath.h>
 #include <dxgi.h>
 #include <math.h>
-#include <WICTextureLoader.h>
 #include "../includes/Graphics.h"
+#include "../includes/D3D11Backend.h"
+#include "../includes/TextureManager.h"
 #include "../core/includes/Log.h"
 #include "imgui_impl_dx11.h"
 #include "imgui_impl_win32.h"
@@ -43,6 +44,8 @@ Graphics::Graphics(HWND hwnd, int width, int height)
 
 	//    
 	GFX_THROW_FAILED(D3D11CreateDeviceAndSwapChain(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, D3D11_CREATE_DEVICE_BGRA_SUPPORT, nullptr, 0, D3D11_SDK_VERSION, &sd, &pSwap, &pDevice, nullptr, &pContext));
+	pBackend = std::make_unique<D3D11Backend>(pContext.Get());
+	pStateTracker = std::make_unique<StateTracker>(*pBackend);
 
 	//   
 	wrl::ComPtr<ID3D11Resource> pBackBuffer;
@@ -78,6 +81,25 @@ Graphics::Graphics(HWND hwnd, int width, int height)
 	
 }
 
+// WARP         .
+//,    ImGui ,       
+Graphics::Graphics(std::unique_ptr<RenderBackend> pBackend_in, int width, int height)
+	:
+	headless(true),
+	imguiEnabled(false),
+	pBackend(std::move(pBackend_in))
+{
+	HRESULT hResult;
+	GFX_THROW_FAILED(D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, D3D11_CREATE_DEVICE_BGRA_SUPPORT, nullptr, 0, D3D11_SDK_VERSION, &pDevice, nullptr, &pContext));
+	pStateTracker = std::make_unique<StateTracker>(*pBackend);
+	projection = dx::XMMatrixPerspectiveLH(1.0f, float(height) / float(width), 0.5f, 400.0f);
+	camera = dx::XMMatrixIdentity();
+	viewport.Width = float(width);
+	viewport.Height = float(height);
+	viewport.MaxDepth = 1.0f;
+	CUBE_CORE_INFO("Headless D3D was initialized.");
+}
+
 
 //     
 void Graphics::ClearBuffer(float red, float green, float blue)
@@ -89,19 +111,34 @@ void Graphics::ClearBuffer(float red, float green, float blue)
 		ImGui::NewFrame();
 	}
 	//    
-	const float color[] = { red, green, blue, 1.0f };
-	pContext->OMSetRenderTargets(1u, pTarget.GetAddressOf(), pDSV.Get());
-	pContext->ClearRenderTargetView(pTarget.Get(), color);
-	pContext->ClearDepthStencilView(pDSV.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0u);
+	if (!headless)
+	{
+		const float color[] = { red, green, blue, 1.0f };
+		pContext->OMSetRenderTargets(1u, pTarget.GetAddressOf(), pDSV.Get());
+		pContext->ClearRenderTargetView(pTarget.Get(), color);
+		pContext->ClearDepthStencilView(pDSV.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0u);
+	}
+
+	//ImGui    ,      
+	pStateTracker->Invalidate();
+	pStateTracker->ResetStats();
+	drawCallCount = 0u;
 }
 
 Graphics::~Graphics()
 {
-	ImGui_ImplDX11_Shutdown();
+	if (!headless)
+	{
+		ImGui_ImplDX11_Shutdown();
+	}
 }
 
 void Graphics::EndFrame()
 {
+	if (headless)
+	{
+		return;
+	}
 	if (imguiEnabled)
 	{
 		HRESULT hResult;
@@ -188,7 +225,15 @@ void Graphics::Resize(UINT width, UINT height) noexcept
 //   
 void Graphics::DrawIndexed(UINT count)
 {
-	pContext->DrawIndexed( count, 0u, 0u);
+	pBackend->DrawIndexed(count, 0u, 0);
+	++drawCallCount;
+}
+
+//    ,      
+void Graphics::DrawIndexedInstanced(UINT count, UINT instanceCount, UINT startInstance)
+{
+	pBackend->DrawIndexedInstanced(count, instanceCount, 0u, 0, startInstance);
+	++drawCallCount;
 }
 
 void Graphics::SetProjection(DirectX::FXMMATRIX proj) 
@@ -272,11 +317,63 @@ void Graphics::DrawGrid(DirectX::XMFLOAT3 camPos) noexcept
 	}
 
 	m_batch->End();
+	pStateTracker->Invalidate();
+}
+
+void Graphics::DrawBoxes(const std::vector<BoundingVolume>& boxes) noexcept
+{
+	if (boxes.empty())
+	{
+		return;
+	}
+	DirectX::CommonStates states(pDevice.Get());
+	DirectX::BasicEffect effect(pDevice.Get());
+	effect.SetVertexColorEnabled(true);
+	Microsoft::WRL::ComPtr<ID3D11InputLayout> pInputLayout;
+	CreateInputLayoutFromEffect<DirectX::VertexPositionColor>(pDevice.Get(), &effect, pInputLayout.ReleaseAndGetAddressOf());
+	DirectX::PrimitiveBatch<DirectX::VertexPositionColor> batch(pContext.Get());
+
+	pContext->OMSetBlendState(states.Opaque(), nullptr, 0xFFFFFFFF);
+	pContext->OMSetDepthStencilState(states.DepthRead(), 0);
+	pContext->RSSetState(states.CullNone());
+	effect.SetView(GetCamera());
+	effect.SetProjection(GetProjection());
+	effect.Apply(pContext.Get());
+	pContext->IASetInputLayout(pInputLayout.Get());
+
+	//  ,    :  0 - x,  1 - y,  2 - z
+	constexpr int edges[12][2] = {
+		{ 0,1 },{ 2,3 },{ 4,5 },{ 6,7 },
+		{ 0,2 },{ 1,3 },{ 4,6 },{ 5,7 },
+		{ 0,4 },{ 1,5 },{ 2,6 },{ 3,7 } };
+	batch.Begin();
+	for (const auto& b : boxes)
+	{
+		if (b.IsEmpty())
+		{
+			continue;
+		}
+		DirectX::VertexPositionColor corners[8];
+		for (int i = 0; i < 8; ++i)
+		{
+			const DirectX::XMFLOAT3 pos = {
+				b.center.x + ((i & 1) ? b.extents.x : -b.extents.x),
+				b.center.y + ((i & 2) ? b.extents.y : -b.extents.y),
+				b.center.z + ((i & 4) ? b.extents.z : -b.extents.z) };
+			corners[i] = DirectX::VertexPositionColor(DirectX::XMLoadFloat3(&pos), DirectX::Colors::Orange);
+		}
+		for (const auto& e : edges)
+		{
+			batch.DrawLine(corners[e[0]], corners[e[1]]);
+		}
+	}
+	batch.End();
+	pStateTracker->Invalidate();
 }
 
 void Graphics::EnableImgui() noexcept
 {
-	imguiEnabled = true;
+	imguiEnabled = !headless;
 }
 
 void Graphics::DisableImgui() noexcept
@@ -289,9 +386,9 @@ void Graphics::SetCamera(DirectX::FXMMATRIX cam) noexcept
 	camera = cam;
 }
 
-void Graphics::SetTexture(ID3D11ShaderResourceView** tv, const wchar_t* file)
+std::shared_ptr<const TextureView> Graphics::LoadTexture(const std::string& file)
 {
-	DirectX::CreateWICTextureFromFile(pDevice.Get(), pContext.Get(), file, nullptr, tv);
+	return TextureManager::Acquire(*this, file);
 }
 
 bool Graphics::IsImguiEnabled() const noexcept
@@ -322,6 +419,61 @@ int Graphics::getMonitorFrequency() const noexcept
 }
 
 
+const StateTracker::Stats& Graphics::GetBindStats() const noexcept
+{
+	return pStateTracker->GetStats();
+}
+
+void Graphics::SetModelTransform(DirectX::FXMMATRIX transform) noexcept
+{
+	model = transform;
+}
+
+DirectX::XMMATRIX Graphics::GetModelTransform() const noexcept
+{
+	return model;
+}
+
+void Graphics::SetTransformSlot(UINT slot) noexcept
+{
+	transformSlot = slot;
+}
+
+UINT Graphics::GetTransformSlot() const noexcept
+{
+	return transformSlot;
+}
+
+void Graphics::SetObjectLights(const ObjectLightList* pLights) noexcept
+{
+	pObjectLights = pLights;
+}
+
+const ObjectLightList* Graphics::GetObjectLights() const noexcept
+{
+	return pObjectLights;
+}
+
+size_t Graphics::GetDeviceObjectCount() const noexcept
+{
+	return deviceObjectCount;
+}
+
+size_t Graphics::GetDrawCallCount() const noexcept
+{
+	return drawCallCount;
+}
+
+RenderBackend& Graphics::GetBackend() noexcept
+{
+	return *pBackend;
+}
+
+bool Graphics::IsHeadless() const noexcept
+{
+	return headless;
+}
+
 DirectX::XMMATRIX Graphics::GetCamera() const noexcept
 {
 	return camera;
@@ -348,15 +500,19 @@ void Graphics::CleanupRenderTarget() noexcept
 void Graphics::CreateViewport(float x, float y, float topx, float topy) noexcept
 {
 
-	D3D11_VIEWPORT vp;
-	vp.Width = x;
-	vp.Height = y;
-	vp.MinDepth = 0.0f;
-	vp.MaxDepth = 1.0f;
-	vp.TopLeftX = topx - ImGui::GetMainViewport()->Pos.x;
-	vp.TopLeftY = topy - ImGui::GetMainViewport()->Pos.y;
-	pContext->RSSetViewports(1u, &vp);
+	viewport.Width = x;
+	viewport.Height = y;
+	viewport.MinDepth = 0.0f;
+	viewport.MaxDepth = 1.0f;
+	viewport.TopLeftX = topx - ImGui::GetMainViewport()->Pos.x;
+	viewport.TopLeftY = topy - ImGui::GetMainViewport()->Pos.y;
+	pContext->RSSetViewports(1u, &viewport);
+
+}
 
+const D3D11_VIEWPORT& Graphics::GetViewport() const noexcept
+{
+	return viewport;
 }
 
 
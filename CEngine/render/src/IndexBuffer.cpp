@@ -1,9 +1,11 @@
 #include "../includes/IndexBuffer.h"
 
 
-IndexBuffer::IndexBuffer(Graphics& gfx, const std::vector<unsigned short>& indices) noexcept
+IndexBuffer::IndexBuffer(Graphics& gfx, std::string tag, const void* pIndices, size_t indexCount, size_t indexSize, DXGI_FORMAT format) noexcept
 	:
-	count((UINT)indices.size())
+	tag(std::move(tag)),
+	count((UINT)indexCount),
+	format(format)
 {
 
 	D3D11_BUFFER_DESC ibd = {};
@@ -11,19 +13,36 @@ IndexBuffer::IndexBuffer(Graphics& gfx, const std::vector<unsigned short>& indic
 	ibd.Usage = D3D11_USAGE_DEFAULT;
 	ibd.CPUAccessFlags = 0u;
 	ibd.MiscFlags = 0u;
-	ibd.ByteWidth = UINT(count * sizeof(unsigned short));
-	ibd.StructureByteStride = sizeof(unsigned short);
+	ibd.ByteWidth = UINT(count * indexSize);
+	ibd.StructureByteStride = UINT(indexSize);
 	D3D11_SUBRESOURCE_DATA isd = {};
-	isd.pSysMem = indices.data();
+	isd.pSysMem = pIndices;
 	GetDevice(gfx)->CreateBuffer(&ibd, &isd, &pIndexBuffer);
 }
 
 void IndexBuffer::Bind(Graphics& gfx)  noexcept
 {
-	GetContext(gfx)->IASetIndexBuffer(pIndexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0u);
+	GetState(gfx).SetIndexBuffer(pIndexBuffer.Get(), format, 0u);
 }
 
 UINT IndexBuffer::GetCount() const 
 {
 	return count;
+}
+
+DXGI_FORMAT IndexBuffer::GetFormat() const noexcept
+{
+	return format;
+}
+
+std::string IndexBuffer::GenerateUID(const std::string& tag)
+{
+	using namespace std::string_literals;
+	return typeid(IndexBuffer).name() + "#"s + tag;
+}
+
+std::string IndexBuffer::GetUID() const noexcept
+{
+	using namespace std::string_literals;
+	return tag.empty() ? std::string{} : typeid(IndexBuffer).name() + "#"s + tag;
 }
\ No newline at end of file
@@ -1,8 +1,20 @@
 #include "../includes/InputLayout.h"
+#include "../includes/VertexShader.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
-InputLayout::InputLayout(Graphics& gfx, CubeR::VertexLayout layout_in,ID3DBlob* pVertexShaderBytecode) : layout(std::move(layout_in))
+InputLayout::InputLayout(Graphics& gfx, CubeR::VertexLayout layout_in, const VertexShader& vs, bool instanced) : layout(std::move(layout_in)), vertexShaderUID(vs.GetUID()), instanced(instanced)
 {
-		const auto d3dLayout = layout.GetD3DLayout();
+		auto d3dLayout = layout.GetD3DLayout();
+		if (instanced)
+		{
+			for (UINT row = 0u; row < 4u; ++row)
+			{
+				d3dLayout.push_back({ "InstanceTransform", row, DXGI_FORMAT_R32G32B32A32_FLOAT, 1u,
+					row * 16u, D3D11_INPUT_PER_INSTANCE_DATA, 1u });
+			}
+		}
+		const auto pVertexShaderBytecode = vs.GetBytecode();
 
 		GetDevice(gfx)->CreateInputLayout(
 		d3dLayout.data(), (UINT)d3dLayout.size(),
@@ -19,5 +31,22 @@ const CubeR::VertexLayout InputLayout::GetLayout() const noexcept
 
 void InputLayout::Bind(Graphics& gfx)  noexcept
 {
-	GetContext(gfx)->IASetInputLayout(pInputLayout.Get());
+	GetState(gfx).SetInputLayout(pInputLayout.Get());
+}
+
+std::shared_ptr<InputLayout> InputLayout::Resolve(Graphics& gfx, const CubeR::VertexLayout& layout, const VertexShader& vs, bool instanced)
+{
+	return BindableCodex::Resolve<InputLayout>(gfx, layout, vs, instanced);
+}
+
+std::string InputLayout::GenerateUID(const CubeR::VertexLayout& layout, const VertexShader& vs, bool instanced)
+{
+	using namespace std::string_literals;
+	return typeid(InputLayout).name() + "#"s + layout.GetCode() + (instanced ? "#i#"s : "#"s) + vs.GetUID();
+}
+
+std::string InputLayout::GetUID() const noexcept
+{
+	using namespace std::string_literals;
+	return typeid(InputLayout).name() + "#"s + layout.GetCode() + (instanced ? "#i#"s : "#"s) + vertexShaderUID;
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "../includes/InstanceBuffer.h"
+
+
+InstanceBuffer::InstanceBuffer(Graphics& gfx, UINT capacity)
+	:
+	capacity(capacity),
+	cursor(capacity),
+	viewProjCbuf(gfx, 0u)
+{
+	D3D11_BUFFER_DESC bd = {};
+	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	bd.Usage = D3D11_USAGE_DYNAMIC;
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bd.MiscFlags = 0u;
+	bd.ByteWidth = UINT(sizeof(DirectX::XMFLOAT4X4) * capacity);
+	bd.StructureByteStride = sizeof(DirectX::XMFLOAT4X4);
+	GetDevice(gfx)->CreateBuffer(&bd, nullptr, &pInstanceBuffer);
+}
+
+void InstanceBuffer::BeginFrame(Graphics& gfx) noexcept
+{
+	viewProjCbuf.Update(gfx, {
+		DirectX::XMMatrixTranspose(gfx.GetCamera()),
+		DirectX::XMMatrixTranspose(gfx.GetProjection())
+	});
+}
+
+void InstanceBuffer::Bind(Graphics& gfx) noexcept
+{
+	GetState(gfx).SetVertexBuffer(1u, pInstanceBuffer.Get(), sizeof(DirectX::XMFLOAT4X4), 0u);
+	viewProjCbuf.Bind(gfx);
+}
+
+UINT InstanceBuffer::GetCapacity() const noexcept
+{
+	return capacity;
+}
+
+D3D11_MAP InstanceBuffer::Reserve(UINT count) noexcept
+{
+	if (cursor + count > capacity)
+	{
+		cursor = 0u;
+		return D3D11_MAP_WRITE_DISCARD;
+	}
+	return D3D11_MAP_WRITE_NO_OVERWRITE;
+}
\ No newline at end of file
@@ -1,17 +1,116 @@
 #include "../includes/Job.h"
 #include "../includes/Step.h"
 #include "../includes/Drawable.h"
+#include <algorithm>
+#include <cstring>
 
+namespace
+{
+	// ,     :
+	//  : (4) | 0 | (12) | (16) | (8) | (23)
+	//   : (4) | 1 |  (23) | (12) | (16) | (8)
+	//    ,         -
+	constexpr uint64_t PassBits = 4u;
+	constexpr uint64_t ProgramBits = 12u;
+	constexpr uint64_t TextureBits = 16u;
+	constexpr uint64_t GeometryBits = 8u;
+	constexpr uint64_t DepthBits = 23u;
+
+	constexpr uint64_t Mask(uint64_t bits) noexcept
+	{
+		return (uint64_t(1) << bits) - 1u;
+	}
+
+	//  float   ,   ,
+	//          
+	uint32_t QuantizeDepth(float viewZ) noexcept
+	{
+		const float z = std::max(viewZ, 0.0f);
+		uint32_t bits;
+		std::memcpy(&bits, &z, sizeof(bits));
+		return bits >> (32u - DepthBits - 1u);
+	}
+}
 
-Job::Job(const Step* pStep, const Drawable* pDrawable)
+Job::Job(const Step* pStep, const Drawable* pDrawable, const DirectX::XMFLOAT4X4* pTransform, size_t lod, const ObjectLightList* pLights)
 	:
 	pDrawable{ pDrawable },
-	pStep{ pStep }
+	pStep{ pStep },
+	pTransform{ pTransform },
+	pLights{ pLights },
+	lod{ uint32_t(lod) }
 {}
 
 void Job::Execute(Graphics& gfx) const noexcept
 {
-	pDrawable->Bind(gfx);
+	gfx.SetModelTransform(DirectX::XMLoadFloat4x4(pTransform));
+	gfx.SetTransformSlot(transformSlot);
+	gfx.SetObjectLights(pLights);
+	pDrawable->Bind(gfx, lod);
 	pStep->Bind(gfx);
-	gfx.DrawIndexed(pDrawable->GetIndexCount());
+	gfx.DrawIndexed(pDrawable->GetIndexCount(lod));
+}
+
+void Job::UpdateSortKey(DirectX::FXMMATRIX view) noexcept
+{
+	namespace dx = DirectX;
+	const auto viewPos = dx::XMVector3Transform(dx::XMVectorZero(), dx::XMLoadFloat4x4(pTransform) * view);
+	const uint64_t depth = QuantizeDepth(dx::XMVectorGetZ(viewPos)) & Mask(DepthBits);
+	const uint64_t pass = pStep->GetTargetPass() & Mask(PassBits);
+	const uint64_t program = pStep->GetProgramId() & Mask(ProgramBits);
+	const uint64_t textures = pStep->GetTextureSetId() & Mask(TextureBits);
+	const uint64_t geometry = pDrawable->GetGeometryId(lod) & Mask(GeometryBits);
+
+	uint64_t key = pass << (64u - PassBits);
+	if (pStep->IsBlended())
+	{
+		key |= uint64_t(1) << (63u - PassBits);
+		key |= (Mask(DepthBits) - depth) << (ProgramBits + TextureBits + GeometryBits);
+		key |= program << (TextureBits + GeometryBits);
+		key |= textures << GeometryBits;
+		key |= geometry;
+	}
+	else
+	{
+		key |= program << (TextureBits + GeometryBits + DepthBits);
+		key |= textures << (GeometryBits + DepthBits);
+		key |= geometry << DepthBits;
+		key |= depth;
+	}
+	sortKey = key;
+}
+
+uint64_t Job::GetSortKey() const noexcept
+{
+	return sortKey;
+}
+
+const Drawable& Job::GetDrawable() const noexcept
+{
+	return *pDrawable;
+}
+
+const Step& Job::GetStep() const noexcept
+{
+	return *pStep;
+}
+
+const DirectX::XMFLOAT4X4& Job::GetTransform() const noexcept
+{
+	return *pTransform;
+}
+
+size_t Job::GetLod() const noexcept
+{
+	return lod;
+}
+
+const ObjectLightList* Job::GetLights() const noexcept
+{
+	return pLights;
+}
+
+void Job::SetTransformSlot(uint32_t slot) noexcept
+{
+	transformSlot = slot;
 }
\ No newline at end of file
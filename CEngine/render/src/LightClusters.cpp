@@ -0,0 +1,134 @@
+#include "../includes/LightClusters.h"
+#include <algorithm>
+#include <cmath>
+
+
+void LightClusters::Build(const float* x, const float* y, const float* z, const float* radii, size_t count, const DirectX::XMFLOAT4X4& proj)
+{
+	//  LH  _33 = f / (f - n), _43 = -n * f / (f - n)
+	nearZ = -proj._43 / proj._33;
+	farZ = proj._33 * nearZ / (proj._33 - 1.0f);
+	const float logRatio = std::log(farZ / nearZ);
+	zScale = float(GridZ) / logRatio;
+	zBias = -float(GridZ) * std::log(nearZ) / logRatio;
+
+	lightBounds.clear();
+	for (size_t i = 0u; i < count; ++i)
+	{
+		const DirectX::XMFLOAT3 c = { x[i], y[i], z[i] };
+		const float r = radii[i];
+		const float zMin = c.z - r;
+		const float zMax = c.z + r;
+		if (r <= 0.0f || zMax <= nearZ || zMin >= farZ)
+		{
+			continue;
+		}
+		Bounds b = { 0u, GridX - 1u, 0u, GridY - 1u, Slice(zMin), Slice(zMax), static_cast<uint32_t>(i) };
+		//,   ,     
+		if (zMin > nearZ)
+		{
+			//  x / z           
+			const float xLo = c.x - r, xHi = c.x + r;
+			const float yLo = c.y - r, yHi = c.y + r;
+			const float ndcX0 = proj._11 * (xLo / (xLo >= 0.0f ? zMax : zMin)) + proj._31;
+			const float ndcX1 = proj._11 * (xHi / (xHi >= 0.0f ? zMin : zMax)) + proj._31;
+			const float ndcY0 = proj._22 * (yLo / (yLo >= 0.0f ? zMax : zMin)) + proj._32;
+			const float ndcY1 = proj._22 * (yHi / (yHi >= 0.0f ? zMin : zMax)) + proj._32;
+			if (ndcX1 < -1.0f || ndcX0 > 1.0f || ndcY1 < -1.0f || ndcY0 > 1.0f)
+			{
+				continue;
+			}
+			// y   ,     NDC    
+			const auto tile = [](float t, uint32_t grid)
+			{
+				return static_cast<uint32_t>(std::clamp(t * float(grid), 0.0f, float(grid - 1u)));
+			};
+			b.x0 = tile(ndcX0 * 0.5f + 0.5f, GridX);
+			b.x1 = tile(ndcX1 * 0.5f + 0.5f, GridX);
+			b.y0 = tile(0.5f - ndcY1 * 0.5f, GridY);
+			b.y1 = tile(0.5f - ndcY0 * 0.5f, GridY);
+		}
+		lightBounds.push_back(b);
+	}
+
+	//,         
+	for (auto& range : ranges)
+	{
+		range = { 0u, 0u };
+	}
+	const auto forEachCluster = [](const Bounds& b, auto&& f)
+	{
+		for (uint32_t z = b.z0; z <= b.z1; ++z)
+		{
+			for (uint32_t y = b.y0; y <= b.y1; ++y)
+			{
+				const uint32_t row = (z * GridY + y) * GridX;
+				for (uint32_t x = b.x0; x <= b.x1; ++x)
+				{
+					f(row + x);
+				}
+			}
+		}
+	};
+	for (const auto& b : lightBounds)
+	{
+		forEachCluster(b, [this](uint32_t cluster) { ++ranges[cluster].count; });
+	}
+	uint32_t offset = 0u;
+	size_t maxPerCluster = 0u;
+	for (auto& range : ranges)
+	{
+		range.offset = offset;
+		offset += range.count;
+		maxPerCluster = std::max(maxPerCluster, size_t(range.count));
+		range.count = 0u;
+	}
+	indices.resize(offset);
+	for (const auto& b : lightBounds)
+	{
+		forEachCluster(b, [this, &b](uint32_t cluster)
+		{
+			auto& range = ranges[cluster];
+			indices[range.offset + range.count++] = b.light;
+		});
+	}
+
+	stats.lights = lightBounds.size();
+	stats.indices = indices.size();
+	stats.maxPerCluster = maxPerCluster;
+}
+
+uint32_t LightClusters::Slice(float z) const noexcept
+{
+	if (z <= nearZ)
+	{
+		return 0u;
+	}
+	const float slice = std::floor(std::log(z) * zScale + zBias);
+	return static_cast<uint32_t>(std::clamp(slice, 0.0f, float(GridZ - 1u)));
+}
+
+const std::vector<LightClusters::Range>& LightClusters::GetRanges() const noexcept
+{
+	return ranges;
+}
+
+const std::vector<uint32_t>& LightClusters::GetIndices() const noexcept
+{
+	return indices;
+}
+
+float LightClusters::GetZScale() const noexcept
+{
+	return zScale;
+}
+
+float LightClusters::GetZBias() const noexcept
+{
+	return zBias;
+}
+
+const LightClusters::Stats& LightClusters::GetStats() const noexcept
+{
+	return stats;
+}
\ No newline at end of file
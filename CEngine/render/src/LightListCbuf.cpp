@@ -0,0 +1,38 @@
+#include "../includes/LightListCbuf.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
+
+
+	LightListCbuf::LightListCbuf(Graphics& gfx, UINT slot)
+		:
+		cbuf(gfx, slot)
+	{
+	}
+
+	void LightListCbuf::Bind(Graphics& gfx) noexcept
+	{
+		const auto pList = gfx.GetObjectLights();
+		const ObjectLightList& list = pList != nullptr ? *pList : ObjectLightList{};
+		if (!valid || list != uploaded)
+		{
+			cbuf.Update(gfx, list);
+			uploaded = list;
+			valid = true;
+		}
+		cbuf.Bind(gfx);
+	}
+
+	std::shared_ptr<LightListCbuf> LightListCbuf::Resolve(Graphics& gfx)
+	{
+		return BindableCodex::Resolve<LightListCbuf>(gfx);
+	}
+
+	std::string LightListCbuf::GenerateUID()
+	{
+		return typeid(LightListCbuf).name();
+	}
+
+	std::string LightListCbuf::GetUID() const noexcept
+	{
+		return GenerateUID();
+	}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "../includes/MappedFile.h"
+#include <utility>
+
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	:
+	hFile(std::exchange(other.hFile, INVALID_HANDLE_VALUE)),
+	hMapping(std::exchange(other.hMapping, nullptr)),
+	pData(std::exchange(other.pData, nullptr)),
+	size(std::exchange(other.size, 0u))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		hFile = std::exchange(other.hFile, INVALID_HANDLE_VALUE);
+		hMapping = std::exchange(other.hMapping, nullptr);
+		pData = std::exchange(other.pData, nullptr);
+		size = std::exchange(other.size, 0u);
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::filesystem::path& path) noexcept
+{
+	Close();
+	hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+	hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+	if (hMapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+	pData = static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0u, 0u, 0u));
+	if (pData == nullptr)
+	{
+		Close();
+		return false;
+	}
+	size = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+}
+
+void MappedFile::Close() noexcept
+{
+	if (pData != nullptr)
+	{
+		UnmapViewOfFile(pData);
+		pData = nullptr;
+	}
+	if (hMapping != nullptr)
+	{
+		CloseHandle(hMapping);
+		hMapping = nullptr;
+	}
+	if (hFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(hFile);
+		hFile = INVALID_HANDLE_VALUE;
+	}
+	size = 0u;
+}
+
+bool MappedFile::IsOpen() const noexcept
+{
+	return pData != nullptr;
+}
+
+const char* MappedFile::GetData() const noexcept
+{
+	return pData;
+}
+
+size_t MappedFile::GetSize() const noexcept
+{
+	return size;
+}
\ No newline at end of file
@@ -1,17 +1,33 @@
 #include "../includes/Material.h"
+#include "../includes/ModelAsset.h"
 
 
-Material::Material(Graphics& gfx, const aiMaterial& material, const std::filesystem::path& path)
+namespace
+{
+	std::shared_ptr<IndexBuffer> ResolveIndices(Graphics& gfx, const std::string& tag, uint32_t indexSize, const MeshAsset::Indices& indices)
+	{
+		return indexSize == sizeof(uint32_t) ?
+			IndexBuffer::Resolve(gfx, tag, static_cast<const uint32_t*>(indices.pData), indices.count) :
+			IndexBuffer::Resolve(gfx, tag, static_cast<const unsigned short*>(indices.pData), indices.count);
+	}
+}
+
+Material::Material(Graphics& gfx, const ModelAsset& asset, const std::filesystem::path& path, size_t index)
 	:
-modelPath(path.string())
+vtxLayout(asset.GetMaterials()[index].MakeLayout()),
+assetKey(asset.GetKey()),
+tag(asset.GetKey() + "%mat" + std::to_string(index))
 {
 	namespace dx = DirectX;
 	using CubeR::VertexLayout;
-	std::string dir = path.parent_path().string() + "\\";
-	 
-	aiString tempName; 
-	material.Get(AI_MATKEY_NAME, tempName); 
-	name = tempName.C_Str(); 
+	const auto& material = asset.GetMaterials()[index];
+	const auto resolveTexture = [&gfx, &asset, &path](const std::string& map, unsigned int slot, TextureRole role)
+	{
+		const auto texPath = ModelAsset::GetTexturePath(path, map);
+		const auto pData = asset.GetTexture(texPath, role);
+		return pData != nullptr ? Texture::Resolve(gfx, texPath, slot, *pData) : Texture::Resolve(gfx, texPath, slot, role);
+	};
+	name = material.name;
 
 	std::wstring shaderCode = L"Phong";
 
@@ -22,54 +38,47 @@ modelPath(path.string())
 
 
 	float shine = 2.0f;
-	dx::XMFLOAT4 specularColor = { 0.18f, 0.18f, 0.18f, 1.0f };
-	dx::XMFLOAT4 diffuseColor = { 0.45f, 0.45f, 0.85f, 1.0f };
-	aiString texFileName;
+	const dx::XMFLOAT4 specularColor = material.specularColor;
+	const dx::XMFLOAT4 diffuseColor = material.diffuseColor;
 
-	vtxLayout.Append(CubeR::VertexLayout::Position3D); 
-	vtxLayout.Append(CubeR::VertexLayout::Normal);
-
-	if (material.GetTexture(aiTextureType_SPECULAR, 0, &texFileName) == aiReturn_SUCCESS)
+	if (!material.specularMap.empty())
 	{
-		auto tex = std::make_unique<Texture>(gfx, dir + texFileName.C_Str(), 1);
+		auto tex = resolveTexture(material.specularMap, 1, TextureRole::Specular);
 		hasAlphaGloss = tex->HasAlpha();
 		Phong.AddBindable(std::move(tex));
 		hasSpecMap = true;
 		shaderCode += L"Spec";
 	}
-	else
-	{
-		material.Get(AI_MATKEY_COLOR_SPECULAR, reinterpret_cast<aiColor3D&>(specularColor));
-	}
 	if (!hasAlphaGloss)
 	{
-		material.Get(AI_MATKEY_SHININESS, shine);
+		shine = material.shininess;
 	}
-	if (material.GetTexture(aiTextureType_NORMALS, 0, &texFileName) == aiReturn_SUCCESS)
+	if (!material.normalMap.empty())
 	{
-		vtxLayout.Append(CubeR::VertexLayout::Tangent); 
-		vtxLayout.Append(CubeR::VertexLayout::Bitangent); 
-		auto tex = std::make_unique<Texture>(gfx, dir + texFileName.C_Str(), 2);
+		auto tex = resolveTexture(material.normalMap, 2, TextureRole::Normal);
 		hasAlphaGloss = tex->HasAlpha();
 		Phong.AddBindable(std::move(tex));
 		hasNormalMap = true;
 		shaderCode += L"NormalMap";
 	}
-	if (material.GetTexture(aiTextureType_DIFFUSE, 0, &texFileName) == aiReturn_SUCCESS) 
+	if (!material.diffuseMap.empty()) 
 	{
-		vtxLayout.Append(CubeR::VertexLayout::Texture2D);  
-		auto tex = std::make_unique<Texture>(gfx, dir + texFileName.C_Str()); 
+		auto tex = resolveTexture(material.diffuseMap, 0, TextureRole::Diffuse); 
 		Phong.AddBindable(std::move(tex)); 
 		hasDiffuseMap = true; 
 	}
 	else
 	{
 		shaderCode = L"NoTexPhong"; 
-		material.Get(AI_MATKEY_COLOR_DIFFUSE, reinterpret_cast<aiColor3D&>(diffuseColor)); 
 	} 
 	if (hasDiffuseMap || hasNormalMap || hasSpecMap)
 	{
-		Phong.AddBindable(std::make_unique<Sampler>(gfx));
+		Phong.AddBindable(Sampler::Resolve(gfx));
+	}
+	//Gloss    ,               
+	if (hasAlphaGloss)
+	{
+		tag += "%gloss";
 	}
 	if (hasDiffuseMap && hasNormalMap && hasSpecMap)
 	{
@@ -84,7 +93,7 @@ modelPath(path.string())
 		} pmc;
 		pmc.specularPower = shine;
 		pmc.hasGlossMap = hasAlphaGloss ? TRUE : FALSE;
-		Phong.AddBindable(std::make_unique<PixelConstantBuffer<PSMaterialConstantFullmonte>>(gfx, pmc, 1u));
+		Phong.AddBindable(PixelConstantBuffer<PSMaterialConstantFullmonte>::Resolve(gfx, pmc, 1u, tag));
 	}
 
 	else if (hasDiffuseMap && !hasNormalMap && hasSpecMap)
@@ -98,7 +107,7 @@ modelPath(path.string())
 		pmc.specularConstPow = shine; 
 		pmc.hasGloss = hasAlphaGloss ? TRUE : FALSE; 
 		pmc.specularMapWeight = 1.0f; 
-		Phong.AddBindable(std::make_unique<PixelConstantBuffer<PSMaterialConstantDissSpec>>(gfx, pmc, 1u));
+		Phong.AddBindable(PixelConstantBuffer<PSMaterialConstantDissSpec>::Resolve(gfx, pmc, 1u, tag));
 	}
 
 	else if (hasDiffuseMap && hasNormalMap)
@@ -110,7 +119,7 @@ modelPath(path.string())
 			BOOL  normalMapEnabled = TRUE;
 			float padding[1];
 		} pmc;
-		Phong.AddBindable(std::make_unique<PixelConstantBuffer<PSMaterialConstantDiffnorm>>(gfx, pmc, 1u));
+		Phong.AddBindable(PixelConstantBuffer<PSMaterialConstantDiffnorm>::Resolve(gfx, pmc, 1u, tag));
 	}
 
 	else if (hasDiffuseMap)
@@ -121,7 +130,7 @@ modelPath(path.string())
 			float specularPower = 2.0f;
 			float padding[2];
 		} pmc;
-		Phong.AddBindable(std::make_unique<PixelConstantBuffer<PSMaterialConstantDiffuse>>(gfx, pmc, 1u));
+		Phong.AddBindable(PixelConstantBuffer<PSMaterialConstantDiffuse>::Resolve(gfx, pmc, 1u, tag));
 	}
 
 	else if (!hasDiffuseMap && !hasNormalMap && !hasSpecMap)
@@ -135,111 +144,49 @@ modelPath(path.string())
 		} pmc;
 		pmc.color = diffuseColor;
 		pmc.specularIntensity = (specularColor.x + specularColor.y + specularColor.z) / 3.0f;
-		Phong.AddBindable(std::make_unique<PixelConstantBuffer<PSMaterialConstantNotex>>(gfx, pmc, 1u));
+		Phong.AddBindable(PixelConstantBuffer<PSMaterialConstantNotex>::Resolve(gfx, pmc, 1u, tag));
 	}
 	else
 	{
 		throw std::runtime_error("Wrong texture combination");
 	}
-	auto pvs = std::make_unique<VertexShader>(gfx, L"shaders\\" + shaderCode + L"VS.cso");
-	auto pvsbc = pvs->GetBytecode();
+	auto pvs = VertexShader::Resolve(gfx, L"shaders\\" + shaderCode + L"VS.cso");
+	Phong.AddBindable(InputLayout::Resolve(gfx, vtxLayout, *pvs));
 	Phong.AddBindable(std::move(pvs));
-	Phong.AddBindable(std::make_unique<PixelShader>(gfx, L"shaders\\" + shaderCode + L"PS.cso"));
+	Phong.AddBindable(PixelShader::Resolve(gfx, L"shaders\\" + shaderCode + L"PS.cso"));
 	Phong.AddBindable(std::make_unique<TransformCbuf>(gfx));
-	Phong.AddBindable(std::make_unique<InputLayout>(gfx, vtxLayout, pvsbc));
+	Phong.AddBindable(LightListCbuf::Resolve(gfx));
+
+	auto pvsInstanced = VertexShader::Resolve(gfx, L"shaders\\" + shaderCode + L"InstancedVS.cso");
+	auto pLayoutInstanced = InputLayout::Resolve(gfx, vtxLayout, *pvsInstanced, true);
+	Phong.SetInstancedVariant(std::move(pvsInstanced), std::move(pLayoutInstanced));
 
 	standard.AddStep(Phong);
 	techniques.push_back(standard);
 }
 
 
-CubeR::VertexBuffer Material::ExtractVertices(const aiMesh& mesh) const noexcept
+std::shared_ptr<VertexBuffer> Material::MakeVertexBindable(Graphics& gfx, const MeshAsset& mesh, size_t meshIndex) const
 {
-	CubeR::VertexBuffer vbuf(vtxLayout); 
-	if (hasDiffuseMap && hasNormalMap && hasSpecMap)
-	{
-		for (unsigned int i = 0; i < mesh.mNumVertices; i++)
-		{
-			vbuf.EmplaceBack(
-				DirectX::XMFLOAT3(mesh.mVertices[i].x * 1.0f, mesh.mVertices[i].y * 1.0f, mesh.mVertices[i].z * 1.0f),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mNormals[i]),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mTangents[i]),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mBitangents[i]),
-				*reinterpret_cast<DirectX::XMFLOAT2*>(&mesh.mTextureCoords[0][i])
-			);
-		}
-	}
-	else if (hasDiffuseMap && !hasNormalMap && hasSpecMap)
-	{
-		for (unsigned int i = 0; i < mesh.mNumVertices; i++)
-		{
-			vbuf.EmplaceBack(
-				DirectX::XMFLOAT3(mesh.mVertices[i].x * 1.0f, mesh.mVertices[i].y * 1.0f, mesh.mVertices[i].z * 1.0f),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mNormals[i]),
-				*reinterpret_cast<DirectX::XMFLOAT2*>(&mesh.mTextureCoords[0][i])
-			);
-		}
-	}
-	else if (hasDiffuseMap && hasNormalMap)
-	{
-		for (unsigned int i = 0; i < mesh.mNumVertices; i++)
-		{
-			vbuf.EmplaceBack(
-				DirectX::XMFLOAT3(mesh.mVertices[i].x * 1.0f, mesh.mVertices[i].y * 1.0f, mesh.mVertices[i].z * 1.0f),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mNormals[i]),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mTangents[i]),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mBitangents[i]),
-				*reinterpret_cast<DirectX::XMFLOAT2*>(&mesh.mTextureCoords[0][i])
-			);
-		}
-	}
-	else if (hasDiffuseMap)
-	{
-		for (unsigned int i = 0; i < mesh.mNumVertices; i++)
-		{
-			vbuf.EmplaceBack(
-				DirectX::XMFLOAT3(mesh.mVertices[i].x * 1.0f, mesh.mVertices[i].y * 1.0f, mesh.mVertices[i].z * 1.0f),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mNormals[i]),
-				*reinterpret_cast<DirectX::XMFLOAT2*>(&mesh.mTextureCoords[0][i])
-			);
-		}
-	}
-	else if (!hasDiffuseMap && !hasNormalMap && !hasSpecMap)
-	{
-		for (unsigned int i = 0; i < mesh.mNumVertices; i++)
-		{
-			vbuf.EmplaceBack(
-				DirectX::XMFLOAT3(mesh.mVertices[i].x * 1.0f, mesh.mVertices[i].y * 1.0f, mesh.mVertices[i].z * 1.0f),
-				*reinterpret_cast<DirectX::XMFLOAT3*>(&mesh.mNormals[i])
-			);
-		}
-	}
-	return vbuf;
-}
-
-
-std::vector<unsigned short> Material::ExtractIndices(const aiMesh& mesh) const noexcept
-{
-	std::vector<unsigned short> indices;
-	indices.reserve(mesh.mNumFaces * 3);
-	for (unsigned int i = 0; i < mesh.mNumFaces; i++)
-	{
-		const auto& face = mesh.mFaces[i];
-		assert(face.mNumIndices == 3);
-		indices.push_back(face.mIndices[0]);
-		indices.push_back(face.mIndices[1]);
-		indices.push_back(face.mIndices[2]);
-	}
-	return indices;
+	assert(mesh.layout.GetCode() == vtxLayout.GetCode());
+	return VertexBuffer::Resolve(gfx, assetKey + "%mesh" + std::to_string(meshIndex), mesh.layout, mesh.pVertices, mesh.vertexCount);
 }
-std::unique_ptr<VertexBuffer> Material::MakeVertexBindable(Graphics& gfx, const aiMesh& mesh) const
+std::shared_ptr<IndexBuffer> Material::MakeIndexBindable(Graphics& gfx, const MeshAsset& mesh, size_t meshIndex) const
 {
-	return std::make_unique<VertexBuffer>(gfx, ExtractVertices(mesh));
+	return ResolveIndices(gfx, assetKey + "%mesh" + std::to_string(meshIndex), mesh.indexSize, mesh.indices);
 }
-std::unique_ptr<IndexBuffer> Material::MakeIndexBindable(Graphics& gfx, const aiMesh& mesh) const
+std::vector<std::shared_ptr<IndexBuffer>> Material::MakeLodIndexBindables(Graphics& gfx, const MeshAsset& mesh, size_t meshIndex) const
 {
-	return std::make_unique<IndexBuffer>(gfx, ExtractIndices(mesh));
+	std::vector<std::shared_ptr<IndexBuffer>> lods;
+	lods.reserve(mesh.lods.size());
+	for (size_t lod = 1u; lod <= mesh.lods.size(); ++lod)
+	{
+		const auto& indices = mesh.lods[lod - 1u];
+		lods.push_back(ResolveIndices(gfx, assetKey + "%mesh" + std::to_string(meshIndex) + "%lod" + std::to_string(lod), mesh.indexSize, indices));
+	}
+	return lods;
 }
+
 std::vector<Technique> Material::GetTechniques() const noexcept
 {
 	return techniques;
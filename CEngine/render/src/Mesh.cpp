@@ -3,8 +3,11 @@
 #include "../core/includes/CXM.h"
 #include <unordered_map>
 #include <memory>
+#include <cstring>
+#include <algorithm>
 #include <libloaderapi.h>
 #include "../includes/Material.h"
+#include "../includes/FrameCommander.h"
 
 
 std::string operator-(std::string source, const std::string& target)
@@ -15,22 +18,94 @@ std::string operator-(std::string source, const std::string& target)
 }
 
 
-Mesh::Mesh(Graphics& gfx, const Material& mat, const aiMesh& mesh) noexcept
+Mesh::Mesh(Graphics& gfx, const Material& mat, const MeshAsset& mesh, size_t meshIndex) noexcept
 	:
-Drawable(gfx, mat, mesh)
-{}
+Drawable(gfx, mat, mesh, meshIndex)
+{
+	bounds = mesh.bounds;
+}
 
 
 void Mesh::Submit(FrameCommander& frame, DirectX::FXMMATRIX accumulatedTranform) const noexcept
 {
-	DirectX::XMStoreFloat4x4(&transform, accumulatedTranform);
-	Drawable::Submit(frame);
+	size_t lod = 0u;
+	if (frame.IsLodEnabled() && GetLodCount() > 1u)
+	{
+		lod = SelectLod(frame.GetScreenSize(bounds, accumulatedTranform));
+	}
+	frame.CountTriangles(GetIndexCount() / 3u, GetIndexCount(lod) / 3u);
+	Drawable::Submit(frame, accumulatedTranform, lod, frame.AssignLights(bounds, accumulatedTranform));
+}
+
+size_t Mesh::SelectLod(float screenSize) const noexcept
+{
+	//    n:           
+	constexpr float FirstThreshold = 0.25f;
+	constexpr float Hysteresis = 0.15f;
+	const auto Threshold = [](size_t level)
+	{
+		return FirstThreshold / float(1u << (level - 1u));
+	};
+	size_t lod = std::min(currentLod, GetLodCount() - 1u);
+	while (lod + 1u < GetLodCount() && screenSize < Threshold(lod + 1u) * (1.0f - Hysteresis))
+	{
+		++lod;
+	}
+	while (lod > 0u && screenSize > Threshold(lod) * (1.0f + Hysteresis))
+	{
+		--lod;
+	}
+	currentLod = lod;
+	return lod;
 }
 
 
 DirectX::XMMATRIX Mesh::GetTransformXM() const noexcept
 {
-	return DirectX::XMLoadFloat4x4(&transform);
+	return DirectX::XMMatrixIdentity();
+}
+
+const BoundingVolume& Mesh::GetBounds() const noexcept
+{
+	return bounds;
+}
+
+void Mesh::MakeOccluder(const MeshAsset& mesh)
+{
+	pOccluder = std::make_unique<Occluder>();
+	// -   ,     
+	const size_t stride = mesh.layout.Size();
+	const bool half = mesh.layout.ResolveByIndex(0u).GetType() == CubeR::VertexLayout::Position3DHalf;
+	pOccluder->vertices.resize(mesh.vertexCount);
+	for (size_t i = 0u; i < mesh.vertexCount; ++i)
+	{
+		if (half)
+		{
+			using Map = CubeR::VertexLayout::Map<CubeR::VertexLayout::Position3DHalf>;
+			Map::SysType packed;
+			std::memcpy(&packed, mesh.pVertices + stride * i, sizeof(packed));
+			pOccluder->vertices[i] = Map::Decode(packed);
+		}
+		else
+		{
+			std::memcpy(&pOccluder->vertices[i], mesh.pVertices + stride * i, sizeof(DirectX::XMFLOAT3));
+		}
+	}
+	if (mesh.indexSize == sizeof(uint32_t))
+	{
+		const auto pIndices = static_cast<const uint32_t*>(mesh.indices.pData);
+		pOccluder->indices.assign(pIndices, pIndices + mesh.indices.count);
+	}
+	else
+	{
+		const auto pIndices = static_cast<const unsigned short*>(mesh.indices.pData);
+		pOccluder->indices.assign(pIndices, pIndices + mesh.indices.count);
+	}
+}
+
+const Occluder* Mesh::GetOccluder() const noexcept
+{
+	return pOccluder.get();
 }
 
 
@@ -45,20 +120,137 @@ id(id), meshPtrs(std::move(meshPtrs)) , name(name)
 }
 
 
-void Node::Submit(FrameCommander& frame, DirectX::FXMMATRIX accumulatedTransform) const noexcept
+void Node::Submit(FrameCommander& frame, DirectX::FXMMATRIX accumulatedTransform, bool inside) const noexcept
 {
 	const auto built =
 		DirectX::XMLoadFloat4x4(&appliedTransform) *
 		DirectX::XMLoadFloat4x4(&baseTransform) *
 		accumulatedTransform;
+	const auto pFrustum = frame.GetFrustum();
+	inside = inside || pFrustum == nullptr;
+	if (!inside)
+	{
+		const auto result = pFrustum->Test(bounds, built);
+		if (result == Frustum::Result::Outside)
+		{
+			frame.CountCulled(subtreeMeshCount);
+			return;
+		}
+		inside = result == Frustum::Result::Inside;
+	}
+	//,  ,  
+	const auto pOcclusion = frame.GetOcclusion();
+	if (pOcclusion != nullptr && !pOcclusion->IsVisible(bounds, built))
+	{
+		frame.CountCulled(subtreeMeshCount);
+		return;
+	}
+	//       ,        
+	const bool testOcclusion = pOcclusion != nullptr && (meshPtrs.size() > 1u || !childPtrs.empty());
 	for (const auto pm : meshPtrs)
 	{
-		pm->Submit(frame, built);
+		if ((inside || pFrustum->Test(pm->GetBounds(), built) != Frustum::Result::Outside) &&
+			(!testOcclusion || pOcclusion->IsVisible(pm->GetBounds(), built)))
+		{
+			pm->Submit(frame, built);
+			frame.CountVisible(1u);
+		}
+		else
+		{
+			frame.CountCulled(1u);
+		}
+	}
+	for (const auto& pc : childPtrs)
+	{
+		pc->Submit(frame, built, inside);
 	}
+}
+
+
+bool Node::UpdateBounds() noexcept
+{
+	bool changed = false;
 	for (const auto& pc : childPtrs)
 	{
-		pc->Submit(frame, built);
+		changed = pc->UpdateBounds() || changed;
+	}
+	if (changed || !boundsValid)
+	{
+		BoundingVolume merged;
+		subtreeMeshCount = meshPtrs.size();
+		for (const auto pm : meshPtrs)
+		{
+			merged = BoundingVolume::Merge(merged, pm->GetBounds());
+		}
+		for (const auto& pc : childPtrs)
+		{
+			const auto childTransform =
+				DirectX::XMLoadFloat4x4(&pc->appliedTransform) *
+				DirectX::XMLoadFloat4x4(&pc->baseTransform);
+			merged = BoundingVolume::Merge(merged, pc->bounds.Transform(childTransform));
+			subtreeMeshCount += pc->subtreeMeshCount;
+		}
+		bounds = merged;
+		boundsValid = true;
+		changed = true;
 	}
+	changed = changed || transformChanged;
+	transformChanged = false;
+	return changed;
+}
+
+
+void Node::RasterizeOccluders(OcclusionCuller& occlusion, DirectX::FXMMATRIX accumulatedTransform) const
+{
+	const auto built =
+		DirectX::XMLoadFloat4x4(&appliedTransform) *
+		DirectX::XMLoadFloat4x4(&baseTransform) *
+		accumulatedTransform;
+	for (const auto pm : meshPtrs)
+	{
+		if (const auto pOccluder = pm->GetOccluder())
+		{
+			occlusion.RasterizeOccluder(*pOccluder, built);
+		}
+	}
+	for (const auto& pc : childPtrs)
+	{
+		pc->RasterizeOccluders(occlusion, built);
+	}
+}
+
+
+bool Node::Raycast(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, DirectX::FXMMATRIX accumulatedTransform, float& distance) const noexcept
+{
+	const auto built =
+		DirectX::XMLoadFloat4x4(&appliedTransform) *
+		DirectX::XMLoadFloat4x4(&baseTransform) *
+		accumulatedTransform;
+	float tEnter;
+	float tExit;
+	//,         , 
+	if (!bounds.Transform(built).IntersectRay(origin, dir, tEnter, tExit) || tEnter > distance)
+	{
+		return false;
+	}
+	bool hit = false;
+	for (const auto pm : meshPtrs)
+	{
+		if (pm->GetBounds().Transform(built).IntersectRay(origin, dir, tEnter, tExit))
+		{
+			const float t = tEnter >= 0.0f ? tEnter : tExit;
+			if (t <= distance)
+			{
+				distance = t;
+				hit = true;
+			}
+		}
+	}
+	for (const auto& pc : childPtrs)
+	{
+		hit = pc->Raycast(origin, dir, built, distance) || hit;
+	}
+	return hit;
 }
 
 
@@ -100,7 +292,14 @@ const std::vector<std::unique_ptr<Node>>& Node::getchildPtrs() const noexcept
 
 void Node::SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept
 {
-	DirectX::XMStoreFloat4x4(&appliedTransform, transform);
+	DirectX::XMFLOAT4X4 stored;
+	DirectX::XMStoreFloat4x4(&stored, transform);
+	//     ,      
+	if (std::memcmp(&stored, &appliedTransform, sizeof(stored)) != 0)
+	{
+		appliedTransform = stored;
+		transformChanged = true;
+	}
 }
 
 void Node::SetAppliedScale(DirectX::FXMMATRIX scale) noexcept
@@ -124,54 +323,113 @@ std::string Node::GetName() const noexcept
 
 
 
-Model::Model(Graphics& gfx, const std::string& fileName, int id, std::string modelName) :
+Model::Model(const std::string& fileName, int id, std::string modelName) :
 	modelName(modelName), id(id), rootPath(fileName)
 {
-	Assimp::Importer imp;
-	const auto pScene = imp.ReadFile(fileName.c_str(),
-		aiProcess_Triangulate |
-		aiProcess_JoinIdenticalVertices |
-		aiProcess_ConvertToLeftHanded |
-		aiProcess_GenNormals |
-		aiProcess_CalcTangentSpace);
-	if (pScene == NULL)
+}
+
+Model::Model(Graphics& gfx, const std::string& fileName, int id, std::string modelName) :
+	Model(fileName, id, std::move(modelName))
+{
+	ModelAsset asset;
+	if (!asset.Load(fileName))
 	{
-		MessageBoxA(nullptr, imp.GetErrorString(), "Standart Exception", MB_OK | MB_ICONEXCLAMATION);
+		MessageBoxA(nullptr, asset.GetError().c_str(), "Standart Exception", MB_OK | MB_ICONEXCLAMATION);
 	}
 	else {
+		const auto& meshes = asset.GetMeshes();
 		std::vector<Material> materials;
-		materials.reserve(pScene->mNumMaterials);
-		for (size_t i = 0; i < pScene->mNumMaterials; ++i)
+		materials.reserve(asset.GetMaterials().size());
+		for (size_t i = 0; i < asset.GetMaterials().size(); ++i)
 		{
-			materials.emplace_back(gfx, *pScene->mMaterials[i], fileName);
+			materials.emplace_back(gfx, asset, fileName, i);
 		}
 
 
-		for (size_t i = 0; i < pScene->mNumMeshes; i++)
+		for (size_t i = 0; i < meshes.size(); i++)
 		{
-			const auto& mesh = *pScene->mMeshes[i];
-			meshPtrs.emplace_back(std::make_unique<Mesh>(gfx, materials[mesh.mMaterialIndex], mesh));
+			meshPtrs.emplace_back(std::make_unique<Mesh>(gfx, materials[meshes[i].materialIndex], meshes[i], i));
 		}
-		int nextId = 0;
-		pRoot = ParseNode(nextId, *pScene->mRootNode);
-		CUBE_TRACE(std::string("Successfully loaded model") + fileName);
+		Finish(asset);
 	}
 }
 
+void Model::Finish(const ModelAsset& asset)
+{
+	const auto& meshes = asset.GetMeshes();
+	//      : , , 
+	float largestRadius = 0.0f;
+	for (const auto& pm : meshPtrs)
+	{
+		largestRadius = std::max(largestRadius, pm->GetBounds().radius);
+	}
+	for (size_t i = 0; i < meshes.size(); i++)
+	{
+		if (meshes[i].indices.count / 3u <= OcclusionCuller::MaxOccluderTriangles &&
+			meshPtrs[i]->GetBounds().radius >= largestRadius * 0.5f)
+		{
+			meshPtrs[i]->MakeOccluder(meshes[i]);
+			hasOccluders = true;
+		}
+	}
+	int nextId = 0;
+	pRoot = ParseNode(nextId, asset, 0u);
+	pRoot->UpdateBounds();
+	CUBE_TRACE(std::string(asset.IsCooked() ? "Successfully loaded cooked model " : "Successfully imported model ") + rootPath);
+}
+
 Node& Model::getpRoot()
 {
 	return *pRoot;
 }
 
 
-void Model::Submit(FrameCommander& frame) const noexcept
+void Model::Submit(FrameCommander& frame, bool inside) const noexcept
+{
+	pRoot->Submit(frame, DirectX::XMMatrixIdentity(), inside);
+}
+
+void Model::Attach(SceneBVH& bvh)
+{
+	assert(pBVH == nullptr);
+	Update();
+	pBVH = &bvh;
+	bvhProxy = bvh.Insert(this, GetWorldBounds());
+}
+
+void Model::Update() noexcept
 {
 	if (auto node = GetSelectedNode())
 	{
 		node->SetAppliedTransform(GetTransform());
 		node->SetAppliedScale(GetScale());
 	}
-	pRoot->Submit(frame, DirectX::XMMatrixIdentity());
+	if (pRoot->UpdateBounds() && pBVH != nullptr)
+	{
+		pBVH->Move(bvhProxy, GetWorldBounds());
+	}
+}
+
+void Model::RasterizeOccluders(OcclusionCuller& occlusion) const
+{
+	if (hasOccluders)
+	{
+		pRoot->RasterizeOccluders(occlusion, DirectX::XMMatrixIdentity());
+	}
+}
+
+bool Model::Raycast(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, float maxDistance, float& distance) const noexcept
+{
+	distance = maxDistance;
+	return pRoot->Raycast(origin, dir, DirectX::XMMatrixIdentity(), distance);
+}
+
+BoundingVolume Model::GetWorldBounds() const noexcept
+{
+	const auto rootTransform =
+		DirectX::XMLoadFloat4x4(&pRoot->appliedTransform) *
+		DirectX::XMLoadFloat4x4(&pRoot->baseTransform);
+	return pRoot->bounds.Transform(rootTransform);
 }
 
 
@@ -394,6 +652,8 @@ void Model::ShowWindow(Graphics& gfx, Model* pSelectedModel) noexcept
 			ImGui::End();
 		}
 	}
+	//        BVH ,    
+	Update();
 }
 
 void Model::SetRootTransfotm(DirectX::FXMMATRIX tf)
@@ -445,7 +705,12 @@ Node* Model::GetSelectedNode() const noexcept
 
 
 Model::~Model() noexcept
-{}
+{
+	if (pBVH != nullptr)
+	{
+		pBVH->Remove(bvhProxy);
+	}
+}
 
 int Model::GetId() const noexcept
 {
@@ -454,25 +719,21 @@ int Model::GetId() const noexcept
 
 
 
-std::unique_ptr<Node> Model::ParseNode(int& nextId, const aiNode& node)
+std::unique_ptr<Node> Model::ParseNode(int& nextId, const ModelAsset& asset, size_t nodeIndex)
 {
-	namespace dx = DirectX;
-	const auto transform = dx::XMMatrixTranspose(dx::XMLoadFloat4x4(
-		reinterpret_cast<const dx::XMFLOAT4X4*>(&node.mTransformation)
-	));
+	const auto& node = asset.GetNodes()[nodeIndex];
 
 	std::vector<Mesh*> curMeshPtrs;
-	curMeshPtrs.reserve(node.mNumMeshes);
-	for (size_t i = 0; i < node.mNumMeshes; i++)
+	curMeshPtrs.reserve(node.meshes.size());
+	for (const auto meshIdx : node.meshes)
 	{
-		const auto meshIdx = node.mMeshes[i];
 		curMeshPtrs.push_back(meshPtrs.at(meshIdx).get());
 	}
 
-	auto pNode = std::make_unique<Node>(nextId++, node.mName.C_Str(), std::move(curMeshPtrs), transform);
-	for (size_t i = 0; i < node.mNumChildren; i++)
+	auto pNode = std::make_unique<Node>(nextId++, node.name, std::move(curMeshPtrs), DirectX::XMLoadFloat4x4(&node.transform));
+	for (const auto childIdx : node.children)
 	{
-		pNode->AddChild(ParseNode(nextId, *node.mChildren[i]));
+		pNode->AddChild(ParseNode(nextId, asset, childIdx));
 	}
 	return pNode;
 }
\ No newline at end of file
@@ -0,0 +1,347 @@
+#include "../includes/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+
+namespace
+{
+	constexpr uint32_t Unused = std::numeric_limits<uint32_t>::max();
+
+	//FIFO-   :   ,        cacheSize 
+	class FifoCache
+	{
+	public:
+		FifoCache(size_t vertexCount, size_t cacheSize)
+			:
+			cacheTime(vertexCount, 0u),
+			cacheSize(uint32_t(cacheSize)),
+			timestamp(uint32_t(cacheSize) + 1u)
+		{}
+		bool Contains(uint32_t v) const noexcept
+		{
+			return timestamp - cacheTime[v] <= cacheSize;
+		}
+		//true,     
+		bool Touch(uint32_t v) noexcept
+		{
+			if (Contains(v))
+			{
+				return false;
+			}
+			cacheTime[v] = timestamp++;
+			return true;
+		}
+		//      
+		uint32_t GetAge(uint32_t v) const noexcept
+		{
+			return timestamp - cacheTime[v];
+		}
+	private:
+		std::vector<uint32_t> cacheTime;
+		uint32_t cacheSize;
+		uint32_t timestamp;
+	};
+
+	// ,   
+	struct Adjacency
+	{
+		Adjacency(const std::vector<uint32_t>& indices, size_t vertexCount)
+			:
+			offsets(vertexCount + 1u, 0u),
+			triangles(indices.size())
+		{
+			for (const auto v : indices)
+			{
+				++offsets[v + 1u];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0u; i < indices.size(); ++i)
+			{
+				triangles[fill[indices[i]]++] = uint32_t(i / 3u);
+			}
+		}
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> triangles;
+	};
+
+	DirectX::XMFLOAT3 Cross(const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2) noexcept
+	{
+		const float ux = p1.x - p0.x, uy = p1.y - p0.y, uz = p1.z - p0.z;
+		const float vx = p2.x - p0.x, vy = p2.y - p0.y, vz = p2.z - p0.z;
+		return { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx };
+	}
+}
+
+
+MeshOptimizer::Stats MeshOptimizer::Analyze(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+{
+	Stats stats;
+	if (indices.empty())
+	{
+		return stats;
+	}
+	FifoCache cache(vertexCount, cacheSize);
+	std::vector<bool> used(vertexCount, false);
+	size_t misses = 0u;
+	size_t usedCount = 0u;
+	for (const auto v : indices)
+	{
+		if (cache.Touch(v))
+		{
+			++misses;
+		}
+		if (!used[v])
+		{
+			used[v] = true;
+			++usedCount;
+		}
+	}
+	stats.acmr = float(misses) / float(indices.size() / 3u);
+	stats.atvr = float(misses) / float(usedCount);
+	return stats;
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+	std::vector<uint32_t>* pClusters, size_t cacheSize)
+{
+	const size_t triangleCount = indices.size() / 3u;
+	if (pClusters != nullptr)
+	{
+		pClusters->clear();
+	}
+	if (triangleCount == 0u)
+	{
+		return indices;
+	}
+	const Adjacency adjacency(indices, vertexCount);
+	//       
+	std::vector<uint32_t> live(vertexCount);
+	for (size_t v = 0u; v < vertexCount; ++v)
+	{
+		live[v] = adjacency.offsets[v + 1u] - adjacency.offsets[v];
+	}
+	std::vector<bool> emitted(triangleCount, false);
+	//  ,      
+	std::vector<uint32_t> deadEnd;
+	FifoCache cache(vertexCount, cacheSize);
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	std::vector<uint32_t> candidates;
+	size_t cursor = 0u;
+
+	uint32_t fanning = indices[0];
+	bool jumped = true;
+	while (fanning != Unused)
+	{
+		if (jumped && pClusters != nullptr)
+		{
+			pClusters->push_back(uint32_t(result.size()));
+		}
+		//       
+		candidates.clear();
+		for (uint32_t a = adjacency.offsets[fanning]; a < adjacency.offsets[fanning + 1u]; ++a)
+		{
+			const auto t = adjacency.triangles[a];
+			if (emitted[t])
+			{
+				continue;
+			}
+			emitted[t] = true;
+			for (size_t k = 0u; k < 3u; ++k)
+			{
+				const auto v = indices[t * 3u + k];
+				result.push_back(v);
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+				--live[v];
+				cache.Touch(v);
+			}
+		}
+		//  -  ,      ,    
+		fanning = Unused;
+		uint32_t bestPriority = 0u;
+		for (const auto v : candidates)
+		{
+			if (live[v] == 0u)
+			{
+				continue;
+			}
+			uint32_t priority = 0u;
+			if (cache.GetAge(v) + 2u * live[v] <= cacheSize)
+			{
+				priority = cache.GetAge(v);
+			}
+			if (fanning == Unused || priority > bestPriority)
+			{
+				fanning = v;
+				bestPriority = priority;
+			}
+		}
+		jumped = false;
+		if (fanning != Unused)
+		{
+			continue;
+		}
+		//:     ,     -     
+		jumped = true;
+		while (!deadEnd.empty() && fanning == Unused)
+		{
+			if (live[deadEnd.back()] > 0u)
+			{
+				fanning = deadEnd.back();
+			}
+			deadEnd.pop_back();
+		}
+		while (fanning == Unused && cursor < vertexCount)
+		{
+			if (live[cursor] > 0u)
+			{
+				fanning = uint32_t(cursor);
+			}
+			++cursor;
+		}
+	}
+	return result;
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeOverdraw(const DirectX::XMFLOAT3* pPositions, size_t vertexCount,
+	const std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters, float threshold, size_t cacheSize)
+{
+	const size_t triangleCount = indices.size() / 3u;
+	if (triangleCount == 0u)
+	{
+		return indices;
+	}
+	//    ,   ACMR     ACMR  :
+	//        
+	const float meshAcmr = Analyze(indices, vertexCount, cacheSize).acmr;
+	std::vector<uint32_t> starts;
+	{
+		FifoCache cache(vertexCount, cacheSize);
+		size_t nextHard = 0u;
+		size_t misses = 0u;
+		size_t triangles = 0u;
+		for (size_t i = 0u; i < indices.size(); i += 3u)
+		{
+			const bool hard = nextHard < clusters.size() && clusters[nextHard] == i;
+			if (hard || (triangles > 0u && float(misses) <= threshold * meshAcmr * float(triangles)))
+			{
+				starts.push_back(uint32_t(i));
+				misses = 0u;
+				triangles = 0u;
+			}
+			if (hard)
+			{
+				++nextHard;
+			}
+			for (size_t k = 0u; k < 3u; ++k)
+			{
+				if (cache.Touch(indices[i + k]))
+				{
+					++misses;
+				}
+			}
+			++triangles;
+		}
+		if (starts.empty() || starts.front() != 0u)
+		{
+			starts.insert(starts.begin(), 0u);
+		}
+	}
+
+	//    
+	double meshCenter[3] = {};
+	double meshArea = 0.0;
+	for (size_t i = 0u; i < indices.size(); i += 3u)
+	{
+		const auto& p0 = pPositions[indices[i]];
+		const auto& p1 = pPositions[indices[i + 1u]];
+		const auto& p2 = pPositions[indices[i + 2u]];
+		const auto n = Cross(p0, p1, p2);
+		const double area = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+		meshCenter[0] += area * (double(p0.x) + p1.x + p2.x) / 3.0;
+		meshCenter[1] += area * (double(p0.y) + p1.y + p2.y) / 3.0;
+		meshCenter[2] += area * (double(p0.z) + p1.z + p2.z) / 3.0;
+		meshArea += area;
+	}
+	if (meshArea > 0.0)
+	{
+		for (auto& c : meshCenter)
+		{
+			c /= meshArea;
+		}
+	}
+
+	//  -        
+	struct Cluster
+	{
+		uint32_t begin;
+		uint32_t end;
+		double key;
+	};
+	std::vector<Cluster> sorted;
+	sorted.reserve(starts.size());
+	for (size_t c = 0u; c < starts.size(); ++c)
+	{
+		Cluster cluster = { starts[c], c + 1u < starts.size() ? starts[c + 1u] : uint32_t(indices.size()), 0.0 };
+		double center[3] = {};
+		double normal[3] = {};
+		double area = 0.0;
+		for (size_t i = cluster.begin; i < cluster.end; i += 3u)
+		{
+			const auto& p0 = pPositions[indices[i]];
+			const auto& p1 = pPositions[indices[i + 1u]];
+			const auto& p2 = pPositions[indices[i + 2u]];
+			const auto n = Cross(p0, p1, p2);
+			const double triangleArea = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+			center[0] += triangleArea * (double(p0.x) + p1.x + p2.x) / 3.0;
+			center[1] += triangleArea * (double(p0.y) + p1.y + p2.y) / 3.0;
+			center[2] += triangleArea * (double(p0.z) + p1.z + p2.z) / 3.0;
+			//     
+			normal[0] += n.x;
+			normal[1] += n.y;
+			normal[2] += n.z;
+			area += triangleArea;
+		}
+		const double normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (area > 0.0 && normalLength > 0.0)
+		{
+			for (size_t k = 0u; k < 3u; ++k)
+			{
+				cluster.key += (center[k] / area - meshCenter[k]) * normal[k] / normalLength;
+			}
+		}
+		sorted.push_back(cluster);
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b)
+	{
+		return a.key > b.key;
+	});
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (const auto& cluster : sorted)
+	{
+		result.insert(result.end(), indices.begin() + cluster.begin, indices.begin() + cluster.end);
+	}
+	return result;
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+	std::vector<uint32_t> remap(vertexCount, Unused);
+	std::vector<uint32_t> order;
+	for (auto& v : indices)
+	{
+		if (remap[v] == Unused)
+		{
+			remap[v] = uint32_t(order.size());
+			order.push_back(v);
+		}
+		v = remap[v];
+	}
+	return order;
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "../includes/MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace
+{
+	//  4x4 : A = n * n^T, b = d * n, c = d * d   n * p + d = 0
+	struct Quadric
+	{
+		double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+
+		void AddPlane(double nx, double ny, double nz, double d) noexcept
+		{
+			a00 += nx * nx; a01 += nx * ny; a02 += nx * nz;
+			a11 += ny * ny; a12 += ny * nz; a22 += nz * nz;
+			b0 += nx * d; b1 += ny * d; b2 += nz * d;
+			c += d * d;
+		}
+		void Add(const Quadric& q) noexcept
+		{
+			a00 += q.a00; a01 += q.a01; a02 += q.a02;
+			a11 += q.a11; a12 += q.a12; a22 += q.a22;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+		}
+		//        
+		double Evaluate(const DirectX::XMFLOAT3& p) const noexcept
+		{
+			const double x = p.x, y = p.y, z = p.z;
+			return a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z +
+				a11 * y * y + 2.0 * a12 * y * z + a22 * z * z +
+				2.0 * (b0 * x + b1 * y + b2 * z) + c;
+		}
+	};
+
+	struct Collapse
+	{
+		double cost;
+		uint32_t from;
+		uint32_t to;
+	};
+
+	DirectX::XMFLOAT3 Cross(const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2) noexcept
+	{
+		const float ux = p1.x - p0.x, uy = p1.y - p0.y, uz = p1.z - p0.z;
+		const float vx = p2.x - p0.x, vy = p2.y - p0.y, vz = p2.z - p0.z;
+		return { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx };
+	}
+
+	uint64_t EdgeKey(uint32_t a, uint32_t b) noexcept
+	{
+		return a < b ? (uint64_t(a) << 32u) | b : (uint64_t(b) << 32u) | a;
+	}
+}
+
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const DirectX::XMFLOAT3* pPositions, size_t vertexCount,
+	const std::vector<uint32_t>& indices_in, size_t targetIndexCount, float* pError)
+{
+	std::vector<uint32_t> indices = indices_in;
+	double maxError = 0.0;
+
+	//     
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0u; i + 2u < indices.size(); i += 3u)
+	{
+		const auto& p0 = pPositions[indices[i]];
+		const auto n = Cross(p0, pPositions[indices[i + 1u]], pPositions[indices[i + 2u]]);
+		const double length = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+		if (length <= 0.0)
+		{
+			continue;
+		}
+		const double nx = n.x / length, ny = n.y / length, nz = n.z / length;
+		const double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+		for (size_t k = 0u; k < 3u; ++k)
+		{
+			quadrics[indices[i + k]].AddPlane(nx, ny, nz, d);
+		}
+	}
+
+	//        ,      
+	std::vector<bool> locked(vertexCount, false);
+	{
+		std::unordered_map<uint64_t, unsigned int> edgeUse;
+		edgeUse.reserve(indices.size());
+		for (size_t i = 0u; i + 2u < indices.size(); i += 3u)
+		{
+			for (size_t k = 0u; k < 3u; ++k)
+			{
+				++edgeUse[EdgeKey(indices[i + k], indices[i + (k + 1u) % 3u])];
+			}
+		}
+		for (const auto& e : edgeUse)
+		{
+			if (e.second != 2u)
+			{
+				locked[size_t(e.first >> 32u)] = true;
+				locked[size_t(e.first & 0xFFFFFFFFu)] = true;
+			}
+		}
+	}
+
+	std::vector<unsigned int> adjacencyOffsets(vertexCount + 1u);
+	std::vector<unsigned int> adjacency;
+	std::vector<Collapse> collapses;
+	std::vector<bool> frozen(vertexCount);
+	std::vector<uint32_t> remap(vertexCount);
+	while (indices.size() > targetIndexCount)
+	{
+		//   
+		std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+		for (const auto i : indices)
+		{
+			++adjacencyOffsets[i + 1u];
+		}
+		for (size_t v = 0u; v < vertexCount; ++v)
+		{
+			adjacencyOffsets[v + 1u] += adjacencyOffsets[v];
+		}
+		adjacency.resize(indices.size());
+		{
+			auto fill = adjacencyOffsets;
+			for (size_t i = 0u; i < indices.size(); ++i)
+			{
+				adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3u);
+			}
+		}
+
+		collapses.clear();
+		for (size_t i = 0u; i + 2u < indices.size(); i += 3u)
+		{
+			for (size_t k = 0u; k < 3u; ++k)
+			{
+				const auto a = indices[i + k];
+				const auto b = indices[i + (k + 1u) % 3u];
+				Quadric q = quadrics[a];
+				q.Add(quadrics[b]);
+				if (!locked[a])
+				{
+					collapses.push_back({ q.Evaluate(pPositions[b]), a, b });
+				}
+				if (!locked[b])
+				{
+					collapses.push_back({ q.Evaluate(pPositions[a]), b, a });
+				}
+			}
+		}
+		if (collapses.empty())
+		{
+			break;
+		}
+		std::sort(collapses.begin(), collapses.end(),
+			[](const Collapse& l, const Collapse& r) { return l.cost < r.cost; });
+
+		//   ,    :    
+		std::fill(frozen.begin(), frozen.end(), false);
+		for (size_t v = 0u; v < vertexCount; ++v)
+		{
+			remap[v] = static_cast<uint32_t>(v);
+		}
+		const size_t trianglesToRemove = (indices.size() - targetIndexCount + 2u) / 3u;
+		size_t removed = 0u;
+		for (const auto& c : collapses)
+		{
+			if (removed >= trianglesToRemove)
+			{
+				break;
+			}
+			if (frozen[c.from] || frozen[c.to])
+			{
+				continue;
+			}
+			// ,  -    
+			bool flips = false;
+			size_t collapsing = 0u;
+			for (auto j = adjacencyOffsets[c.from]; j < adjacencyOffsets[c.from + 1u] && !flips; ++j)
+			{
+				const size_t t = size_t(adjacency[j]) * 3u;
+				const uint32_t tri[3] = { indices[t], indices[t + 1u], indices[t + 2u] };
+				if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to)
+				{
+					++collapsing;
+					continue;
+				}
+				DirectX::XMFLOAT3 moved[3];
+				for (size_t k = 0u; k < 3u; ++k)
+				{
+					moved[k] = pPositions[tri[k] == c.from ? c.to : tri[k]];
+				}
+				const auto n0 = Cross(pPositions[tri[0]], pPositions[tri[1]], pPositions[tri[2]]);
+				const auto n1 = Cross(moved[0], moved[1], moved[2]);
+				flips = n0.x * n1.x + n0.y * n1.y + n0.z * n1.z <= 0.0f;
+			}
+			if (flips || collapsing == 0u)
+			{
+				continue;
+			}
+			for (auto j = adjacencyOffsets[c.from]; j < adjacencyOffsets[c.from + 1u]; ++j)
+			{
+				const size_t t = size_t(adjacency[j]) * 3u;
+				frozen[indices[t]] = true;
+				frozen[indices[t + 1u]] = true;
+				frozen[indices[t + 2u]] = true;
+			}
+			remap[c.from] = c.to;
+			quadrics[c.to].Add(quadrics[c.from]);
+			maxError = std::max(maxError, c.cost);
+			removed += collapsing;
+		}
+		if (removed == 0u)
+		{
+			break;
+		}
+
+		//    ,   
+		size_t write = 0u;
+		for (size_t i = 0u; i + 2u < indices.size(); i += 3u)
+		{
+			const auto a = remap[indices[i]];
+			const auto b = remap[indices[i + 1u]];
+			const auto c = remap[indices[i + 2u]];
+			if (a != b && b != c && a != c)
+			{
+				indices[write++] = a;
+				indices[write++] = b;
+				indices[write++] = c;
+			}
+		}
+		indices.resize(write);
+	}
+
+	if (pError != nullptr)
+	{
+		*pError = float(std::sqrt(std::max(maxError, 0.0)));
+	}
+	return indices;
+}
\ No newline at end of file
@@ -0,0 +1,1030 @@
+#include "../includes/ModelAsset.h"
+#include "../includes/MeshSimplifier.h"
+#include "../includes/MeshOptimizer.h"
+#include "../includes/AssetCache.h"
+#include "../includes/WorkerPool.h"
+#include "../includes/Texture.h"
+#include "../core/includes/Log.h"
+#include <assimp/Importer.hpp>
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+
+
+namespace
+{
+	constexpr char CookedMagic[8] = { 'C','U','B','E','M','E','S','H' };
+	//        ,   
+	constexpr uint32_t CookedVersion = 7u;
+	constexpr unsigned int ImportFlags =
+		aiProcess_Triangulate |
+		aiProcess_JoinIdenticalVertices |
+		aiProcess_ConvertToLeftHanded |
+		aiProcess_GenNormals |
+		aiProcess_CalcTangentSpace;
+
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t materialCount;
+		uint32_t meshCount;
+		uint32_t nodeCount;
+		uint32_t dependencyCount;
+	};
+
+	struct MeshRecord
+	{
+		uint32_t materialIndex;
+		uint32_t elementCount;
+		uint32_t vertexCount;
+		uint32_t vertexStride;
+		uint32_t indexCount;
+		uint32_t indexSize;
+		uint32_t lodCount;
+		BoundingVolume bounds;
+	};
+
+	//   .    16 ,   4
+	class ImageWriter
+	{
+	public:
+		explicit ImageWriter(std::vector<char>& image) : image(image) {}
+		template<typename T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written");
+			WriteBytes(&value, sizeof(T));
+		}
+		void WriteBytes(const void* pData, size_t size)
+		{
+			const auto at = Reserve(size);
+			std::memcpy(image.data() + at, pData, size);
+		}
+		void WriteString(const std::string& s)
+		{
+			Write(static_cast<uint32_t>(s.size()));
+			WriteBytes(s.data(), s.size());
+			Align(4u);
+		}
+		//   size        
+		size_t Reserve(size_t size)
+		{
+			const auto at = image.size();
+			image.resize(at + size);
+			return at;
+		}
+		void Align(size_t alignment)
+		{
+			image.resize((image.size() + alignment - 1u) / alignment * alignment);
+		}
+	private:
+		std::vector<char>& image;
+	};
+
+	//    .        
+	class ImageReader
+	{
+	public:
+		ImageReader(const char* pData, size_t size) : pData(pData), size(size) {}
+		template<typename T>
+		T Read()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read");
+			T value = {};
+			if (const auto p = ReadBytes(sizeof(T)))
+			{
+				std::memcpy(&value, p, sizeof(T));
+			}
+			return value;
+		}
+		const char* ReadBytes(size_t count)
+		{
+			if (!valid || count > size - pos)
+			{
+				valid = false;
+				return nullptr;
+			}
+			const auto p = pData + pos;
+			pos += count;
+			return p;
+		}
+		std::string ReadString()
+		{
+			const auto length = Read<uint32_t>();
+			const auto p = ReadBytes(length);
+			Align(4u);
+			return p != nullptr ? std::string(p, length) : std::string{};
+		}
+		void Align(size_t alignment)
+		{
+			const auto aligned = (pos + alignment - 1u) / alignment * alignment;
+			if (aligned > size)
+			{
+				valid = false;
+				return;
+			}
+			pos = aligned;
+		}
+		bool IsValid() const noexcept
+		{
+			return valid;
+		}
+	private:
+		const char* pData;
+		size_t size;
+		size_t pos = 0u;
+		bool valid = true;
+	};
+
+	//   :    
+	std::string GetTextureKey(const std::string& path, TextureRole role)
+	{
+		return path + "#" + std::to_string(static_cast<int>(role));
+	}
+
+	//  Assimp,     :   
+	//   ,  .mtl  OBJ   .bin  glTF
+	class RecordingIOSystem : public Assimp::DefaultIOSystem
+	{
+	public:
+		explicit RecordingIOSystem(std::vector<std::string>& opened) : opened(opened) {}
+		Assimp::IOStream* Open(const char* pFile, const char* pMode = "rb") override
+		{
+			const auto pStream = DefaultIOSystem::Open(pFile, pMode);
+			if (pStream != nullptr)
+			{
+				opened.emplace_back(pFile);
+			}
+			return pStream;
+		}
+	private:
+		std::vector<std::string>& opened;
+	};
+
+	//    half        :
+	// ulp half  [1, 2)     1/2048,   half     2
+	constexpr float MaxHalfPositionError = 1.0f / 2048.0f;
+	constexpr float MaxHalfTexCoordError = 1.0f / 2048.0f;
+
+	float RoundTripHalf(float value) noexcept
+	{
+		return DirectX::PackedVector::XMConvertHalfToFloat(DirectX::PackedVector::XMConvertFloatToHalf(value));
+	}
+
+	bool FitsHalfPositions(const aiMesh& mesh)
+	{
+		const auto bounds = BoundingVolume::FromPoints(reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices), mesh.mNumVertices);
+		const float tolerance = 2.0f * std::max({ bounds.extents.x, bounds.extents.y, bounds.extents.z }) * MaxHalfPositionError;
+		for (unsigned int v = 0; v < mesh.mNumVertices; ++v)
+		{
+			const auto& p = mesh.mVertices[v];
+			for (const float c : { p.x, p.y, p.z })
+			{
+				if (!(std::abs(RoundTripHalf(c) - c) <= tolerance))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool FitsHalfTexCoords(const aiMesh& mesh)
+	{
+		if (mesh.mTextureCoords[0] == nullptr)
+		{
+			return true;
+		}
+		for (unsigned int v = 0; v < mesh.mNumVertices; ++v)
+		{
+			const auto& t = mesh.mTextureCoords[0][v];
+			if (!(std::abs(RoundTripHalf(t.x) - t.x) <= MaxHalfTexCoordError && std::abs(RoundTripHalf(t.y) - t.y) <= MaxHalfTexCoordError))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//,   ,     w
+	DirectX::XMFLOAT4 MakeTangentFrame(const aiVector3D& normal, const aiVector3D& tangent, const aiVector3D& bitangent) noexcept
+	{
+		namespace dx = DirectX;
+		const auto n = dx::XMVector3Normalize(dx::XMVectorSet(normal.x, normal.y, normal.z, 0.0f));
+		const auto t0 = dx::XMVectorSet(tangent.x, tangent.y, tangent.z, 0.0f);
+		const auto t = dx::XMVector3Normalize(dx::XMVectorSubtract(t0, dx::XMVectorMultiply(n, dx::XMVector3Dot(n, t0))));
+		const auto b = dx::XMVectorSet(bitangent.x, bitangent.y, bitangent.z, 0.0f);
+		dx::XMFLOAT4 frame;
+		dx::XMStoreFloat4(&frame, t);
+		frame.w = dx::XMVectorGetX(dx::XMVector3Dot(dx::XMVector3Cross(n, t), b)) < 0.0f ? -1.0f : 1.0f;
+		return frame;
+	}
+
+	//  Type    , get(v)     v
+	template<CubeR::VertexLayout::ElementType Type, typename Get>
+	void EncodeElement(char* pDst, size_t stride, size_t count, Get&& get)
+	{
+		using Map = CubeR::VertexLayout::Map<Type>;
+		for (size_t v = 0u; v < count; ++v, pDst += stride)
+		{
+			const typename Map::SysType packed = Map::Encode(get(v));
+			std::memcpy(pDst, &packed, sizeof(packed));
+		}
+	}
+
+	//  ,  16- 
+	constexpr size_t MaxShortVertices = size_t(std::numeric_limits<unsigned short>::max()) + 1u;
+
+	//     :        
+	struct MeshPart
+	{
+		std::vector<uint32_t> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	//        MaxShortVertices ,   16- .
+	//  ,     .
+	//  -   ,  32-    
+	std::vector<MeshPart> SplitMesh(const std::vector<uint32_t>& indices, size_t vertexCount, size_t vertexStride)
+	{
+		constexpr uint32_t Unused = std::numeric_limits<uint32_t>::max();
+		std::vector<MeshPart> parts(1u);
+		//    ,     
+		std::vector<uint32_t> local(vertexCount, Unused);
+		size_t partVertices = 0u;
+		for (size_t t = 0u; t < indices.size(); t += 3u)
+		{
+			size_t added = 0u;
+			for (size_t k = 0u; k < 3u; ++k)
+			{
+				const auto v = indices[t + k];
+				if (local[v] == Unused && (k < 1u || indices[t] != v) && (k < 2u || indices[t + 1u] != v))
+				{
+					++added;
+				}
+			}
+			if (parts.back().vertices.size() + added > MaxShortVertices)
+			{
+				for (const auto v : parts.back().vertices)
+				{
+					local[v] = Unused;
+				}
+				partVertices += parts.back().vertices.size();
+				parts.emplace_back();
+			}
+			auto& part = parts.back();
+			for (size_t k = 0u; k < 3u; ++k)
+			{
+				const auto v = indices[t + k];
+				if (local[v] == Unused)
+				{
+					local[v] = static_cast<uint32_t>(part.vertices.size());
+					part.vertices.push_back(v);
+				}
+				part.indices.push_back(local[v]);
+			}
+		}
+		partVertices += parts.back().vertices.size();
+		//       ,      
+		const size_t duplicated = partVertices > vertexCount ? partVertices - vertexCount : 0u;
+		if (duplicated * vertexStride >= indices.size() * (sizeof(uint32_t) - sizeof(unsigned short)))
+		{
+			return {};
+		}
+		return parts;
+	}
+
+	void WriteIndices(ImageWriter& writer, const std::vector<uint32_t>& indices, uint32_t indexSize)
+	{
+		writer.Align(4u);
+		if (indexSize == sizeof(uint32_t))
+		{
+			writer.WriteBytes(indices.data(), sizeof(uint32_t) * indices.size());
+			return;
+		}
+		const std::vector<unsigned short> narrow(indices.begin(), indices.end());
+		writer.WriteBytes(narrow.data(), sizeof(unsigned short) * narrow.size());
+	}
+
+	//        .      16 ,
+	//       .
+	//vertices -    ,   -    
+	void CookPart(const aiMesh& mesh, const CubeR::VertexLayout& layout, const std::vector<uint32_t>& vertices,
+		std::vector<uint32_t> indices, std::vector<char>& blob, MeshOptimizer::Report& report)
+	{
+		constexpr size_t MinLodTriangles = 256u;
+		constexpr size_t MaxLods = 4u;
+		static_assert(sizeof(aiVector3D) == sizeof(DirectX::XMFLOAT3), "aiVector3D must match XMFLOAT3");
+		ImageWriter writer(blob);
+		writer.Align(16u);
+		const auto pMeshPositions = reinterpret_cast<const DirectX::XMFLOAT3*>(mesh.mVertices);
+		//       
+		std::vector<uint32_t> source(vertices);
+		if (source.empty())
+		{
+			source.resize(mesh.mNumVertices);
+			std::iota(source.begin(), source.end(), 0u);
+		}
+		std::vector<DirectX::XMFLOAT3> positions(source.size());
+		for (size_t v = 0u; v < source.size(); ++v)
+		{
+			positions[v] = pMeshPositions[source[v]];
+		}
+
+		//      ,   -    
+		report.before = MeshOptimizer::Analyze(indices, source.size());
+		if (!indices.empty())
+		{
+			std::vector<uint32_t> clusters;
+			indices = MeshOptimizer::OptimizeVertexCache(indices, source.size(), &clusters);
+			indices = MeshOptimizer::OptimizeOverdraw(positions.data(), positions.size(), indices, clusters);
+			const auto order = MeshOptimizer::OptimizeVertexFetch(indices, source.size());
+			std::vector<uint32_t> orderedSource(order.size());
+			std::vector<DirectX::XMFLOAT3> orderedPositions(order.size());
+			for (size_t v = 0u; v < order.size(); ++v)
+			{
+				orderedSource[v] = source[order[v]];
+				orderedPositions[v] = positions[order[v]];
+			}
+			source = std::move(orderedSource);
+			positions = std::move(orderedPositions);
+		}
+		report.after = MeshOptimizer::Analyze(indices, source.size());
+		const size_t vertexCount = source.size();
+		const auto pPositions = positions.data();
+
+		//      :  -    
+		std::vector<std::vector<uint32_t>> lods;
+		if (indices.size() / 3u >= MinLodTriangles)
+		{
+			const size_t fullCount = indices.size();
+			for (size_t lod = 1u; lod < MaxLods; ++lod)
+			{
+				//    ,     
+				const auto& previous = lods.empty() ? indices : lods.back();
+				const size_t target = (fullCount >> lod) / 3u * 3u;
+				auto simplified = MeshSimplifier::Simplify(pPositions, vertexCount, previous, target);
+				simplified = MeshOptimizer::OptimizeVertexCache(simplified, vertexCount);
+				//,       ,    
+				if (simplified.size() * 5u > previous.size() * 4u)
+				{
+					break;
+				}
+				lods.push_back(std::move(simplified));
+			}
+		}
+
+		MeshRecord record = {};
+		record.materialIndex = mesh.mMaterialIndex;
+		record.elementCount = static_cast<uint32_t>(layout.GetElementCount());
+		record.vertexCount = static_cast<uint32_t>(vertexCount);
+		record.vertexStride = static_cast<uint32_t>(layout.Size());
+		record.indexCount = static_cast<uint32_t>(indices.size());
+		record.indexSize = vertexCount <= MaxShortVertices ? sizeof(unsigned short) : sizeof(uint32_t);
+		record.lodCount = static_cast<uint32_t>(lods.size());
+		record.bounds = BoundingVolume::FromPoints(pPositions, vertexCount);
+		writer.Write(record);
+		for (size_t e = 0u; e < layout.GetElementCount(); ++e)
+		{
+			writer.Write(static_cast<uint32_t>(layout.ResolveByIndex(e).GetType()));
+		}
+		for (const auto& lod : lods)
+		{
+			writer.Write(static_cast<uint32_t>(lod.size()));
+		}
+
+		//     Assimp    .
+		//     ,     
+		writer.Align(16u);
+		const size_t vertexAt = writer.Reserve(layout.Size() * vertexCount);
+		for (size_t e = 0u; e < layout.GetElementCount(); ++e)
+		{
+			const auto& element = layout.ResolveByIndex(e);
+			const aiVector3D* pSource = nullptr;
+			char* pDst = blob.data() + vertexAt + element.GetOffset();
+			switch (element.GetType())
+			{
+			case CubeR::VertexLayout::Position3DHalf:
+				EncodeElement<CubeR::VertexLayout::Position3DHalf>(pDst, layout.Size(), vertexCount, [&](size_t v)
+				{
+					return pPositions[v];
+				});
+				continue;
+			case CubeR::VertexLayout::Texture2DHalf:
+				if (mesh.mTextureCoords[0] != nullptr)
+				{
+					EncodeElement<CubeR::VertexLayout::Texture2DHalf>(pDst, layout.Size(), vertexCount, [&](size_t v)
+					{
+						const auto& t = mesh.mTextureCoords[0][source[v]];
+						return DirectX::XMFLOAT2{ t.x, t.y };
+					});
+				}
+				continue;
+			case CubeR::VertexLayout::NormalOct:
+				if (mesh.mNormals != nullptr)
+				{
+					EncodeElement<CubeR::VertexLayout::NormalOct>(pDst, layout.Size(), vertexCount, [&](size_t v)
+					{
+						return reinterpret_cast<const DirectX::XMFLOAT3&>(mesh.mNormals[source[v]]);
+					});
+				}
+				continue;
+			case CubeR::VertexLayout::TangentFrame:
+				if (mesh.mNormals != nullptr && mesh.mTangents != nullptr && mesh.mBitangents != nullptr)
+				{
+					EncodeElement<CubeR::VertexLayout::TangentFrame>(pDst, layout.Size(), vertexCount, [&](size_t v)
+					{
+						const auto s = source[v];
+						return MakeTangentFrame(mesh.mNormals[s], mesh.mTangents[s], mesh.mBitangents[s]);
+					});
+				}
+				continue;
+			case CubeR::VertexLayout::Position3D:
+				pSource = mesh.mVertices;
+				break;
+			case CubeR::VertexLayout::Normal:
+				pSource = mesh.mNormals;
+				break;
+			case CubeR::VertexLayout::Tangent:
+				pSource = mesh.mTangents;
+				break;
+			case CubeR::VertexLayout::Bitangent:
+				pSource = mesh.mBitangents;
+				break;
+			case CubeR::VertexLayout::Texture2D:
+				pSource = mesh.mTextureCoords[0];
+				break;
+			default:
+				assert("Element type is not produced by import" && false);
+			}
+			if (pSource == nullptr)
+			{
+				continue;
+			}
+			for (size_t v = 0u; v < vertexCount; ++v, pDst += layout.Size())
+			{
+				std::memcpy(pDst, &pSource[source[v]], element.Size());
+			}
+		}
+		WriteIndices(writer, indices, record.indexSize);
+		for (const auto& lod : lods)
+		{
+			WriteIndices(writer, lod, record.indexSize);
+		}
+		writer.Align(4u);
+	}
+
+	//   Assimp    . ,    16- ,
+	//  ,    32- .  reports -     
+	void CookMesh(const aiMesh& mesh, const CubeR::VertexLayout& layout, std::vector<char>& blob, std::vector<MeshOptimizer::Report>& reports)
+	{
+		std::vector<uint32_t> indices;
+		indices.reserve(size_t(mesh.mNumFaces) * 3u);
+		for (unsigned int f = 0; f < mesh.mNumFaces; ++f)
+		{
+			const auto& face = mesh.mFaces[f];
+			assert(face.mNumIndices == 3);
+			indices.push_back(face.mIndices[0]);
+			indices.push_back(face.mIndices[1]);
+			indices.push_back(face.mIndices[2]);
+		}
+		if (mesh.mNumVertices > MaxShortVertices)
+		{
+			auto parts = SplitMesh(indices, mesh.mNumVertices, layout.Size());
+			reports.resize(parts.size());
+			for (size_t p = 0u; p < parts.size(); ++p)
+			{
+				CookPart(mesh, layout, parts[p].vertices, std::move(parts[p].indices), blob, reports[p]);
+			}
+			if (!parts.empty())
+			{
+				return;
+			}
+		}
+		reports.resize(1u);
+		CookPart(mesh, layout, {}, std::move(indices), blob, reports[0]);
+	}
+}
+
+
+CubeR::VertexLayout MaterialAsset::MakeLayout() const
+{
+	CubeR::VertexLayout layout;
+	layout.Append(halfPositions ? CubeR::VertexLayout::Position3DHalf : CubeR::VertexLayout::Position3D);
+	layout.Append(CubeR::VertexLayout::NormalOct);
+	if (!normalMap.empty())
+	{
+		layout.Append(CubeR::VertexLayout::TangentFrame);
+	}
+	if (!diffuseMap.empty())
+	{
+		layout.Append(halfTexCoords ? CubeR::VertexLayout::Texture2DHalf : CubeR::VertexLayout::Texture2D);
+	}
+	return layout;
+}
+
+
+bool ModelAsset::Load(const std::filesystem::path& sourcePath)
+{
+	if (!LoadMeshes(sourcePath))
+	{
+		return false;
+	}
+	PrepareTextures(sourcePath);
+	return true;
+}
+
+bool ModelAsset::LoadMeshes(const std::filesystem::path& sourcePath)
+{
+	const auto cacheKey = AssetCache::MakeKey(sourcePath, GetImportSettings());
+	if (!cacheKey.empty() && AssetCache::Open(cacheKey, ".cubemesh", file))
+	{
+		//    ,   ,        
+		cooked = Parse(file.GetData(), file.GetSize()) && CheckDependencies(sourcePath);
+		if (!cooked)
+		{
+			file.Close();
+		}
+	}
+	if (!cooked)
+	{
+		if (!Import(sourcePath))
+		{
+			return false;
+		}
+		if (!cacheKey.empty())
+		{
+			AssetCache::Store(cacheKey, ".cubemesh", image.data(), image.size());
+		}
+	}
+	std::vector<uint64_t> dependencyHashes;
+	for (const auto& d : dependencies)
+	{
+		dependencyHashes.push_back(d.hash);
+	}
+	key = cacheKey.empty() ? sourcePath.string() : AssetCache::ExtendKey(cacheKey, dependencyHashes);
+	return true;
+}
+
+bool ModelAsset::CheckDependencies(const std::filesystem::path& sourcePath) const
+{
+	for (const auto& d : dependencies)
+	{
+		uint64_t hash;
+		if (!AssetCache::HashFile(sourcePath.parent_path() / d.path, hash) || hash != d.hash)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string ModelAsset::GetTexturePath(const std::filesystem::path& sourcePath, const std::string& map)
+{
+	return sourcePath.parent_path().string() + "\\" + map;
+}
+
+const TextureData* ModelAsset::GetTexture(const std::string& path, TextureRole role) const noexcept
+{
+	const auto i = textures.find(GetTextureKey(path, role));
+	return i != textures.end() ? i->second.get() : nullptr;
+}
+
+void ModelAsset::PrepareTextures(const std::filesystem::path& sourcePath)
+{
+	//     
+	std::vector<std::string> paths;
+	std::vector<TextureRole> roles;
+	for (const auto& m : materials)
+	{
+		const std::pair<const std::string*, TextureRole> maps[] = {
+			{ &m.diffuseMap, TextureRole::Diffuse },
+			{ &m.specularMap, TextureRole::Specular },
+			{ &m.normalMap, TextureRole::Normal } };
+		for (const auto& map : maps)
+		{
+			if (!map.first->empty() && textures.emplace(GetTextureKey(GetTexturePath(sourcePath, *map.first), map.second), nullptr).second)
+			{
+				paths.push_back(GetTexturePath(sourcePath, *map.first));
+				roles.push_back(map.second);
+			}
+		}
+	}
+	std::vector<std::shared_ptr<const TextureData>> loaded(paths.size());
+	WorkerPool::Get().ParallelFor(paths.size(), [&](size_t i)
+	{
+		loaded[i] = TextureData::Load(paths[i], roles[i]);
+	});
+	for (size_t i = 0u; i < paths.size(); ++i)
+	{
+		textures[GetTextureKey(paths[i], roles[i])] = std::move(loaded[i]);
+	}
+}
+
+std::string ModelAsset::GetImportSettings()
+{
+	//     ,        
+	MaterialAsset full;
+	full.diffuseMap = full.normalMap = "*";
+	return "assimp=" + std::to_string(ImportFlags) +
+		";cubemesh=" + std::to_string(CookedVersion) +
+		";layout=" + full.MakeLayout().GetCode();
+}
+
+bool ModelAsset::Import(const std::filesystem::path& sourcePath)
+{
+	std::vector<std::string> opened;
+	Assimp::Importer imp;
+	//Importer       
+	imp.SetIOHandler(new RecordingIOSystem(opened));
+	const auto pScene = imp.ReadFile(sourcePath.string().c_str(), ImportFlags);
+	if (pScene == nullptr)
+	{
+		error = imp.GetErrorString();
+		return false;
+	}
+
+	//     ,          
+	std::error_code ec;
+	const auto sourceFile = std::filesystem::absolute(sourcePath, ec).lexically_normal();
+	std::vector<std::pair<std::string, uint64_t>> found;
+	for (const auto& name : opened)
+	{
+		const auto path = std::filesystem::absolute(name, ec).lexically_normal();
+		//       ,   
+		auto relative = path.lexically_relative(sourceFile.parent_path()).string();
+		if (relative.empty())
+		{
+			relative = path.string();
+		}
+		uint64_t hash;
+		if (path == sourceFile ||
+			std::any_of(found.begin(), found.end(), [&relative](const auto& f) { return f.first == relative; }) ||
+			!AssetCache::HashFile(path, hash))
+		{
+			continue;
+		}
+		found.emplace_back(std::move(relative), hash);
+	}
+
+	image.clear();
+	ImageWriter writer(image);
+	FileHeader header = {};
+	std::memcpy(header.magic, CookedMagic, sizeof(CookedMagic));
+	header.version = CookedVersion;
+	header.materialCount = pScene->mNumMaterials;
+	header.dependencyCount = static_cast<uint32_t>(found.size());
+	writer.Write(header);
+	for (const auto& f : found)
+	{
+		writer.WriteString(f.first);
+		writer.Write(f.second);
+	}
+	//       ,   -   
+	const size_t meshCountAt = offsetof(FileHeader, meshCount);
+	const size_t nodeCountAt = offsetof(FileHeader, nodeCount);
+
+	//     ,  half ,       
+	std::vector<char> halfPositions(pScene->mNumMeshes);
+	std::vector<char> halfTexCoords(pScene->mNumMeshes);
+	WorkerPool::Get().ParallelFor(pScene->mNumMeshes, [&](size_t i)
+	{
+		halfPositions[i] = FitsHalfPositions(*pScene->mMeshes[i]);
+		halfTexCoords[i] = FitsHalfTexCoords(*pScene->mMeshes[i]);
+	});
+
+	std::vector<MaterialAsset> importedMaterials(pScene->mNumMaterials);
+	for (unsigned int i = 0; i < pScene->mNumMaterials; ++i)
+	{
+		const auto& material = *pScene->mMaterials[i];
+		auto& desc = importedMaterials[i];
+		aiString text;
+		if (material.Get(AI_MATKEY_NAME, text) == aiReturn_SUCCESS)
+		{
+			desc.name = text.C_Str();
+		}
+		if (material.GetTexture(aiTextureType_DIFFUSE, 0, &text) == aiReturn_SUCCESS)
+		{
+			desc.diffuseMap = text.C_Str();
+		}
+		else
+		{
+			material.Get(AI_MATKEY_COLOR_DIFFUSE, reinterpret_cast<aiColor3D&>(desc.diffuseColor));
+		}
+		if (material.GetTexture(aiTextureType_SPECULAR, 0, &text) == aiReturn_SUCCESS)
+		{
+			desc.specularMap = text.C_Str();
+		}
+		else
+		{
+			material.Get(AI_MATKEY_COLOR_SPECULAR, reinterpret_cast<aiColor3D&>(desc.specularColor));
+		}
+		if (material.GetTexture(aiTextureType_NORMALS, 0, &text) == aiReturn_SUCCESS)
+		{
+			desc.normalMap = text.C_Str();
+		}
+		material.Get(AI_MATKEY_SHININESS, desc.shininess);
+		for (unsigned int m = 0; m < pScene->mNumMeshes; ++m)
+		{
+			if (pScene->mMeshes[m]->mMaterialIndex == i)
+			{
+				desc.halfPositions = desc.halfPositions && halfPositions[m];
+				desc.halfTexCoords = desc.halfTexCoords && halfTexCoords[m];
+			}
+		}
+
+		writer.WriteString(desc.name);
+		writer.WriteString(desc.diffuseMap);
+		writer.WriteString(desc.specularMap);
+		writer.WriteString(desc.normalMap);
+		writer.Write(desc.diffuseColor);
+		writer.Write(desc.specularColor);
+		writer.Write(desc.shininess);
+		writer.Write(static_cast<uint32_t>(desc.halfPositions));
+		writer.Write(static_cast<uint32_t>(desc.halfTexCoords));
+	}
+
+	//    ,      
+	std::vector<std::vector<char>> meshBlobs(pScene->mNumMeshes);
+	std::vector<std::vector<MeshOptimizer::Report>> reports(pScene->mNumMeshes);
+	WorkerPool::Get().ParallelFor(pScene->mNumMeshes, [&](size_t i)
+	{
+		const auto& mesh = *pScene->mMeshes[i];
+		CookMesh(mesh, importedMaterials[mesh.mMaterialIndex].MakeLayout(), meshBlobs[i], reports[i]);
+	});
+	std::vector<uint32_t> partCounts(pScene->mNumMeshes);
+	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i)
+	{
+		partCounts[i] = static_cast<uint32_t>(reports[i].size());
+		for (size_t part = 0u; part < reports[i].size(); ++part)
+		{
+			const auto& r = reports[i][part];
+			std::ostringstream line;
+			line << std::fixed << std::setprecision(3) << "Optimized mesh " << pScene->mMeshes[i]->mName.C_Str();
+			if (reports[i].size() > 1u)
+			{
+				line << " part " << part;
+			}
+			line << " of " << sourcePath.string() << ": ACMR " << r.before.acmr << " -> " << r.after.acmr <<
+				", ATVR " << r.before.atvr << " -> " << r.after.atvr;
+			CUBE_TRACE(line.str());
+		}
+	}
+	//       Assimp:      
+	std::vector<uint32_t> firstParts(pScene->mNumMeshes);
+	uint32_t meshCount = 0u;
+	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i)
+	{
+		firstParts[i] = meshCount;
+		meshCount += partCounts[i];
+		writer.Align(16u);
+		writer.WriteBytes(meshBlobs[i].data(), meshBlobs[i].size());
+	}
+	std::memcpy(image.data() + meshCountAt, &meshCount, sizeof(meshCount));
+
+	//     ,     
+	uint32_t nodeCount = 0u;
+	const auto writeNode = [&](const aiNode& node, auto& self) -> void
+	{
+		++nodeCount;
+		writer.WriteString(node.mName.C_Str());
+		DirectX::XMFLOAT4X4 transform;
+		DirectX::XMStoreFloat4x4(&transform, DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(
+			reinterpret_cast<const DirectX::XMFLOAT4X4*>(&node.mTransformation))));
+		writer.Write(transform);
+		uint32_t nodeMeshCount = 0u;
+		for (unsigned int m = 0; m < node.mNumMeshes; ++m)
+		{
+			nodeMeshCount += partCounts[node.mMeshes[m]];
+		}
+		writer.Write(nodeMeshCount);
+		writer.Write(node.mNumChildren);
+		for (unsigned int m = 0; m < node.mNumMeshes; ++m)
+		{
+			for (uint32_t part = 0u; part < partCounts[node.mMeshes[m]]; ++part)
+			{
+				writer.Write(firstParts[node.mMeshes[m]] + part);
+			}
+		}
+		//        
+		const size_t childrenAt = writer.Reserve(sizeof(uint32_t) * node.mNumChildren);
+		for (unsigned int c = 0; c < node.mNumChildren; ++c)
+		{
+			const uint32_t childIndex = nodeCount;
+			std::memcpy(image.data() + childrenAt + sizeof(uint32_t) * c, &childIndex, sizeof(uint32_t));
+			self(*node.mChildren[c], self);
+		}
+	};
+	writeNode(*pScene->mRootNode, writeNode);
+	std::memcpy(image.data() + nodeCountAt, &nodeCount, sizeof(nodeCount));
+
+	if (!Parse(image.data(), image.size()))
+	{
+		error = "Failed to build mesh data for " + sourcePath.string();
+		return false;
+	}
+	return true;
+}
+
+bool ModelAsset::Parse(const char* pData, size_t size)
+{
+	dependencies.clear();
+	materials.clear();
+	meshes.clear();
+	nodes.clear();
+	ImageReader reader(pData, size);
+	const auto header = reader.Read<FileHeader>();
+	if (!reader.IsValid() ||
+		std::memcmp(header.magic, CookedMagic, sizeof(CookedMagic)) != 0 ||
+		header.version != CookedVersion ||
+		header.nodeCount == 0u)
+	{
+		return false;
+	}
+
+	dependencies.resize(header.dependencyCount);
+	for (auto& d : dependencies)
+	{
+		d.path = reader.ReadString();
+		d.hash = reader.Read<uint64_t>();
+	}
+
+	materials.resize(header.materialCount);
+	for (auto& desc : materials)
+	{
+		desc.name = reader.ReadString();
+		desc.diffuseMap = reader.ReadString();
+		desc.specularMap = reader.ReadString();
+		desc.normalMap = reader.ReadString();
+		desc.diffuseColor = reader.Read<DirectX::XMFLOAT4>();
+		desc.specularColor = reader.Read<DirectX::XMFLOAT4>();
+		desc.shininess = reader.Read<float>();
+		desc.halfPositions = reader.Read<uint32_t>() != 0u;
+		desc.halfTexCoords = reader.Read<uint32_t>() != 0u;
+	}
+
+	meshes.resize(header.meshCount);
+	for (auto& mesh : meshes)
+	{
+		reader.Align(16u);
+		const auto record = reader.Read<MeshRecord>();
+		if (!reader.IsValid() || record.materialIndex >= header.materialCount ||
+			record.elementCount == 0u || record.elementCount > CubeR::VertexLayout::Count ||
+			(record.indexSize != sizeof(unsigned short) && record.indexSize != sizeof(uint32_t)))
+		{
+			return false;
+		}
+		mesh.materialIndex = record.materialIndex;
+		mesh.vertexCount = record.vertexCount;
+		mesh.indexSize = record.indexSize;
+		mesh.bounds = record.bounds;
+		for (uint32_t e = 0u; e < record.elementCount; ++e)
+		{
+			const auto type = reader.Read<uint32_t>();
+			if (type >= CubeR::VertexLayout::Count)
+			{
+				return false;
+			}
+			mesh.layout.Append(static_cast<CubeR::VertexLayout::ElementType>(type));
+		}
+		//   :    
+		const auto positionType = mesh.layout.ResolveByIndex(0u).GetType();
+		if (mesh.layout.Size() != record.vertexStride ||
+			(positionType != CubeR::VertexLayout::Position3D && positionType != CubeR::VertexLayout::Position3DHalf))
+		{
+			return false;
+		}
+		mesh.lods.resize(record.lodCount);
+		for (auto& lod : mesh.lods)
+		{
+			lod.count = reader.Read<uint32_t>();
+		}
+		reader.Align(16u);
+		mesh.pVertices = reader.ReadBytes(size_t(record.vertexStride) * record.vertexCount);
+		const auto readIndices = [&reader, &record](MeshAsset::Indices& indices)
+		{
+			reader.Align(4u);
+			indices.pData = reader.ReadBytes(size_t(record.indexSize) * indices.count);
+			for (uint32_t i = 0u; indices.pData != nullptr && i < indices.count; ++i)
+			{
+				const uint32_t index = record.indexSize == sizeof(uint32_t) ?
+					static_cast<const uint32_t*>(indices.pData)[i] :
+					static_cast<const unsigned short*>(indices.pData)[i];
+				if (index >= record.vertexCount)
+				{
+					return false;
+				}
+			}
+			return indices.pData != nullptr;
+		};
+		mesh.indices.count = record.indexCount;
+		if (!readIndices(mesh.indices))
+		{
+			return false;
+		}
+		for (auto& lod : mesh.lods)
+		{
+			if (!readIndices(lod))
+			{
+				return false;
+			}
+		}
+		reader.Align(4u);
+	}
+
+	nodes.resize(header.nodeCount);
+	for (uint32_t n = 0u; n < header.nodeCount; ++n)
+	{
+		auto& node = nodes[n];
+		node.name = reader.ReadString();
+		node.transform = reader.Read<DirectX::XMFLOAT4X4>();
+		node.meshes.resize(reader.Read<uint32_t>());
+		node.children.resize(reader.Read<uint32_t>());
+		if (!reader.IsValid())
+		{
+			return false;
+		}
+		for (auto& m : node.meshes)
+		{
+			m = reader.Read<uint32_t>();
+			if (m >= header.meshCount)
+			{
+				return false;
+			}
+		}
+		//      
+		for (auto& c : node.children)
+		{
+			c = reader.Read<uint32_t>();
+			if (c <= n || c >= header.nodeCount)
+			{
+				return false;
+			}
+		}
+	}
+	return reader.IsValid();
+}
+
+const std::vector<MaterialAsset>& ModelAsset::GetMaterials() const noexcept
+{
+	return materials;
+}
+
+const std::vector<MeshAsset>& ModelAsset::GetMeshes() const noexcept
+{
+	return meshes;
+}
+
+const std::vector<NodeAsset>& ModelAsset::GetNodes() const noexcept
+{
+	return nodes;
+}
+
+BoundingVolume ModelAsset::GetBounds() const noexcept
+{
+	//    ,       
+	std::vector<DirectX::XMFLOAT4X4> accumulated(nodes.size());
+	if (!nodes.empty())
+	{
+		accumulated[0] = nodes[0].transform;
+	}
+	BoundingVolume bounds;
+	for (size_t i = 0u; i < nodes.size(); ++i)
+	{
+		const auto transform = DirectX::XMLoadFloat4x4(&accumulated[i]);
+		for (const auto child : nodes[i].children)
+		{
+			DirectX::XMStoreFloat4x4(&accumulated[child], DirectX::XMLoadFloat4x4(&nodes[child].transform) * transform);
+		}
+		for (const auto mesh : nodes[i].meshes)
+		{
+			bounds = BoundingVolume::Merge(bounds, meshes[mesh].bounds.Transform(transform));
+		}
+	}
+	return bounds;
+}
+
+bool ModelAsset::IsCooked() const noexcept
+{
+	return cooked;
+}
+
+const std::string& ModelAsset::GetKey() const noexcept
+{
+	return key;
+}
+
+const std::string& ModelAsset::GetError() const noexcept
+{
+	return error;
+}
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "../includes/ModelLoader.h"
+#include "../includes/WorkerPool.h"
+#include "../includes/Texture.h"
+#include "../core/includes/Log.h"
+#include <exception>
+#include <limits>
+
+
+ModelLoader::~ModelLoader()
+{
+	for (auto& pJob : jobs)
+	{
+		pJob->cancelled = true;
+	}
+	for (auto& pJob : jobs)
+	{
+		if (pJob->cpu.valid())
+		{
+			pJob->cpu.wait();
+		}
+	}
+}
+
+ModelLoader::Handle ModelLoader::Request(const std::string& path, int id, std::string modelName, Callback onReady)
+{
+	auto pJob = std::make_unique<Job>();
+	pJob->handle = nextHandle++;
+	pJob->path = path;
+	pJob->id = id;
+	pJob->modelName = std::move(modelName);
+	pJob->onReady = std::move(onReady);
+	DirectX::XMStoreFloat4x4(&pJob->placement, DirectX::XMMatrixIdentity());
+	pJob->cpu = WorkerPool::Get().Submit([&job = *pJob]()
+	{
+		if (job.cancelled)
+		{
+			job.stage = Stage::Failed;
+			return;
+		}
+		try
+		{
+			//     ,        
+			job.stage = Stage::Meshes;
+			if (!job.asset.LoadMeshes(job.path))
+			{
+				job.error = job.asset.GetError();
+				job.stage = Stage::Failed;
+				return;
+			}
+			job.bounds = job.asset.GetBounds();
+			job.stage = Stage::Textures;
+			job.asset.PrepareTextures(job.path);
+			job.stage = Stage::Uploading;
+		}
+		catch (const std::exception& e)
+		{
+			job.error = e.what();
+			job.stage = Stage::Failed;
+		}
+	});
+	const auto handle = pJob->handle;
+	jobs.push_back(std::move(pJob));
+	return handle;
+}
+
+void ModelLoader::SetPlacement(Handle handle, DirectX::FXMMATRIX transform) noexcept
+{
+	if (const auto pJob = Find(handle))
+	{
+		DirectX::XMStoreFloat4x4(&pJob->placement, transform);
+	}
+}
+
+void ModelLoader::Cancel(Handle handle) noexcept
+{
+	if (const auto pJob = Find(handle))
+	{
+		pJob->cancelled = true;
+	}
+}
+
+void ModelLoader::CancelAll() noexcept
+{
+	for (auto& pJob : jobs)
+	{
+		pJob->cancelled = true;
+	}
+}
+
+void ModelLoader::Update(Graphics& gfx)
+{
+	lastFrameUpload = 0u;
+	bool stepped = false;
+	for (auto it = jobs.begin(); it != jobs.end();)
+	{
+		auto& job = **it;
+		const auto stage = job.stage.load();
+		if (stage != Stage::Uploading && stage != Stage::Failed)
+		{
+			++it;
+			continue;
+		}
+		if (job.cancelled)
+		{
+			it = jobs.erase(it);
+			continue;
+		}
+		if (stage == Stage::Failed)
+		{
+			CUBE_ERROR("Unable to load model " + job.path + ": " + job.error);
+			it = jobs.erase(it);
+			continue;
+		}
+		if (!job.pModel)
+		{
+			job.pModel.reset(new Model(job.path, job.id, job.modelName));
+			job.materials.reserve(job.asset.GetMaterials().size());
+		}
+		const auto stepCount = GetStepCount(job);
+		while (GetStepsDone(job) < stepCount && (lastFrameUpload < uploadBudget || !stepped))
+		{
+			lastFrameUpload += Step(gfx, job);
+			stepped = true;
+		}
+		if (GetStepsDone(job) < stepCount)
+		{
+			break;
+		}
+		job.pModel->Finish(job.asset);
+		job.onReady(std::move(job.pModel));
+		it = jobs.erase(it);
+	}
+}
+
+void ModelLoader::Flush(Graphics& gfx)
+{
+	for (auto& pJob : jobs)
+	{
+		if (pJob->cpu.valid())
+		{
+			pJob->cpu.wait();
+		}
+	}
+	const auto budget = uploadBudget;
+	uploadBudget = std::numeric_limits<size_t>::max();
+	Update(gfx);
+	uploadBudget = budget;
+}
+
+void ModelLoader::DrawPlaceholders(Graphics& gfx) const
+{
+	std::vector<BoundingVolume> boxes;
+	for (const auto& pJob : jobs)
+	{
+		const auto stage = pJob->stage.load();
+		if (!pJob->cancelled && (stage == Stage::Textures || stage == Stage::Uploading))
+		{
+			boxes.push_back(pJob->bounds.Transform(DirectX::XMLoadFloat4x4(&pJob->placement)));
+		}
+	}
+	gfx.DrawBoxes(boxes);
+}
+
+bool ModelLoader::IsPending(Handle handle) const noexcept
+{
+	const auto pJob = Find(handle);
+	return pJob != nullptr && !pJob->cancelled;
+}
+
+size_t ModelLoader::GetPendingCount() const noexcept
+{
+	size_t count = 0u;
+	for (const auto& pJob : jobs)
+	{
+		if (!pJob->cancelled)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+std::vector<ModelLoader::Progress> ModelLoader::GetProgress() const
+{
+	std::vector<Progress> progress;
+	for (const auto& pJob : jobs)
+	{
+		if (pJob->cancelled)
+		{
+			continue;
+		}
+		const auto stage = pJob->stage.load();
+		float fraction = 0.0f;
+		switch (stage)
+		{
+		case Stage::Queued:
+			fraction = 0.0f;
+			break;
+		case Stage::Meshes:
+			fraction = 0.1f;
+			break;
+		case Stage::Textures:
+			fraction = 0.3f;
+			break;
+		case Stage::Uploading:
+		{
+			const auto stepCount = GetStepCount(*pJob);
+			fraction = 0.6f + (stepCount == 0u ? 0.0f : 0.4f * float(GetStepsDone(*pJob)) / float(stepCount));
+			break;
+		}
+		case Stage::Failed:
+			fraction = 1.0f;
+			break;
+		}
+		progress.push_back({ pJob->handle, pJob->modelName, pJob->path, stage, fraction });
+	}
+	return progress;
+}
+
+void ModelLoader::SetUploadBudget(size_t bytes) noexcept
+{
+	uploadBudget = bytes;
+}
+
+size_t ModelLoader::GetUploadBudget() const noexcept
+{
+	return uploadBudget;
+}
+
+size_t ModelLoader::GetLastFrameUpload() const noexcept
+{
+	return lastFrameUpload;
+}
+
+size_t ModelLoader::Step(Graphics& gfx, Job& job)
+{
+	const auto& materials = job.asset.GetMaterials();
+	if (job.materials.size() < materials.size())
+	{
+		const auto index = job.materials.size();
+		job.materials.emplace_back(gfx, job.asset, job.path, index);
+		// : ,     ,   TextureManager  
+		size_t bytes = 0u;
+		const auto& m = materials[index];
+		const std::pair<const std::string*, TextureRole> maps[] = {
+			{ &m.diffuseMap, TextureRole::Diffuse },
+			{ &m.specularMap, TextureRole::Specular },
+			{ &m.normalMap, TextureRole::Normal } };
+		for (const auto& map : maps)
+		{
+			if (map.first->empty())
+			{
+				continue;
+			}
+			if (const auto pData = job.asset.GetTexture(ModelAsset::GetTexturePath(job.path, *map.first), map.second))
+			{
+				bytes += pData->GetSize();
+			}
+		}
+		return bytes;
+	}
+	const auto index = job.pModel->meshPtrs.size();
+	const auto& mesh = job.asset.GetMeshes()[index];
+	job.pModel->meshPtrs.emplace_back(std::make_unique<Mesh>(gfx, job.materials[mesh.materialIndex], mesh, index));
+	size_t indexCount = mesh.indices.count;
+	for (const auto& lod : mesh.lods)
+	{
+		indexCount += lod.count;
+	}
+	return size_t(mesh.vertexCount) * mesh.layout.Size() + indexCount * mesh.indexSize;
+}
+
+size_t ModelLoader::GetStepCount(const Job& job) noexcept
+{
+	return job.asset.GetMaterials().size() + job.asset.GetMeshes().size();
+}
+
+size_t ModelLoader::GetStepsDone(const Job& job) noexcept
+{
+	return job.materials.size() + (job.pModel ? job.pModel->meshPtrs.size() : 0u);
+}
+
+ModelLoader::Job* ModelLoader::Find(Handle handle) const noexcept
+{
+	for (const auto& pJob : jobs)
+	{
+		if (pJob->handle == handle)
+		{
+			return pJob.get();
+		}
+	}
+	return nullptr;
+}
\ No newline at end of file
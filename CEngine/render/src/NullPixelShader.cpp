@@ -1,4 +1,6 @@
 #include "../includes/NullPixelShader.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
 
 
@@ -7,5 +9,17 @@
 	}
 	void NullPixelShader::Bind(Graphics& gfx) noexcept
 	{
-		GetContext(gfx)->PSSetShader(nullptr, nullptr, 0u);
-	}
\ No newline at end of file
+		GetState(gfx).SetPixelShader(nullptr);
+	}
+	std::shared_ptr<NullPixelShader> NullPixelShader::Resolve(Graphics& gfx)
+	{
+		return BindableCodex::Resolve<NullPixelShader>(gfx);
+	}
+	std::string NullPixelShader::GenerateUID()
+	{
+		return typeid(NullPixelShader).name();
+	}
+	std::string NullPixelShader::GetUID() const noexcept
+	{
+		return GenerateUID();
+	}
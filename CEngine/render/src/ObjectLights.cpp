@@ -0,0 +1,107 @@
+#include "../includes/ObjectLights.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+bool ObjectLightList::operator==(const ObjectLightList& other) const noexcept
+{
+	if (count != other.count)
+	{
+		return false;
+	}
+	const auto n = count == AllLights ? 0u : count;
+	return std::memcmp(indices, other.indices, sizeof(uint32_t) * n) == 0;
+}
+
+bool ObjectLightList::operator!=(const ObjectLightList& other) const noexcept
+{
+	return !(*this == other);
+}
+
+
+void ObjectLights::Clear() noexcept
+{
+	lights.clear();
+}
+
+void ObjectLights::ResetStats() noexcept
+{
+	stats = {};
+}
+
+void ObjectLights::Add(uint32_t index, const DirectX::XMFLOAT3& worldPos, float range, float luminance,
+	float attConst, float attLin, float attQuad)
+{
+	if (range <= 0.0f)
+	{
+		return;
+	}
+	lights.push_back({ worldPos, range, luminance, attConst, attLin, attQuad, index });
+}
+
+void ObjectLights::Select(const BoundingVolume& worldBounds, ObjectLightList& list) noexcept
+{
+	++stats.objects;
+	list.count = 0u;
+	if (worldBounds.IsEmpty())
+	{
+		return;
+	}
+	const auto& c = worldBounds.center;
+	const auto& e = worldBounds.extents;
+	float importance[ObjectLightList::MaxLights];
+	size_t reaching = 0u;
+	for (const auto& l : lights)
+	{
+		//      AABB
+		const float dx = std::max(std::abs(l.pos.x - c.x) - e.x, 0.0f);
+		const float dy = std::max(std::abs(l.pos.y - c.y) - e.y, 0.0f);
+		const float dz = std::max(std::abs(l.pos.z - c.z) - e.z, 0.0f);
+		const float distSq = dx * dx + dy * dy + dz * dz;
+		if (distSq >= l.range * l.range)
+		{
+			continue;
+		}
+		++reaching;
+		const float dist = std::sqrt(distSq);
+		const float value = l.luminance / (l.attConst + l.attLin * dist + l.attQuad * distSq);
+		//      
+		uint32_t slot = list.count;
+		if (slot == ObjectLightList::MaxLights)
+		{
+			if (value <= importance[slot - 1u])
+			{
+				continue;
+			}
+			--slot;
+		}
+		else
+		{
+			++list.count;
+		}
+		while (slot > 0u && importance[slot - 1u] < value)
+		{
+			importance[slot] = importance[slot - 1u];
+			list.indices[slot] = list.indices[slot - 1u];
+			--slot;
+		}
+		importance[slot] = value;
+		list.indices[slot] = l.index;
+	}
+	stats.assigned += list.count;
+	if (reaching > ObjectLightList::MaxLights)
+	{
+		++stats.truncated;
+	}
+}
+
+size_t ObjectLights::GetCount() const noexcept
+{
+	return lights.size();
+}
+
+const ObjectLights::Stats& ObjectLights::GetStats() const noexcept
+{
+	return stats;
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "../includes/OcclusionCuller.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace dx = DirectX;
+
+
+OcclusionCuller::OcclusionCuller(size_t width_in, size_t height_in)
+	:
+	width((std::max(width_in, size_t(4u)) + 3u) & ~size_t(3u)),
+	height(std::max(height_in, size_t(1u)))
+{
+	size_t w = width;
+	size_t h = height;
+	size_t offset = 0u;
+	levels.push_back({ w, h, offset });
+	while (w > 1u || h > 1u)
+	{
+		offset += w * h;
+		w = (w + 1u) / 2u;
+		h = (h + 1u) / 2u;
+		levels.push_back({ w, h, offset });
+	}
+	depth.assign(offset + w * h, 1.0f);
+	dx::XMStoreFloat4x4(&viewProj, dx::XMMatrixIdentity());
+}
+
+void OcclusionCuller::BeginFrame(dx::FXMMATRIX viewProj_in) noexcept
+{
+	dx::XMStoreFloat4x4(&viewProj, viewProj_in);
+	std::fill(depth.begin(), depth.begin() + width * height, 1.0f);
+	stats = {};
+}
+
+void OcclusionCuller::RasterizeOccluder(const Occluder& occluder, dx::FXMMATRIX transform)
+{
+	if (stats.occluderTriangles >= FrameTriangleBudget)
+	{
+		return;
+	}
+	const auto m = transform * dx::XMLoadFloat4x4(&viewProj);
+	screenVertices.resize(occluder.vertices.size());
+	for (size_t i = 0u; i < occluder.vertices.size(); ++i)
+	{
+		const auto clip = dx::XMVector3Transform(dx::XMLoadFloat3(&occluder.vertices[i]), m);
+		const float w = dx::XMVectorGetW(clip);
+		const float z = dx::XMVectorGetZ(clip);
+		auto& sv = screenVertices[i];
+		if (z < 0.0f || w <= 0.0f)
+		{
+			sv.z = -1.0f;
+			continue;
+		}
+		const float invW = 1.0f / w;
+		sv.x = (dx::XMVectorGetX(clip) * invW * 0.5f + 0.5f) * float(width);
+		sv.y = (0.5f - dx::XMVectorGetY(clip) * invW * 0.5f) * float(height);
+		sv.z = z * invW;
+	}
+	for (size_t i = 0u; i + 2u < occluder.indices.size(); i += 3u)
+	{
+		const auto& v0 = screenVertices[occluder.indices[i]];
+		const auto& v1 = screenVertices[occluder.indices[i + 1u]];
+		const auto& v2 = screenVertices[occluder.indices[i + 2u]];
+		//,   , :     
+		if (v0.z < 0.0f || v1.z < 0.0f || v2.z < 0.0f)
+		{
+			continue;
+		}
+		RasterizeTriangle(v0, v1, v2);
+		++stats.occluderTriangles;
+	}
+}
+
+void OcclusionCuller::RasterizeTriangle(const dx::XMFLOAT3& v0, const dx::XMFLOAT3& v1_in, const dx::XMFLOAT3& v2_in) noexcept
+{
+	float area = (v1_in.x - v0.x) * (v2_in.y - v0.y) - (v1_in.y - v0.y) * (v2_in.x - v0.x);
+	if (std::abs(area) < 1e-6f)
+	{
+		return;
+	}
+	//    ,      
+	const bool flip = area < 0.0f;
+	const auto& v1 = flip ? v2_in : v1_in;
+	const auto& v2 = flip ? v1_in : v2_in;
+	area = std::abs(area);
+
+	const int minX = std::max(int(std::floor(std::min({ v0.x, v1.x, v2.x }))), 0) & ~3;
+	const int maxX = std::min(int(std::ceil(std::max({ v0.x, v1.x, v2.x }))), int(width));
+	const int minY = std::max(int(std::floor(std::min({ v0.y, v1.y, v2.y }))), 0);
+	const int maxY = std::min(int(std::ceil(std::max({ v0.y, v1.y, v2.y }))), int(height));
+	if (minX >= maxX || minY >= maxY)
+	{
+		return;
+	}
+
+	//  E(p) = A * x + B * y + C,   .
+	//      ,   
+	const float a0 = v1.y - v2.y, b0 = v2.x - v1.x, c0 = -(a0 * v1.x + b0 * v1.y);
+	const float a1 = v2.y - v0.y, b1 = v0.x - v2.x, c1 = -(a1 * v2.x + b1 * v2.y);
+	const float a2 = v0.y - v1.y, b2 = v1.x - v0.x, c2 = -(a2 * v0.x + b2 * v0.y);
+	//    : z(p) = az * x + bz * y + cz
+	const float invArea = 1.0f / area;
+	const float az = (a0 * v0.z + a1 * v1.z + a2 * v2.z) * invArea;
+	const float bz = (b0 * v0.z + b1 * v1.z + b2 * v2.z) * invArea;
+	const float cz = (c0 * v0.z + c1 * v1.z + c2 * v2.z) * invArea;
+
+	const auto pixelOffsets = dx::XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const auto va0 = dx::XMVectorReplicate(a0);
+	const auto va1 = dx::XMVectorReplicate(a1);
+	const auto va2 = dx::XMVectorReplicate(a2);
+	const auto vaz = dx::XMVectorReplicate(az);
+	const auto zero = dx::XMVectorZero();
+	for (int y = minY; y < maxY; ++y)
+	{
+		const float py = float(y) + 0.5f;
+		const auto row0 = dx::XMVectorReplicate(b0 * py + c0);
+		const auto row1 = dx::XMVectorReplicate(b1 * py + c1);
+		const auto row2 = dx::XMVectorReplicate(b2 * py + c2);
+		const auto rowZ = dx::XMVectorReplicate(bz * py + cz);
+		float* pRow = depth.data() + size_t(y) * width;
+		//   ,         
+		for (int x = minX; x < maxX; x += 4)
+		{
+			const auto px = dx::XMVectorAdd(dx::XMVectorReplicate(float(x)), pixelOffsets);
+			const auto e0 = dx::XMVectorMultiplyAdd(va0, px, row0);
+			const auto e1 = dx::XMVectorMultiplyAdd(va1, px, row1);
+			const auto e2 = dx::XMVectorMultiplyAdd(va2, px, row2);
+			//     ,       
+			const auto inside = dx::XMVectorAndInt(dx::XMVectorGreater(e0, zero),
+				dx::XMVectorAndInt(dx::XMVectorGreater(e1, zero), dx::XMVectorGreater(e2, zero)));
+			if (dx::XMVector4EqualInt(inside, dx::XMVectorFalseInt()))
+			{
+				continue;
+			}
+			const auto z = dx::XMVectorMultiplyAdd(vaz, px, rowZ);
+			const auto d = dx::XMLoadFloat4(reinterpret_cast<const dx::XMFLOAT4*>(pRow + x));
+			dx::XMStoreFloat4(reinterpret_cast<dx::XMFLOAT4*>(pRow + x), dx::XMVectorSelect(d, dx::XMVectorMin(d, z), inside));
+		}
+	}
+}
+
+void OcclusionCuller::BuildHierarchy() noexcept
+{
+	for (size_t l = 1u; l < levels.size(); ++l)
+	{
+		const auto& src = levels[l - 1u];
+		const auto& dst = levels[l];
+		const float* pSrc = depth.data() + src.offset;
+		float* pDst = depth.data() + dst.offset;
+		for (size_t y = 0u; y < dst.height; ++y)
+		{
+			const size_t y0 = y * 2u;
+			const size_t y1 = std::min(y0 + 1u, src.height - 1u);
+			for (size_t x = 0u; x < dst.width; ++x)
+			{
+				const size_t x0 = x * 2u;
+				const size_t x1 = std::min(x0 + 1u, src.width - 1u);
+				pDst[y * dst.width + x] = std::max(
+					std::max(pSrc[y0 * src.width + x0], pSrc[y0 * src.width + x1]),
+					std::max(pSrc[y1 * src.width + x0], pSrc[y1 * src.width + x1]));
+			}
+		}
+	}
+}
+
+bool OcclusionCuller::IsVisible(const BoundingVolume& bounds, dx::FXMMATRIX transform) noexcept
+{
+	++stats.tested;
+	if (bounds.IsEmpty())
+	{
+		return true;
+	}
+	const auto m = transform * dx::XMLoadFloat4x4(&viewProj);
+	const auto center = dx::XMLoadFloat3(&bounds.center);
+	const auto extents = dx::XMLoadFloat3(&bounds.extents);
+	float minX = FLT_MAX, minY = FLT_MAX, minZ = FLT_MAX;
+	float maxX = -FLT_MAX, maxY = -FLT_MAX;
+	for (size_t i = 0u; i < 8u; ++i)
+	{
+		const auto sign = dx::XMVectorSet(
+			(i & 1u) ? 1.0f : -1.0f,
+			(i & 2u) ? 1.0f : -1.0f,
+			(i & 4u) ? 1.0f : -1.0f,
+			0.0f);
+		const auto clip = dx::XMVector3Transform(dx::XMVectorMultiplyAdd(extents, sign, center), m);
+		const float w = dx::XMVectorGetW(clip);
+		const float z = dx::XMVectorGetZ(clip);
+		if (z <= 0.0f || w <= 0.0f)
+		{
+			return true;
+		}
+		const float invW = 1.0f / w;
+		const float sx = (dx::XMVectorGetX(clip) * invW * 0.5f + 0.5f) * float(width);
+		const float sy = (0.5f - dx::XMVectorGetY(clip) * invW * 0.5f) * float(height);
+		minX = std::min(minX, sx);
+		maxX = std::max(maxX, sx);
+		minY = std::min(minY, sy);
+		maxY = std::max(maxY, sy);
+		minZ = std::min(minZ, z * invW);
+	}
+	if (maxX < 0.0f || maxY < 0.0f || minX >= float(width) || minY >= float(height))
+	{
+		return true;
+	}
+	size_t x0 = size_t(std::max(minX, 0.0f));
+	size_t y0 = size_t(std::max(minY, 0.0f));
+	size_t x1 = std::min(size_t(maxX), width - 1u);
+	size_t y1 = std::min(size_t(maxY), height - 1u);
+	//,        2x2 
+	size_t l = 0u;
+	while (l + 1u < levels.size() && ((x1 >> l) - (x0 >> l) > 1u || (y1 >> l) - (y0 >> l) > 1u))
+	{
+		++l;
+	}
+	const auto& level = levels[l];
+	const float* pLevel = depth.data() + level.offset;
+	float maxDepth = 0.0f;
+	for (size_t y = y0 >> l; y <= (y1 >> l); ++y)
+	{
+		for (size_t x = x0 >> l; x <= (x1 >> l); ++x)
+		{
+			maxDepth = std::max(maxDepth, pLevel[y * level.width + x]);
+		}
+	}
+	if (minZ > maxDepth)
+	{
+		++stats.occluded;
+		return false;
+	}
+	return true;
+}
+
+size_t OcclusionCuller::GetWidth() const noexcept
+{
+	return width;
+}
+
+size_t OcclusionCuller::GetHeight() const noexcept
+{
+	return height;
+}
+
+float OcclusionCuller::GetDepth(size_t x, size_t y) const noexcept
+{
+	return depth[y * width + x];
+}
+
+const OcclusionCuller::Stats& OcclusionCuller::GetStats() const noexcept
+{
+	return stats;
+}
\ No newline at end of file
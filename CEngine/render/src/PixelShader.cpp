@@ -1,7 +1,12 @@
 #include "../includes/PixelShader.h"
+#include "../includes/BindableCodex.h"
+#include <filesystem>
+#include <typeinfo>
 
 
 PixelShader::PixelShader(Graphics& gfx, const std::wstring& path)
+	:
+	path(path)
 {
 
 	Microsoft::WRL::ComPtr<ID3DBlob> pBlob;
@@ -11,5 +16,21 @@ PixelShader::PixelShader(Graphics& gfx, const std::wstring& path)
 
 void PixelShader::Bind(Graphics& gfx)  noexcept
 {
-	GetContext(gfx)->PSSetShader(pPixelShader.Get(), nullptr, 0u);
+	GetState(gfx).SetPixelShader(pPixelShader.Get());
+}
+
+std::shared_ptr<PixelShader> PixelShader::Resolve(Graphics& gfx, const std::wstring& path)
+{
+	return BindableCodex::Resolve<PixelShader>(gfx, path);
+}
+
+std::string PixelShader::GenerateUID(const std::wstring& path)
+{
+	using namespace std::string_literals;
+	return typeid(PixelShader).name() + "#"s + std::filesystem::path(path).string();
+}
+
+std::string PixelShader::GetUID() const noexcept
+{
+	return GenerateUID(path);
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "../includes/PointLight.h"
 #include "../includes/FrameCommander.h"
 #include "imgui.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 Lights::PointLight::PointLight(Graphics& gfx, int id, float radius, std::string lightName) : id(id), mesh(gfx, radius), lightName(lightName)
 {
@@ -34,11 +38,14 @@ void Lights::PointLight::SpawnControlWindow() noexcept
 		ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{ 0.8f, 0.1f, 0.15f, 1.0f });
 
 		if (ImGui::Button("X", buttonSize))
+		{
 			cbData.pos.x = -3.0f;
+			dirty = true;
+		}
 		ImGui::PopStyleColor(3);
 
 		ImGui::SameLine();
-		ImGui::DragFloat("##X", &cbData.pos.x, 0.1f);
+		dirty |= ImGui::DragFloat("##X", &cbData.pos.x, 0.1f);
 		ImGui::PopItemWidth();
 		ImGui::SameLine();
 
@@ -47,11 +54,14 @@ void Lights::PointLight::SpawnControlWindow() noexcept
 		ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{ 0.2f, 0.7f, 0.2f, 1.0f });
 
 		if (ImGui::Button("Y", buttonSize))
+		{
 			cbData.pos.y = 4.0f;
+			dirty = true;
+		}
 		ImGui::PopStyleColor(3);
 
 		ImGui::SameLine();
-		ImGui::DragFloat("##Y", &cbData.pos.y, 0.1f);
+		dirty |= ImGui::DragFloat("##Y", &cbData.pos.y, 0.1f);
 		ImGui::PopItemWidth();
 		ImGui::SameLine();
 
@@ -60,23 +70,26 @@ void Lights::PointLight::SpawnControlWindow() noexcept
 		ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{ 0.1f, 0.25f, 0.8f, 1.0f });
 
 		if (ImGui::Button("Z", buttonSize))
+		{
 			cbData.pos.z = -3.0f;
+			dirty = true;
+		}
 		ImGui::PopStyleColor(3);
 
 		ImGui::SameLine();
-		ImGui::DragFloat("##Z", &cbData.pos.z, 0.1f);
+		dirty |= ImGui::DragFloat("##Z", &cbData.pos.z, 0.1f);
 		ImGui::PopItemWidth();
 		ImGui::Columns(1);
 		ImGui::PopStyleVar();
 		ImGui::Text("Intensity/Color");
-		ImGui::SliderFloat("Intensity", &cbData.diffuseIntensity, 0.01f, 20.0f, "%.2f");
-		ImGui::ColorEdit3("Diffuse Color", &cbData.diffuseColor.x);
+		dirty |= ImGui::SliderFloat("Intensity", &cbData.diffuseIntensity, 0.01f, 20.0f, "%.2f");
+		dirty |= ImGui::ColorEdit3("Diffuse Color", &cbData.diffuseColor.x);
 		//ImGui::ColorEdit3("Ambient", &cbData.ambient.x);
 
 		ImGui::Text("Falloff");
-		ImGui::SliderFloat("Constant", &cbData.attConst, 0.05f, 10.0f, "%.2f");
-		ImGui::SliderFloat("Linear", &cbData.attLin, 0.0001f, 0.7f, "%.4f");
-		ImGui::SliderFloat("Quadratic", &cbData.attQuad, 0.0000001f, 0.03f, "%.7f");
+		dirty |= ImGui::SliderFloat("Constant", &cbData.attConst, 0.05f, 10.0f, "%.2f");
+		dirty |= ImGui::SliderFloat("Linear", &cbData.attLin, 0.0001f, 0.7f, "%.4f");
+		dirty |= ImGui::SliderFloat("Quadratic", &cbData.attQuad, 0.0000001f, 0.03f, "%.7f");
 		ImGui::Checkbox("Draw Light Sphere", &drawSphere);
 		if (ImGui::Button("Reset"))
 		{
@@ -102,9 +115,10 @@ void Lights::PointLight::Reset() noexcept
 		0.045f,
 		0.0075f,
 	};
+	dirty = true;
 }
 
-PointLightCBuf Lights::PointLight::getCbuf() const
+const PointLightCBuf& Lights::PointLight::getCbuf() const
 {
 	return cbData;
 }
@@ -113,6 +127,42 @@ PointLightCBuf Lights::PointLight::getCbuf() const
 void Lights::PointLight::setCbuf(PointLightCBuf Cbuf)
 {
 	cbData = Cbuf;
+	dirty = true;
+}
+
+bool Lights::PointLight::IsDirty() const noexcept
+{
+	return dirty;
+}
+
+void Lights::PointLight::ClearDirty() noexcept
+{
+	dirty = false;
+}
+
+float Lights::PointLight::GetLuminance() const noexcept
+{
+	const auto& color = cbData.diffuseColor;
+	return cbData.diffuseIntensity * (0.2126f * color.x + 0.7152f * color.y + 0.0722f * color.z);
+}
+
+float Lights::PointLight::GetRange(float cutoffLuminance) const noexcept
+{
+	//  luminance / (attConst + attLin * d + attQuad * d^2) = cutoffLuminance  d
+	const float c = cbData.attConst - GetLuminance() / cutoffLuminance;
+	if (c >= 0.0f)
+	{
+		return 0.0f;
+	}
+	if (cbData.attQuad > 0.0f)
+	{
+		return (-cbData.attLin + std::sqrt(cbData.attLin * cbData.attLin - 4.0f * cbData.attQuad * c)) / (2.0f * cbData.attQuad);
+	}
+	if (cbData.attLin > 0.0f)
+	{
+		return -c / cbData.attLin;
+	}
+	return std::numeric_limits<float>::max();
 }
 
 void Lights::PointLight::Submit(class FrameCommander& frame) const noexcept
@@ -121,25 +171,22 @@ void Lights::PointLight::Submit(class FrameCommander& frame) const noexcept
 	mesh.Submit(frame);
 }
 
-Lights::Lights(Graphics& gfx, float radius) : cbuf(gfx, 0u, 32u)
+Lights::Lights(Graphics& gfx, float radius)
+	:
+	clusterCbuf(gfx, 0u),
+	lightBuffer(gfx, 4u),
+	clusterBuffer(gfx, 5u, LightClusters::ClusterCount),
+	indexBuffer(gfx, 6u, 1024u)
 {
 	sceneLights.push_back(std::make_unique<PointLight>(gfx, id, 0.5f, "Point Light (R10)"));
 	++id;
-	UpdateCbufs();
 }
 
 void Lights::AddLight(Graphics& gfx, std::string lightName)
 {
-	if (sceneLights.size() < 32)
-	{
-		sceneLights.push_back(std::make_unique<PointLight>(gfx, id, 0.5f, lightName));
-		++id;
-		UpdateCbufs();
-	}
-	else
-	{
-		MessageBoxA(nullptr, "There can only be 32 light sources in a scene.", "Light error", MB_OK | MB_ICONEXCLAMATION);
-	}
+	sceneLights.push_back(std::make_unique<PointLight>(gfx, id, 0.5f, lightName));
+	++id;
+	structureDirty = true;
 }
 
 int Lights::getLighstCount()
@@ -157,7 +204,7 @@ void Lights::DeleteLight(int i)
 	if (sceneLights.size() > 0)
 	{
 		sceneLights.erase(sceneLights.begin() + i);
-		UpdateCbufs();
+		structureDirty = true;
 	}
 	else
 	{
@@ -168,6 +215,7 @@ void Lights::DeleteLight(int i)
 void Lights::clearLights()
 {
 	sceneLights.clear();
+	structureDirty = true;
 }
 
 
@@ -176,14 +224,6 @@ std::string Lights::getName(int i)
 	return sceneLights[i]->lightName;
 }
 
-void Lights::UpdateCbufs()
-{
-	for (int i = 0; i < sceneLights.size(); ++i)
-	{
-		cbufs[i] = sceneLights[i]->getCbuf();
-	}
-}
-
 void Lights::spawnWnds()
 {
 	for (auto& l : sceneLights)
@@ -203,15 +243,152 @@ void Lights::drawSpheres(class FrameCommander& frame)
 	}
 }
 
-void Lights::Bind(Graphics& gfx, DirectX::FXMMATRIX view) noexcept
+void Lights::LightArrays::Resize(size_t n)
 {
-	UpdateCbufs();
-    auto dataCopy = cbufs;
-	for (int i = 0; i < sizeof(cbufs) / sizeof(cbufs[0]); ++i)
+	count = n;
+	const size_t padded = (n + 3u) & ~size_t(3u);
+	for (auto* pArray : { &x, &y, &z, &viewX, &viewY, &viewZ })
 	{
-		const auto pos = DirectX::XMLoadFloat3(&cbufs[i].pos);
-		DirectX::XMStoreFloat3(&dataCopy[i].pos, DirectX::XMVector3Transform(pos, view));
+		pArray->assign(padded, 0.0f);
 	}
-	cbuf.Update(gfx, dataCopy[0], sizeof(cbufs) / sizeof(cbufs[0]));
-	cbuf.Bind(gfx);
+	range.resize(n);
+	luminance.resize(n);
+	gpu.resize(n);
+}
+
+bool Lights::SyncArrays() noexcept
+{
+	bool changed = structureDirty;
+	if (structureDirty)
+	{
+		arrays.Resize(sceneLights.size());
+	}
+	for (size_t i = 0u; i < sceneLights.size(); ++i)
+	{
+		auto& l = *sceneLights[i];
+		if (!structureDirty && !l.IsDirty())
+		{
+			continue;
+		}
+		const auto& data = l.getCbuf();
+		arrays.x[i] = data.pos.x;
+		arrays.y[i] = data.pos.y;
+		arrays.z[i] = data.pos.z;
+		arrays.range[i] = l.GetRange(cutoffLuminance);
+		arrays.luminance[i] = l.GetLuminance();
+		arrays.gpu[i] = { {}, arrays.range[i], data.diffuseColor, data.diffuseIntensity, data.attConst, data.attLin, data.attQuad, 0.0f };
+		l.ClearDirty();
+		changed = true;
+	}
+	structureDirty = false;
+	if (!changed)
+	{
+		return false;
+	}
+
+	//     ,    ,    
+	ambient = { 0.0f,0.0f,0.0f };
+	objectLights.Clear();
+	for (size_t i = 0u; i < sceneLights.size(); ++i)
+	{
+		const auto& data = sceneLights[i]->getCbuf();
+		ambient.x += data.ambient.x;
+		ambient.y += data.ambient.y;
+		ambient.z += data.ambient.z;
+		objectLights.Add(static_cast<uint32_t>(i), data.pos, arrays.range[i], arrays.luminance[i], data.attConst, data.attLin, data.attQuad);
+	}
+	return true;
+}
+
+void Lights::TransformToView(const DirectX::XMFLOAT4X4& view) noexcept
+{
+	namespace dx = DirectX;
+	//v' = x * r0 + y * r1 + z * r2 + r3    ,     
+	const auto m00 = dx::XMVectorReplicate(view._11), m01 = dx::XMVectorReplicate(view._12), m02 = dx::XMVectorReplicate(view._13);
+	const auto m10 = dx::XMVectorReplicate(view._21), m11 = dx::XMVectorReplicate(view._22), m12 = dx::XMVectorReplicate(view._23);
+	const auto m20 = dx::XMVectorReplicate(view._31), m21 = dx::XMVectorReplicate(view._32), m22 = dx::XMVectorReplicate(view._33);
+	const auto m30 = dx::XMVectorReplicate(view._41), m31 = dx::XMVectorReplicate(view._42), m32 = dx::XMVectorReplicate(view._43);
+	for (size_t i = 0u; i < arrays.x.size(); i += 4u)
+	{
+		const auto x = dx::XMLoadFloat4(reinterpret_cast<const dx::XMFLOAT4*>(&arrays.x[i]));
+		const auto y = dx::XMLoadFloat4(reinterpret_cast<const dx::XMFLOAT4*>(&arrays.y[i]));
+		const auto z = dx::XMLoadFloat4(reinterpret_cast<const dx::XMFLOAT4*>(&arrays.z[i]));
+		const auto vx = dx::XMVectorMultiplyAdd(x, m00, dx::XMVectorMultiplyAdd(y, m10, dx::XMVectorMultiplyAdd(z, m20, m30)));
+		const auto vy = dx::XMVectorMultiplyAdd(x, m01, dx::XMVectorMultiplyAdd(y, m11, dx::XMVectorMultiplyAdd(z, m21, m31)));
+		const auto vz = dx::XMVectorMultiplyAdd(x, m02, dx::XMVectorMultiplyAdd(y, m12, dx::XMVectorMultiplyAdd(z, m22, m32)));
+		dx::XMStoreFloat4(reinterpret_cast<dx::XMFLOAT4*>(&arrays.viewX[i]), vx);
+		dx::XMStoreFloat4(reinterpret_cast<dx::XMFLOAT4*>(&arrays.viewY[i]), vy);
+		dx::XMStoreFloat4(reinterpret_cast<dx::XMFLOAT4*>(&arrays.viewZ[i]), vz);
+	}
+	for (size_t i = 0u; i < arrays.count; ++i)
+	{
+		arrays.gpu[i].pos = { arrays.viewX[i], arrays.viewY[i], arrays.viewZ[i] };
+	}
+}
+
+void Lights::Bind(Graphics& gfx, DirectX::FXMMATRIX view_in) noexcept
+{
+	objectLights.ResetStats();
+	const bool lightsChanged = SyncArrays();
+
+	DirectX::XMFLOAT4X4 view;
+	DirectX::XMFLOAT4X4 proj;
+	DirectX::XMStoreFloat4x4(&view, view_in);
+	DirectX::XMStoreFloat4x4(&proj, gfx.GetProjection());
+	const auto& vp = gfx.GetViewport();
+	const bool cameraChanged = std::memcmp(&view, &lastView, sizeof(view)) != 0 ||
+		std::memcmp(&proj, &lastProj, sizeof(proj)) != 0 ||
+		std::memcmp(&vp, &lastViewport, sizeof(vp)) != 0;
+
+	if (lightsChanged || cameraChanged || uploads == 0u)
+	{
+		lastView = view;
+		lastProj = proj;
+		lastViewport = vp;
+		TransformToView(view);
+		clusters.Build(arrays.viewX.data(), arrays.viewY.data(), arrays.viewZ.data(), arrays.range.data(), arrays.count, proj);
+
+		ClusterCBuf cb = {};
+		cb.ambient = ambient;
+		cb.zScale = clusters.GetZScale();
+		cb.zBias = clusters.GetZBias();
+		cb.viewportOrigin = { vp.TopLeftX, vp.TopLeftY };
+		cb.tileScale = { float(LightClusters::GridX) / std::max(vp.Width, 1.0f), float(LightClusters::GridY) / std::max(vp.Height, 1.0f) };
+		clusterCbuf.Update(gfx, cb);
+		lightBuffer.Update(gfx, arrays.gpu.data(), static_cast<UINT>(arrays.count));
+		clusterBuffer.Update(gfx, clusters.GetRanges().data(), LightClusters::ClusterCount);
+		indexBuffer.Update(gfx, clusters.GetIndices().data(), static_cast<UINT>(clusters.GetIndices().size()));
+		++uploads;
+	}
+
+	clusterCbuf.Bind(gfx);
+	lightBuffer.Bind(gfx);
+	clusterBuffer.Bind(gfx);
+	indexBuffer.Bind(gfx);
+}
+
+size_t Lights::GetUploadCount() const noexcept
+{
+	return uploads;
+}
+
+const LightClusters::Stats& Lights::GetClusterStats() const noexcept
+{
+	return clusters.GetStats();
+}
+
+ObjectLights& Lights::GetObjectLights() noexcept
+{
+	return objectLights;
+}
+
+void Lights::SetCutoffLuminance(float luminance) noexcept
+{
+	cutoffLuminance = std::max(luminance, 1e-5f);
+	structureDirty = true;
+}
+
+float Lights::GetCutoffLuminance() const noexcept
+{
+	return cutoffLuminance;
 }
\ No newline at end of file
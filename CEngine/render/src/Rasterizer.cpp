@@ -1,7 +1,11 @@
 #include "../includes/Rasterizer.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
 
 Rasterizer::Rasterizer(Graphics& gfx, bool twoSided)
+	:
+	twoSided(twoSided)
 {
 	D3D11_RASTERIZER_DESC desc = CD3D11_RASTERIZER_DESC(CD3D11_DEFAULT{});
 	desc.CullMode = twoSided ? D3D11_CULL_NONE : D3D11_CULL_BACK;
@@ -10,5 +14,21 @@ Rasterizer::Rasterizer(Graphics& gfx, bool twoSided)
 
 void Rasterizer::Bind(Graphics& gfx)  noexcept
 {
-	GetContext(gfx)->RSSetState(RSCull.Get());
+	GetState(gfx).SetRasterizerState(RSCull.Get());
+}
+
+std::shared_ptr<Rasterizer> Rasterizer::Resolve(Graphics& gfx, bool twoSided)
+{
+	return BindableCodex::Resolve<Rasterizer>(gfx, twoSided);
+}
+
+std::string Rasterizer::GenerateUID(bool twoSided)
+{
+	using namespace std::string_literals;
+	return typeid(Rasterizer).name() + "#"s + (twoSided ? "2s" : "1s");
+}
+
+std::string Rasterizer::GetUID() const noexcept
+{
+	return GenerateUID(twoSided);
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "../includes/RecordingBackend.h"
+
+
+RecordingBackend::RecordingBackend(bool recordLog) noexcept
+	:
+	recordLog(recordLog)
+{}
+
+void RecordingBackend::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept
+{
+	Record(CommandType::Topology, nullptr, UINT(topology));
+}
+
+void RecordingBackend::SetInputLayout(ID3D11InputLayout* pLayout) noexcept
+{
+	Record(CommandType::InputLayout, pLayout);
+}
+
+void RecordingBackend::SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept
+{
+	Record(CommandType::IndexBuffer, pBuffer, UINT(format), offset);
+}
+
+void RecordingBackend::SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept
+{
+	Record(CommandType::VertexBuffer, pBuffer, slot, stride, offset);
+}
+
+void RecordingBackend::SetVertexShader(ID3D11VertexShader* pShader) noexcept
+{
+	Record(CommandType::VertexShader, pShader);
+}
+
+void RecordingBackend::SetPixelShader(ID3D11PixelShader* pShader) noexcept
+{
+	Record(CommandType::PixelShader, pShader);
+}
+
+void RecordingBackend::SetVSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+	Record(CommandType::VSConstantBuffer, pBuffer, slot);
+}
+
+void RecordingBackend::SetVSConstantBufferRange(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept
+{
+	Record(CommandType::VSConstantBuffer, pBuffer, slot, firstConstant, numConstants);
+}
+
+void RecordingBackend::SetPSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+	Record(CommandType::PSConstantBuffer, pBuffer, slot);
+}
+
+void RecordingBackend::SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept
+{
+	Record(CommandType::PSShaderResource, pView, slot);
+}
+
+void RecordingBackend::SetPSSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept
+{
+	Record(CommandType::PSSampler, pSampler, slot);
+}
+
+void RecordingBackend::SetBlendState(ID3D11BlendState* pState) noexcept
+{
+	Record(CommandType::BlendState, pState);
+}
+
+void RecordingBackend::SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept
+{
+	Record(CommandType::DepthStencilState, pState, stencilRef);
+}
+
+void RecordingBackend::SetRasterizerState(ID3D11RasterizerState* pState) noexcept
+{
+	Record(CommandType::RasterizerState, pState);
+}
+
+bool RecordingBackend::SupportsConstantBufferOffsets() const noexcept
+{
+	return true;
+}
+
+void* RecordingBackend::Map(ID3D11Buffer* pBuffer, D3D11_MAP type, size_t offset, size_t size) noexcept
+{
+	Record(CommandType::Map, pBuffer, UINT(type), UINT(offset), UINT(size));
+	uploadedBytes += size;
+	auto& data = mapped[pBuffer];
+	if (data.size() < offset + size)
+	{
+		data.resize(offset + size);
+	}
+	return data.data();
+}
+
+void RecordingBackend::Unmap(ID3D11Buffer* pBuffer) noexcept
+{
+	Record(CommandType::Unmap, pBuffer);
+}
+
+void RecordingBackend::UpdateSubresource(ID3D11Resource* pResource, const void*, UINT rowPitch, size_t size) noexcept
+{
+	Record(CommandType::UpdateSubresource, pResource, rowPitch, UINT(size));
+	uploadedBytes += size;
+}
+
+void RecordingBackend::GenerateMips(ID3D11ShaderResourceView* pView) noexcept
+{
+	Record(CommandType::GenerateMips, pView);
+}
+
+void RecordingBackend::DrawIndexed(UINT count, UINT startIndex, INT baseVertex) noexcept
+{
+	Record(CommandType::DrawIndexed, nullptr, count, startIndex, UINT(baseVertex));
+	indexCount += count;
+}
+
+void RecordingBackend::DrawIndexedInstanced(UINT count, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) noexcept
+{
+	Record(CommandType::DrawIndexedInstanced, nullptr, count, instanceCount, startIndex, startInstance);
+	indexCount += size_t(count) * instanceCount;
+}
+
+const std::vector<RecordingBackend::Command>& RecordingBackend::GetCommands() const noexcept
+{
+	return commands;
+}
+
+size_t RecordingBackend::GetCount(CommandType type) const noexcept
+{
+	return counts[size_t(type)];
+}
+
+size_t RecordingBackend::GetBindCount() const noexcept
+{
+	size_t binds = 0u;
+	for (size_t i = 0u; i <= size_t(CommandType::RasterizerState); ++i)
+	{
+		binds += counts[i];
+	}
+	return binds;
+}
+
+size_t RecordingBackend::GetUploadedBytes() const noexcept
+{
+	return uploadedBytes;
+}
+
+size_t RecordingBackend::GetIndexCount() const noexcept
+{
+	return indexCount;
+}
+
+const std::vector<std::byte>* RecordingBackend::GetMappedData(ID3D11Buffer* pBuffer) const noexcept
+{
+	const auto i = mapped.find(pBuffer);
+	return i == mapped.end() ? nullptr : &i->second;
+}
+
+void RecordingBackend::Clear() noexcept
+{
+	commands.clear();
+	counts.fill(0u);
+	uploadedBytes = 0u;
+	indexCount = 0u;
+}
+
+void RecordingBackend::Record(CommandType type, const void* pObject, UINT a, UINT b, UINT c, UINT d) noexcept
+{
+	++counts[size_t(type)];
+	if (recordLog)
+	{
+		commands.push_back({ type, pObject, { a, b, c, d } });
+	}
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "../includes/Sampler.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
 Sampler::Sampler(Graphics& gfx)
 {
@@ -18,5 +20,20 @@ Sampler::Sampler(Graphics& gfx)
 
 void Sampler::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->PSSetSamplers(0, 1, pSampler.GetAddressOf());
+	GetState(gfx).SetPSSampler(0u, pSampler.Get());
+}
+
+std::shared_ptr<Sampler> Sampler::Resolve(Graphics& gfx)
+{
+	return BindableCodex::Resolve<Sampler>(gfx);
+}
+
+std::string Sampler::GenerateUID()
+{
+	return typeid(Sampler).name();
+}
+
+std::string Sampler::GetUID() const noexcept
+{
+	return GenerateUID();
 }
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include "../includes/SceneBVH.h"
+#include "../includes/Mesh.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace dx = DirectX;
+
+namespace
+{
+	//  AABB :       
+	constexpr float FatMargin = 0.1f;
+	constexpr float FatScale = 0.1f;
+	//  ,     
+	constexpr size_t MinRebuildChanges = 16u;
+}
+
+
+int SceneBVH::Insert(Model* pModel, const BoundingVolume& bounds)
+{
+	assert(pModel != nullptr);
+	const int leaf = AllocateNode();
+	nodes[leaf].tight = ToBox(bounds);
+	nodes[leaf].box = Fatten(nodes[leaf].tight);
+	nodes[leaf].pModel = pModel;
+	InsertLeaf(leaf);
+	++leafCount;
+	++changes;
+	return leaf;
+}
+
+void SceneBVH::Remove(int proxy) noexcept
+{
+	if (proxy < 0)
+	{
+		return;
+	}
+	assert(nodes[proxy].IsLeaf() && nodes[proxy].pModel != nullptr);
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--leafCount;
+}
+
+void SceneBVH::Move(int proxy, const BoundingVolume& bounds) noexcept
+{
+	if (proxy < 0)
+	{
+		return;
+	}
+	const auto box = ToBox(bounds);
+	nodes[proxy].tight = box;
+	if (Contains(nodes[proxy].box, box))
+	{
+		return;
+	}
+	nodes[proxy].box = Fatten(box);
+	//  ,   .    Maintain
+	Refit(nodes[proxy].parent);
+	++stats.refits;
+	++changes;
+}
+
+void SceneBVH::Rebuild()
+{
+	leafScratch.clear();
+	for (int i = 0; i < static_cast<int>(nodes.size()); ++i)
+	{
+		if (nodes[i].IsLeaf())
+		{
+			if (nodes[i].pModel != nullptr)
+			{
+				leafScratch.push_back(i);
+			}
+		}
+		else
+		{
+			FreeNode(i);
+		}
+	}
+	root = leafScratch.empty() ? -1 : Build(leafScratch.data(), leafScratch.size(), -1);
+	changes = 0u;
+	++stats.rebuilds;
+}
+
+void SceneBVH::Maintain()
+{
+	if (changes > std::max(leafCount / 4u, MinRebuildChanges))
+	{
+		Rebuild();
+	}
+}
+
+Model* SceneBVH::Raycast(dx::FXMVECTOR origin, dx::FXMVECTOR dir, float maxDistance, float* pDistance)
+{
+	stats.visited = 0u;
+	if (root < 0)
+	{
+		return nullptr;
+	}
+	dx::XMFLOAT3 o;
+	dx::XMFLOAT3 invDir;
+	dx::XMStoreFloat3(&o, origin);
+	dx::XMStoreFloat3(&invDir, dx::XMVectorReciprocal(dir));
+	//   AABB  .       
+	const auto Hit = [&o, &invDir](const Box& b, float limit)
+	{
+		const float tx1 = (b.min.x - o.x) * invDir.x;
+		const float tx2 = (b.max.x - o.x) * invDir.x;
+		const float ty1 = (b.min.y - o.y) * invDir.y;
+		const float ty2 = (b.max.y - o.y) * invDir.y;
+		const float tz1 = (b.min.z - o.z) * invDir.z;
+		const float tz2 = (b.max.z - o.z) * invDir.z;
+		const float tEnter = std::max({ std::min(tx1, tx2), std::min(ty1, ty2), std::min(tz1, tz2), 0.0f });
+		const float tExit = std::min({ std::max(tx1, tx2), std::max(ty1, ty2), std::max(tz1, tz2), limit });
+		return tEnter <= tExit ? tEnter : -1.0f;
+	};
+
+	Model* pClosest = nullptr;
+	float closest = maxDistance;
+	stack.clear();
+	stack.push_back({ root, false });
+	while (!stack.empty())
+	{
+		const auto& node = nodes[stack.back().index];
+		stack.pop_back();
+		++stats.visited;
+		const float t = Hit(node.box, closest);
+		if (t < 0.0f)
+		{
+			continue;
+		}
+		if (node.IsLeaf())
+		{
+			// box   ,      AABB    
+			float distance;
+			if (Hit(node.tight, closest) >= 0.0f && node.pModel->Raycast(origin, dir, closest, distance))
+			{
+				closest = distance;
+				pClosest = node.pModel;
+			}
+		}
+		else
+		{
+			stack.push_back({ node.right, false });
+			stack.push_back({ node.left, false });
+		}
+	}
+	if (pClosest != nullptr && pDistance != nullptr)
+	{
+		*pDistance = closest;
+	}
+	return pClosest;
+}
+
+SceneBVH::Stats SceneBVH::GetStats() const noexcept
+{
+	auto s = stats;
+	s.leaves = leafCount;
+	s.nodes = nodes.size() - freeNodes.size();
+	return s;
+}
+
+
+SceneBVH::Box SceneBVH::ToBox(const BoundingVolume& bv) noexcept
+{
+	return {
+		{ bv.center.x - bv.extents.x, bv.center.y - bv.extents.y, bv.center.z - bv.extents.z },
+		{ bv.center.x + bv.extents.x, bv.center.y + bv.extents.y, bv.center.z + bv.extents.z }
+	};
+}
+
+SceneBVH::Box SceneBVH::Fatten(const Box& b) noexcept
+{
+	const dx::XMFLOAT3 margin = {
+		FatMargin + (b.max.x - b.min.x) * FatScale,
+		FatMargin + (b.max.y - b.min.y) * FatScale,
+		FatMargin + (b.max.z - b.min.z) * FatScale
+	};
+	return {
+		{ b.min.x - margin.x, b.min.y - margin.y, b.min.z - margin.z },
+		{ b.max.x + margin.x, b.max.y + margin.y, b.max.z + margin.z }
+	};
+}
+
+BoundingVolume SceneBVH::ToVolume(const TreeNode& node) noexcept
+{
+	const auto& b = node.box;
+	BoundingVolume bv;
+	bv.center = { (b.min.x + b.max.x) * 0.5f, (b.min.y + b.max.y) * 0.5f, (b.min.z + b.max.z) * 0.5f };
+	bv.extents = { (b.max.x - b.min.x) * 0.5f, (b.max.y - b.min.y) * 0.5f, (b.max.z - b.min.z) * 0.5f };
+	//  AABB    AABB,       AABB
+	bv.radius = std::sqrt(bv.extents.x * bv.extents.x + bv.extents.y * bv.extents.y + bv.extents.z * bv.extents.z);
+	return bv;
+}
+
+SceneBVH::Box SceneBVH::Union(const Box& a, const Box& b) noexcept
+{
+	return {
+		{ std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) },
+		{ std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) }
+	};
+}
+
+bool SceneBVH::Contains(const Box& outer, const Box& inner) noexcept
+{
+	return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+		inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+
+bool SceneBVH::Overlaps(const Box& a, const Box& b) noexcept
+{
+	return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+		a.min.y <= b.max.y && b.min.y <= a.max.y &&
+		a.min.z <= b.max.z && b.min.z <= a.max.z;
+}
+
+float SceneBVH::Area(const Box& b) noexcept
+{
+	const float x = b.max.x - b.min.x;
+	const float y = b.max.y - b.min.y;
+	const float z = b.max.z - b.min.z;
+	return 2.0f * (x * y + y * z + z * x);
+}
+
+int SceneBVH::AllocateNode()
+{
+	if (freeNodes.empty())
+	{
+		nodes.emplace_back();
+		return static_cast<int>(nodes.size()) - 1;
+	}
+	const int index = freeNodes.back();
+	freeNodes.pop_back();
+	nodes[index] = TreeNode{};
+	return index;
+}
+
+void SceneBVH::FreeNode(int index) noexcept
+{
+	//      
+	nodes[index] = TreeNode{};
+	freeNodes.push_back(index);
+}
+
+void SceneBVH::InsertLeaf(int leaf)
+{
+	if (root < 0)
+	{
+		root = leaf;
+		nodes[leaf].parent = -1;
+		return;
+	}
+	//       
+	const auto leafBox = nodes[leaf].box;
+	int index = root;
+	while (!nodes[index].IsLeaf())
+	{
+		const auto& node = nodes[index];
+		const float area = Area(node.box);
+		const float combined = Area(Union(node.box, leafBox));
+		//        
+		const float cost = 2.0f * combined;
+		// ,       
+		const float inheritance = 2.0f * (combined - area);
+		const auto ChildCost = [this, &leafBox, inheritance](int child)
+		{
+			const auto& c = nodes[child];
+			const float enlarged = Area(Union(c.box, leafBox));
+			return c.IsLeaf() ? enlarged + inheritance : enlarged - Area(c.box) + inheritance;
+		};
+		const float costLeft = ChildCost(node.left);
+		const float costRight = ChildCost(node.right);
+		if (cost < costLeft && cost < costRight)
+		{
+			break;
+		}
+		index = costLeft < costRight ? node.left : node.right;
+	}
+
+	const int sibling = index;
+	const int oldParent = nodes[sibling].parent;
+	const int newParent = AllocateNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].box = Union(leafBox, nodes[sibling].box);
+	nodes[newParent].left = sibling;
+	nodes[newParent].right = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+	if (oldParent < 0)
+	{
+		root = newParent;
+	}
+	else
+	{
+		auto& p = nodes[oldParent];
+		(p.left == sibling ? p.left : p.right) = newParent;
+		Refit(oldParent);
+	}
+}
+
+void SceneBVH::RemoveLeaf(int leaf) noexcept
+{
+	if (leaf == root)
+	{
+		root = -1;
+		return;
+	}
+	const int parent = nodes[leaf].parent;
+	const int grandParent = nodes[parent].parent;
+	const int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+	nodes[sibling].parent = grandParent;
+	if (grandParent < 0)
+	{
+		root = sibling;
+	}
+	else
+	{
+		auto& g = nodes[grandParent];
+		(g.left == parent ? g.left : g.right) = sibling;
+	}
+	FreeNode(parent);
+	if (grandParent >= 0)
+	{
+		Refit(grandParent);
+	}
+}
+
+void SceneBVH::Refit(int index) noexcept
+{
+	while (index >= 0)
+	{
+		auto& node = nodes[index];
+		node.box = Union(nodes[node.left].box, nodes[node.right].box);
+		index = node.parent;
+	}
+}
+
+int SceneBVH::Build(int* pLeaves, size_t count, int parent)
+{
+	if (count == 1u)
+	{
+		nodes[pLeaves[0]].parent = parent;
+		return pLeaves[0];
+	}
+	//       
+	Box centers = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+	for (size_t i = 0u; i < count; ++i)
+	{
+		const auto& b = nodes[pLeaves[i]].box;
+		const dx::XMFLOAT3 c = { (b.min.x + b.max.x) * 0.5f, (b.min.y + b.max.y) * 0.5f, (b.min.z + b.max.z) * 0.5f };
+		centers = Union(centers, { c, c });
+	}
+	const float sx = centers.max.x - centers.min.x;
+	const float sy = centers.max.y - centers.min.y;
+	const float sz = centers.max.z - centers.min.z;
+	const int axis = (sx >= sy && sx >= sz) ? 0 : (sy >= sz ? 1 : 2);
+	const auto Center = [this, axis](int i)
+	{
+		const auto& b = nodes[i].box;
+		return axis == 0 ? b.min.x + b.max.x : (axis == 1 ? b.min.y + b.max.y : b.min.z + b.max.z);
+	};
+	const size_t half = count / 2u;
+	std::nth_element(pLeaves, pLeaves + half, pLeaves + count,
+		[&Center](int a, int b) { return Center(a) < Center(b); });
+
+	const int index = AllocateNode();
+	const int left = Build(pLeaves, half, index);
+	const int right = Build(pLeaves + half, count - half, index);
+	auto& node = nodes[index];
+	node.parent = parent;
+	node.left = left;
+	node.right = right;
+	node.box = Union(nodes[left].box, nodes[right].box);
+	return index;
+}
\ No newline at end of file
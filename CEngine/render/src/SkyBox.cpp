@@ -14,25 +14,23 @@ SkyBox::SkyBox(Graphics& gfx, std::string name) : path(name)
 	auto model = CCube::Make();
 	pVertices = std::make_unique<VertexBuffer>(gfx, model.vertices);
 	pIndices = std::make_unique<IndexBuffer>(gfx, model.indices);
-	pTopology = std::make_unique<Topology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pTopology = Topology::Resolve(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	{
 		Technique skybox;
 		Step only(0);
 
-		auto pvs = std::make_shared<VertexShader>(gfx, L"shaders\\SkyBoxVS.cso");
-		auto pvsbc = pvs->GetBytecode();
+		auto pvs = VertexShader::Resolve(gfx, L"shaders\\SkyBoxVS.cso");
+		only.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), *pvs));
 		only.AddBindable(std::move(pvs));
 
-		only.AddBindable(std::make_shared<PixelShader>(gfx, L"shaders\\SkyBoxPS.cso"));
+		only.AddBindable(PixelShader::Resolve(gfx, L"shaders\\SkyBoxPS.cso"));
 
 
-		only.AddBindable(std::make_shared<InputLayout>(gfx, model.vertices.GetLayout(), pvsbc));
-		
-		only.AddBindable(std::make_shared<Texture>(gfx, name));
-		only.AddBindable(std::make_shared<Sampler>(gfx));
+		only.AddBindable(Texture::Resolve(gfx, name));
+		only.AddBindable(Sampler::Resolve(gfx));
 		only.AddBindable(std::make_shared<SkyboxTransformCbuf>(gfx));
 
-		only.AddBindable(std::make_shared<Rasterizer>(gfx, true));
+		only.AddBindable(Rasterizer::Resolve(gfx, true));
 
 		skybox.AddStep(std::move(only));
 		AddTechnique(std::move(skybox));
@@ -11,17 +11,17 @@ SolidSphere::SolidSphere(Graphics& gfx, float radius)
 	model.Transform(dx::XMMatrixScaling(radius, radius, radius));
 	pVertices = std::make_unique<VertexBuffer>(gfx, model.vertices);
 	pIndices = std::make_unique<IndexBuffer>(gfx, model.indices);
-	pTopology = std::make_unique<Topology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pTopology = Topology::Resolve(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	{
 		Technique solid;
 		Step only(1);
 
-		auto pvs = std::make_shared<VertexShader>(gfx, L"shaders\\SolidVS.cso");
-		auto pvsbc = pvs->GetBytecode();
+		auto pvs = VertexShader::Resolve(gfx, L"shaders\\SolidVS.cso");
+		only.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), *pvs));
 		only.AddBindable(std::move(pvs));
 
-		only.AddBindable(std::make_shared<PixelShader>(gfx, L"shaders\\SolidPS.cso"));
+		only.AddBindable(PixelShader::Resolve(gfx, L"shaders\\SolidPS.cso"));
 
 		struct PSColorConstant
 		{
@@ -30,13 +30,11 @@ SolidSphere::SolidSphere(Graphics& gfx, float radius)
 		} colorConst;
 		only.AddBindable(std::make_shared<PixelConstantBuffer<PSColorConstant>>(gfx, colorConst, 1u));
 
-		only.AddBindable(std::make_shared<InputLayout>(gfx, model.vertices.GetLayout(), pvsbc));
-
 		only.AddBindable(std::make_shared<TransformCbuf>(gfx));
 
-		only.AddBindable(std::make_shared<Blender>(gfx, false));
+		only.AddBindable(Blender::Resolve(gfx, false));
 
-		only.AddBindable(std::make_shared<Rasterizer>(gfx, false));
+		only.AddBindable(Rasterizer::Resolve(gfx, false));
 
 		solid.AddStep(std::move(only));
 		AddTechnique(std::move(solid));
@@ -0,0 +1,154 @@
+#include "../includes/StateTracker.h"
+
+
+StateTracker::StateTracker(RenderBackend& backend) noexcept
+	:
+	backend(backend)
+{}
+
+void StateTracker::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY type) noexcept
+{
+	if (Update(topology, type))
+	{
+		backend.SetPrimitiveTopology(type);
+	}
+}
+
+void StateTracker::SetInputLayout(ID3D11InputLayout* pLayout) noexcept
+{
+	if (Update(inputLayout, pLayout))
+	{
+		backend.SetInputLayout(pLayout);
+	}
+}
+
+void StateTracker::SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept
+{
+	if (Update(indexBuffer, IndexBinding{ pBuffer, format, offset }))
+	{
+		backend.SetIndexBuffer(pBuffer, format, offset);
+	}
+}
+
+void StateTracker::SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept
+{
+	if (Update(vertexBuffers, slot, VertexBinding{ pBuffer, stride, offset }))
+	{
+		backend.SetVertexBuffer(slot, pBuffer, stride, offset);
+	}
+}
+
+void StateTracker::SetVertexShader(ID3D11VertexShader* pShader) noexcept
+{
+	if (Update(vertexShader, pShader))
+	{
+		backend.SetVertexShader(pShader);
+	}
+}
+
+void StateTracker::SetPixelShader(ID3D11PixelShader* pShader) noexcept
+{
+	if (Update(pixelShader, pShader))
+	{
+		backend.SetPixelShader(pShader);
+	}
+}
+
+void StateTracker::SetVSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+	if (Update(vsConstantBuffers, slot, ConstantBinding{ pBuffer, 0u, 0u }))
+	{
+		backend.SetVSConstantBuffer(slot, pBuffer);
+	}
+}
+
+void StateTracker::SetVSConstantBufferRange(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept
+{
+	if (Update(vsConstantBuffers, slot, ConstantBinding{ pBuffer, firstConstant, numConstants }))
+	{
+		backend.SetVSConstantBufferRange(slot, pBuffer, firstConstant, numConstants);
+	}
+}
+
+bool StateTracker::SupportsConstantBufferOffsets() const noexcept
+{
+	return backend.SupportsConstantBufferOffsets();
+}
+
+void StateTracker::SetPSConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+	if (Update(psConstantBuffers, slot, pBuffer))
+	{
+		backend.SetPSConstantBuffer(slot, pBuffer);
+	}
+}
+
+void StateTracker::SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept
+{
+	if (Update(psResources, slot, pView))
+	{
+		backend.SetPSShaderResource(slot, pView);
+	}
+}
+
+void StateTracker::SetPSSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept
+{
+	if (Update(psSamplers, slot, pSampler))
+	{
+		backend.SetPSSampler(slot, pSampler);
+	}
+}
+
+void StateTracker::SetBlendState(ID3D11BlendState* pState) noexcept
+{
+	if (Update(blendState, pState))
+	{
+		backend.SetBlendState(pState);
+	}
+}
+
+void StateTracker::SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept
+{
+	if (Update(depthStencilState, DepthStencilBinding{ pState, stencilRef }))
+	{
+		backend.SetDepthStencilState(pState, stencilRef);
+	}
+}
+
+void StateTracker::SetRasterizerState(ID3D11RasterizerState* pState) noexcept
+{
+	if (Update(rasterizerState, pState))
+	{
+		backend.SetRasterizerState(pState);
+	}
+}
+
+void StateTracker::Invalidate() noexcept
+{
+	topology.known = false;
+	inputLayout.known = false;
+	indexBuffer.known = false;
+	vertexShader.known = false;
+	pixelShader.known = false;
+	blendState.known = false;
+	depthStencilState.known = false;
+	rasterizerState.known = false;
+	for (UINT i = 0u; i < TrackedSlots; ++i)
+	{
+		vertexBuffers[i].known = false;
+		vsConstantBuffers[i].known = false;
+		psConstantBuffers[i].known = false;
+		psResources[i].known = false;
+		psSamplers[i].known = false;
+	}
+}
+
+void StateTracker::ResetStats() noexcept
+{
+	stats = {};
+}
+
+const StateTracker::Stats& StateTracker::GetStats() const noexcept
+{
+	return stats;
+}
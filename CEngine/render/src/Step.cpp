@@ -1,10 +1,76 @@
 #include "../includes/Step.h"
 #include "../includes/Drawable.h"
 #include "../includes/FrameCommander.h"
+#include "../includes/VertexShader.h"
+#include "../includes/PixelShader.h"
+#include "../includes/InputLayout.h"
+#include "../includes/NullPixelShader.h"
+#include "../includes/Texture.h"
+#include "../includes/Blender.h"
+#include <functional>
 
-void Step::Submit(FrameCommander& frame, const Drawable& drawable) const
+namespace
 {
-	frame.Accept(Job{ this,&drawable }, targetPass);
+	uint32_t CombineId(uint32_t seed, const void* p) noexcept
+	{
+		const auto h = static_cast<uint32_t>(std::hash<const void*>{}(p));
+		return seed ^ (h + 0x9e3779b9u + (seed << 6) + (seed >> 2));
+	}
+}
+
+void Step::AddBindable(std::shared_ptr<Bindable> bind_in) noexcept
+{
+	const auto pBind = bind_in.get();
+	if (dynamic_cast<VertexShader*>(pBind) || dynamic_cast<PixelShader*>(pBind) || dynamic_cast<NullPixelShader*>(pBind))
+	{
+		programId = CombineId(programId, pBind);
+	}
+	else if (dynamic_cast<Texture*>(pBind))
+	{
+		textureSetId = CombineId(textureSetId, pBind);
+	}
+	else if (const auto pBlender = dynamic_cast<Blender*>(pBind))
+	{
+		blended = pBlender->IsBlending();
+	}
+	if (!dynamic_cast<VertexShader*>(pBind) && !dynamic_cast<InputLayout*>(pBind) && !dynamic_cast<CloningBindable*>(pBind))
+	{
+		instanceBindables.push_back(bind_in);
+	}
+	bindables.push_back(std::move(bind_in));
+}
+
+void Step::SetInstancedVariant(std::shared_ptr<VertexShader> pVS, std::shared_ptr<InputLayout> pLayout) noexcept
+{
+	pInstancedVS = std::move(pVS);
+	pInstancedLayout = std::move(pLayout);
+}
+
+bool Step::IsInstanceCompatible(const Step& other) const noexcept
+{
+	if (!SupportsInstancing() || !other.SupportsInstancing())
+	{
+		return false;
+	}
+	return this == &other ||
+		(pInstancedVS == other.pInstancedVS &&
+		pInstancedLayout == other.pInstancedLayout &&
+		instanceBindables == other.instanceBindables);
+}
+
+void Step::BindInstanced(Graphics& gfx) const
+{
+	for (const auto& b : instanceBindables)
+	{
+		b->Bind(gfx);
+	}
+	pInstancedVS->Bind(gfx);
+	pInstancedLayout->Bind(gfx);
+}
+
+void Step::Submit(FrameCommander& frame, const Drawable& drawable, const DirectX::XMFLOAT4X4* pTransform, size_t lod, const ObjectLightList* pLights) const
+{
+	frame.Accept(Job{ this,&drawable,pTransform,lod,pLights }, targetPass);
 }
 
 void Step::InitializeParentReferences(const Drawable& parent) noexcept
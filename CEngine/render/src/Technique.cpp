@@ -2,13 +2,13 @@
 #include "../includes/Drawable.h"
 #include "../includes/FrameCommander.h"
 
-void Technique::Submit(FrameCommander& frame, const Drawable& drawable) const noexcept
+void Technique::Submit(FrameCommander& frame, const Drawable& drawable, const DirectX::XMFLOAT4X4* pTransform, size_t lod, const ObjectLightList* pLights) const noexcept
 {
 	if (active)
 	{
 		for (const auto& step : steps)
 		{
-			step.Submit(frame, drawable);
+			step.Submit(frame, drawable, pTransform, lod, pLights);
 		}
 	}
 }
@@ -10,32 +10,34 @@ TestCube::TestCube(Graphics& gfx, float size)
 {
 	namespace dx = DirectX;
 
-	auto model = CCube::MakeIndependentTextured();
+	//PhongVS      ,      
+	auto model = CCube::MakeIndependentTextured<CubeR::StaticVertexLayout<
+		CubeR::VertexLayout::Position3D,
+		CubeR::VertexLayout::NormalOct,
+		CubeR::VertexLayout::Texture2DHalf>>();
 	model.Transform(dx::XMMatrixScaling(size, size, size));
-	model.SetNormalsIndependentFlat();
 	pVertices = std::make_unique<VertexBuffer>(gfx, model.vertices);
 	pIndices = std::make_unique<IndexBuffer>(gfx, model.indices);
-	pTopology = std::make_unique<Topology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pTopology = Topology::Resolve(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	{
 		Technique standard;
 		{
 			Step Phong(1);
 
-			Phong.AddBindable(std::make_shared<Texture>(gfx, "textures\\brickwall.jpg"));
-			Phong.AddBindable(std::make_shared<Sampler>(gfx));
+			Phong.AddBindable(Texture::Resolve(gfx, "textures\\brickwall.jpg"));
+			Phong.AddBindable(Sampler::Resolve(gfx));
 
-			auto pvs = std::make_shared<VertexShader>(gfx, L"shaders\\PhongVS.cso");
-			auto pvsbc = pvs->GetBytecode();
+			auto pvs = VertexShader::Resolve(gfx, L"shaders\\PhongVS.cso");
+			Phong.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), *pvs));
 			Phong.AddBindable(std::move(pvs));
 
-			Phong.AddBindable(std::make_shared<PixelShader>(gfx, L"shaders\\PhongPS.cso"));
+			Phong.AddBindable(PixelShader::Resolve(gfx, L"shaders\\PhongPS.cso"));
 
 			Phong.AddBindable(std::make_shared<PixelConstantBuffer<PSMaterialConstant>>(gfx, pmc, 1u));
 
-			Phong.AddBindable(std::make_shared<InputLayout>(gfx, model.vertices.GetLayout(), pvsbc));
-
 			Phong.AddBindable(std::make_unique<TransformCbuf>(gfx));
+			Phong.AddBindable(LightListCbuf::Resolve(gfx));
 
 			standard.AddStep(std::move(Phong));
 		}
@@ -47,13 +49,10 @@ TestCube::TestCube(Graphics& gfx, float size)
 		{
 			Step mask(2);
 
-			auto pvs = std::make_shared<VertexShader>(gfx, L"shaders\\SolidVS.cso");
-			auto pvsbc = pvs->GetBytecode();
+			auto pvs = VertexShader::Resolve(gfx, L"shaders\\SolidVS.cso");
+			mask.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), *pvs));
 			mask.AddBindable(std::move(pvs));
 
-
-			mask.AddBindable(std::make_shared<InputLayout>(gfx, model.vertices.GetLayout(), pvsbc));
-
 			mask.AddBindable(std::make_shared<TransformCbuf>(gfx));
 
 
@@ -63,13 +62,11 @@ TestCube::TestCube(Graphics& gfx, float size)
 		{
 			Step draw(3);
 
-			auto pvs = std::make_shared<VertexShader>(gfx, L"shaders\\SolidVS.cso");
-			auto pvsbc = pvs->GetBytecode();
+			auto pvs = VertexShader::Resolve(gfx, L"shaders\\SolidVS.cso");
+			draw.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), *pvs));
 			draw.AddBindable(std::move(pvs));
 
-			draw.AddBindable(std::make_shared<PixelShader>(gfx, L"shaders\\SolidPS.cso"));
-
-			draw.AddBindable(std::make_shared<InputLayout>(gfx, model.vertices.GetLayout(), pvsbc));
+			draw.AddBindable(PixelShader::Resolve(gfx, L"shaders\\SolidPS.cso"));
 
 			class TransformCbufScaling : public TransformCbuf
 			{
@@ -83,6 +80,10 @@ TestCube::TestCube(Graphics& gfx, float size)
 					xf.modelViewProj = xf.modelViewProj * scale;
 					UpdateBindImpl(gfx, xf);
 				}
+				std::unique_ptr<CloningBindable> Clone() const noexcept override
+				{
+					return std::make_unique<TransformCbufScaling>(*this);
+				}
 			};
 			draw.AddBindable(std::make_shared<TransformCbufScaling>(gfx));
 
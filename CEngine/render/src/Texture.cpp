@@ -1,139 +1,206 @@
 #include "../includes/Texture.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 #include "DirectXTex.h"
-#include <WICTextureLoader.h>
-#include <DDSTextureLoader.h>
 #include <filesystem>
+#include "../includes/AssetCache.h"
 
 
 namespace wrl = Microsoft::WRL;
 
-Texture::Texture(Graphics & gfx, const std::string name, unsigned int slot) : slot(slot)
+namespace
 {
-	std::wstring wname = std::wstring(name.begin(), name.end());
-
-	std::filesystem::path x(name);
+	//,      :  ,     
+	const std::string TextureSettings = "cook=2;mips=default;bc=default";
 
-	if (x.extension().string() == ".tga")
+	DXGI_FORMAT GetCompressedFormat(TextureRole role, bool hasAlpha) noexcept
 	{
-		DirectX::TexMetadata metadata;
-		DirectX::ScratchImage image;
-		DirectX::ScratchImage fimage;
-		if (SUCCEEDED(DirectX::LoadFromTGAFile(wname.c_str(), &metadata, image)))
+		switch (role)
 		{
-			hasAlpha = !image.IsAlphaAllOpaque();
-
-				if (image.GetImage(0, 0, 0)->format != DXGI_FORMAT_B8G8R8A8_UNORM)
-				{
-					DirectX::ScratchImage converted;
-						DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_B8G8R8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
-						fimage = std::move(converted);
-				}
-				else
-				{
-					fimage = std::move(image);
-				}
-
-			D3D11_TEXTURE2D_DESC textureDesc = {};
-			textureDesc.Width = fimage.GetMetadata().width;
-			textureDesc.Height = fimage.GetMetadata().height;
-			textureDesc.MipLevels = 0;
-			textureDesc.ArraySize = 1;
-			textureDesc.Format = fimage.GetImages()->format;
-			textureDesc.SampleDesc.Count = 1;
-			textureDesc.SampleDesc.Quality = 0;
-			textureDesc.Usage = D3D11_USAGE_DEFAULT;
-			textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
-			textureDesc.CPUAccessFlags = 0;
-			textureDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
-			wrl::ComPtr<ID3D11Texture2D> pTexture;
-			GetDevice(gfx)->CreateTexture2D(&textureDesc, nullptr, &pTexture);
-
-			GetContext(gfx)->UpdateSubresource(pTexture.Get(), 0u, nullptr, fimage.GetPixels(), fimage.GetImages()->rowPitch, 0u);
-
-			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-			srvDesc.Format = textureDesc.Format;
-			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			srvDesc.Texture2D.MostDetailedMip = 0;
-			srvDesc.Texture2D.MipLevels = -1;
-			GetDevice(gfx)->CreateShaderResourceView(pTexture.Get(), &srvDesc, &pTextureView);
-			GetContext(gfx)->GenerateMips(pTextureView.Get());
-			CUBE_TRACE(std::string("Successfully loaded texture ") + name);
-		}
-		else
-		{
-			CUBE_ERROR(std::string("Failed to load a texture ") + name);
+		case TextureRole::Normal:
+			return hasAlpha ? DXGI_FORMAT_BC7_UNORM : DXGI_FORMAT_BC5_UNORM;
+		case TextureRole::Specular:
+			return hasAlpha ? DXGI_FORMAT_BC7_UNORM : DXGI_FORMAT_BC1_UNORM;
+		default:
+			return hasAlpha ? DXGI_FORMAT_BC3_UNORM : DXGI_FORMAT_BC1_UNORM;
 		}
 	}
-	else if (x.extension().string() == ".dds")
-	{
 
-		if (SUCCEEDED(DirectX::CreateDDSTextureFromFileEx(gfx.pDevice.Get(), gfx.pContext.Get(), wname.c_str(), 0, D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, DirectX::DX11::DDS_LOADER_DEFAULT, nullptr, pTextureView.GetAddressOf())))
+	const char* GetRoleName(TextureRole role) noexcept
+	{
+		switch (role)
 		{
-			CUBE_TRACE(std::string("Successfully loaded texture ") + name);
+		case TextureRole::Normal:
+			return "normal";
+		case TextureRole::Specular:
+			return "specular";
+		default:
+			return "diffuse";
 		}
-		else
+	}
+}
+
+std::shared_ptr<const TextureData> TextureData::Load(const std::string& name, TextureRole role)
+{
+	auto pData = std::make_shared<TextureData>();
+	pData->role = role;
+	std::wstring wname = std::wstring(name.begin(), name.end());
+
+	std::filesystem::path x(name);
+
+	if (x.extension().string() == ".dds")
+	{
+		pData->sourceDds = true;
+		pData->contentKey = AssetCache::MakeKey(x, std::string("dds;role=") + GetRoleName(role));
+		if (!pData->mapped.Open(x))
 		{
 			CUBE_ERROR(std::string("Failed to load a texture ") + name);
 		}
+		return pData;
+	}
+
+	//,      ,       DDS
+	const auto key = AssetCache::MakeKey(x, TextureSettings + ";role=" + GetRoleName(role));
+	pData->contentKey = key;
+	if (!key.empty() && AssetCache::Open(key, ".dds", pData->mapped))
+	{
+		return pData;
+	}
+
+	DirectX::TexMetadata metadata;
+	DirectX::ScratchImage image;
+	DirectX::ScratchImage fimage;
+	const bool loaded = x.extension().string() == ".tga" ?
+		SUCCEEDED(DirectX::LoadFromTGAFile(wname.c_str(), &metadata, image)) :
+		SUCCEEDED(DirectX::LoadFromWICFile(wname.c_str(), DirectX::WIC_FLAGS_NONE, &metadata, image));
+	if (!loaded)
+	{
+		CUBE_ERROR(std::string("Failed to load a texture ") + name);
+		return pData;
+	}
+	const bool hasAlpha = !image.IsAlphaAllOpaque();
+
+	if (image.GetImage(0, 0, 0)->format != DXGI_FORMAT_B8G8R8A8_UNORM)
+	{
+		DirectX::ScratchImage converted;
+		DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_B8G8R8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+		fimage = std::move(converted);
 	}
 	else
 	{
-		DirectX::TexMetadata metadata;
-		DirectX::ScratchImage image;
-		DirectX::ScratchImage fimage;
-		if (SUCCEEDED(DirectX::LoadFromWICFile(wname.c_str(), DirectX::WIC_FLAGS_NONE, &metadata, image)))
+		fimage = std::move(image);
+	}
+	//   CPU,      
+	DirectX::ScratchImage mipChain;
+	if (FAILED(DirectX::GenerateMipMaps(*fimage.GetImage(0, 0, 0), DirectX::TEX_FILTER_DEFAULT, 0, mipChain)))
+	{
+		mipChain = std::move(fimage);
+	}
+	// BC  4x4 ,     4   
+	const auto& mipMetadata = mipChain.GetMetadata();
+	if (mipMetadata.width % 4u == 0u && mipMetadata.height % 4u == 0u)
+	{
+		const auto format = GetCompressedFormat(role, hasAlpha);
+		DirectX::ScratchImage compressed;
+		if (SUCCEEDED(DirectX::Compress(mipChain.GetImages(), mipChain.GetImageCount(), mipMetadata, format,
+			format == DXGI_FORMAT_BC7_UNORM ? DirectX::TEX_COMPRESS_BC7_QUICK : DirectX::TEX_COMPRESS_DEFAULT,
+			DirectX::TEX_THRESHOLD_DEFAULT, compressed)))
 		{
-			hasAlpha = !image.IsAlphaAllOpaque();
-
-			if (image.GetImage(0, 0, 0)->format != DXGI_FORMAT_B8G8R8A8_UNORM)
-			{
-				DirectX::ScratchImage converted;
-				DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_B8G8R8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
-				fimage = std::move(converted);
-			}
-			else
-			{
-				fimage = std::move(image);
-			}
-			D3D11_TEXTURE2D_DESC textureDesc = {};
-			textureDesc.Width = fimage.GetMetadata().width;
-			textureDesc.Height = fimage.GetMetadata().height;
-			textureDesc.MipLevels = 0;
-			textureDesc.ArraySize = 1;
-			textureDesc.Format = fimage.GetImages()->format;
-			textureDesc.SampleDesc.Count = 1;
-			textureDesc.SampleDesc.Quality = 0;
-			textureDesc.Usage = D3D11_USAGE_DEFAULT;
-			textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
-			textureDesc.CPUAccessFlags = 0;
-			textureDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
-			wrl::ComPtr<ID3D11Texture2D> pTexture;
-			GetDevice(gfx)->CreateTexture2D(&textureDesc, nullptr, &pTexture);
-
-			GetContext(gfx)->UpdateSubresource(pTexture.Get(), 0u, nullptr, fimage.GetPixels(), fimage.GetImages()->rowPitch, 0u);
-
-			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-			srvDesc.Format = textureDesc.Format;
-			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			srvDesc.Texture2D.MostDetailedMip = 0;
-			srvDesc.Texture2D.MipLevels = -1;
-			GetDevice(gfx)->CreateShaderResourceView(pTexture.Get(), &srvDesc, &pTextureView);
-			GetContext(gfx)->GenerateMips(pTextureView.Get());
-			CUBE_TRACE(std::string("Successfully loaded texture ") + name);
+			mipChain = std::move(compressed);
 		}
 		else
 		{
-			CUBE_ERROR(std::string("Failed to load a texture ") + name);
+			CUBE_WARN(std::string("Failed to compress a texture ") + name);
 		}
 	}
+	//    DX10  DDS
+	auto ddsMetadata = mipChain.GetMetadata();
+	ddsMetadata.SetAlphaMode(hasAlpha ? DirectX::TEX_ALPHA_MODE_STRAIGHT : DirectX::TEX_ALPHA_MODE_OPAQUE);
+	DirectX::Blob blob;
+	if (FAILED(DirectX::SaveToDDSMemory(mipChain.GetImages(), mipChain.GetImageCount(), ddsMetadata,
+		DirectX::DDS_FLAGS_FORCE_DX10_EXT | DirectX::DDS_FLAGS_FORCE_DX10_EXT_MISC2, blob)))
+	{
+		CUBE_ERROR(std::string("Failed to load a texture ") + name);
+		return pData;
+	}
+	const auto pBlob = static_cast<const char*>(blob.GetBufferPointer());
+	pData->bytes.assign(pBlob, pBlob + blob.GetBufferSize());
+	if (!key.empty())
+	{
+		AssetCache::Store(key, ".dds", pData->bytes.data(), pData->bytes.size());
+	}
+	return pData;
+}
+
+bool TextureData::IsValid() const noexcept
+{
+	return GetSize() != 0u;
+}
+
+const char* TextureData::GetData() const noexcept
+{
+	return mapped.IsOpen() ? mapped.GetData() : bytes.data();
+}
+
+size_t TextureData::GetSize() const noexcept
+{
+	return mapped.IsOpen() ? mapped.GetSize() : bytes.size();
+}
+
+const std::string& TextureData::GetContentKey() const noexcept
+{
+	return contentKey;
 }
 
+TextureRole TextureData::GetRole() const noexcept
+{
+	return role;
+}
+
+
+Texture::Texture(Graphics & gfx, const std::string name, unsigned int slot, TextureRole role)
+	:
+	name(name), slot(slot), role(role), pView(TextureManager::Acquire(gfx, name, role))
+{}
+
+Texture::Texture(Graphics& gfx, const std::string name, unsigned int slot, const TextureData& data)
+	:
+	name(name), slot(slot), role(data.GetRole()), pView(TextureManager::Acquire(gfx, name, data))
+{}
+
 bool Texture::HasAlpha() const noexcept
 {
-	return hasAlpha;
+	return pView->HasAlpha();
 }
 
 void Texture::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->PSSetShaderResources(slot, 1, pTextureView.GetAddressOf());
+	GetState(gfx).SetPSShaderResource(slot, pView->Get());
+}
+
+std::shared_ptr<Texture> Texture::Resolve(Graphics& gfx, const std::string& name, unsigned int slot, TextureRole role)
+{
+	return BindableCodex::ResolveWeak<Texture>(gfx, name, slot, role);
+}
+
+std::shared_ptr<Texture> Texture::Resolve(Graphics& gfx, const std::string& name, unsigned int slot, const TextureData& data)
+{
+	return BindableCodex::ResolveWeak<Texture>(gfx, name, slot, data);
+}
+
+std::string Texture::GenerateUID(const std::string& name, unsigned int slot, const TextureData& data)
+{
+	return GenerateUID(name, slot, data.GetRole());
+}
+
+std::string Texture::GenerateUID(const std::string& name, unsigned int slot, TextureRole role)
+{
+	using namespace std::string_literals;
+	return typeid(Texture).name() + "#"s + TextureManager::GetCanonicalPath(name) + "#"s + std::to_string(slot) +
+		"#"s + std::to_string(static_cast<int>(role));
+}
+
+std::string Texture::GetUID() const noexcept
+{
+	return GenerateUID(name, slot, role);
 }
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "../includes/TextureManager.h"
+#include "../includes/Texture.h"
+#include "DirectXTex.h"
+#include <DDSTextureLoader.h>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iterator>
+
+
+namespace wrl = Microsoft::WRL;
+
+namespace
+{
+	//      :    
+	uint64_t GetResourceSize(ID3D11ShaderResourceView* pView)
+	{
+		wrl::ComPtr<ID3D11Resource> pResource;
+		pView->GetResource(&pResource);
+		wrl::ComPtr<ID3D11Texture2D> pTexture;
+		if (FAILED(pResource.As(&pTexture)))
+		{
+			return 0u;
+		}
+		D3D11_TEXTURE2D_DESC desc;
+		pTexture->GetDesc(&desc);
+		uint64_t size = 0u;
+		for (UINT mip = 0u; mip < desc.MipLevels; ++mip)
+		{
+			size_t rowPitch = 0u;
+			size_t slicePitch = 0u;
+			if (SUCCEEDED(DirectX::ComputePitch(desc.Format, std::max(desc.Width >> mip, 1u), std::max(desc.Height >> mip, 1u), rowPitch, slicePitch)))
+			{
+				size += slicePitch;
+			}
+		}
+		return size * desc.ArraySize;
+	}
+}
+
+
+TextureView::~TextureView()
+{
+	TextureManager::Get().Release(*this);
+}
+
+ID3D11ShaderResourceView* TextureView::Get() const noexcept
+{
+	return pView.Get();
+}
+
+bool TextureView::HasAlpha() const noexcept
+{
+	return hasAlpha;
+}
+
+uint64_t TextureView::GetSize() const noexcept
+{
+	return size;
+}
+
+const std::string& TextureView::GetPath() const noexcept
+{
+	return path;
+}
+
+
+std::shared_ptr<const TextureView> TextureManager::Acquire(Graphics& gfx, const std::string& path, TextureRole role)
+{
+	return Get().AcquireImpl(gfx, path, role, nullptr);
+}
+
+std::shared_ptr<const TextureView> TextureManager::Acquire(Graphics& gfx, const std::string& path, const TextureData& data)
+{
+	return Get().AcquireImpl(gfx, path, data.GetRole(), &data);
+}
+
+std::string TextureManager::GetCanonicalPath(const std::string& path)
+{
+	std::error_code ec;
+	auto canonical = std::filesystem::weakly_canonical(path, ec);
+	if (ec)
+	{
+		canonical = std::filesystem::absolute(path, ec).lexically_normal();
+	}
+	auto result = canonical.make_preferred().string();
+	std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+	return result;
+}
+
+TextureManager::Stats TextureManager::GetStats() noexcept
+{
+	auto& manager = Get();
+	std::lock_guard<std::mutex> lock(manager.mtx);
+	return manager.stats;
+}
+
+TextureManager& TextureManager::Get()
+{
+	static TextureManager manager;
+	return manager;
+}
+
+std::shared_ptr<const TextureView> TextureManager::AcquireImpl(Graphics& gfx, const std::string& path, TextureRole role, const TextureData* pData)
+{
+	const auto canonical = GetCanonicalPath(path);
+	const auto pathKey = canonical + "#" + std::to_string(static_cast<int>(role));
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		const auto i = byPath.find(pathKey);
+		if (i != byPath.end())
+		{
+			if (auto pView = i->second.lock())
+			{
+				++stats.pathHits;
+				return pView;
+			}
+		}
+	}
+	std::shared_ptr<const TextureData> pLoaded;
+	if (pData == nullptr)
+	{
+		pLoaded = TextureData::Load(path, role);
+		pData = pLoaded.get();
+	}
+	//            .     ,
+	//   ,      
+	const auto& contentKey = pData->GetContentKey();
+	if (!contentKey.empty())
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		const auto i = byContent.find(contentKey);
+		if (i != byContent.end())
+		{
+			if (auto pView = i->second.lock())
+			{
+				byPath[pathKey] = pView;
+				++stats.contentHits;
+				return pView;
+			}
+		}
+	}
+
+	std::shared_ptr<const TextureView> pCreated = Create(gfx, canonical, *pData);
+	std::shared_ptr<const TextureView> pExisting;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		++stats.textures;
+		stats.residentBytes += pCreated->size;
+		//   ,    
+		if (pCreated->Get() == nullptr)
+		{
+			++stats.misses;
+			return pCreated;
+		}
+		if (!contentKey.empty())
+		{
+			auto& slot = byContent[contentKey];
+			pExisting = slot.lock();
+			if (!pExisting)
+			{
+				slot = pCreated;
+			}
+		}
+		if (!pExisting)
+		{
+			byPath[pathKey] = pCreated;
+			++stats.misses;
+			return pCreated;
+		}
+		//       .       
+		byPath[pathKey] = pExisting;
+		++stats.contentHits;
+	}
+	return pExisting;
+}
+
+std::shared_ptr<TextureView> TextureManager::Create(Graphics& gfx, const std::string& path, const TextureData& data)
+{
+	std::shared_ptr<TextureView> pView(new TextureView());
+	pView->path = path;
+	if (!data.IsValid())
+	{
+		return pView;
+	}
+	const auto pBytes = reinterpret_cast<const uint8_t*>(data.GetData());
+	DirectX::DDS_ALPHA_MODE alphaMode = DirectX::DDS_ALPHA_MODE_UNKNOWN;
+	// .dds    ,   .      
+	const HRESULT hr = data.sourceDds ?
+		DirectX::CreateDDSTextureFromMemoryEx(gfx.pDevice.Get(), gfx.pContext.Get(), pBytes, data.GetSize(), 0, D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, DirectX::DX11::DDS_LOADER_DEFAULT, nullptr, pView->pView.GetAddressOf()) :
+		DirectX::CreateDDSTextureFromMemoryEx(gfx.pDevice.Get(), pBytes, data.GetSize(), 0, D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, DirectX::DX11::DDS_LOADER_DEFAULT, nullptr, pView->pView.GetAddressOf(), &alphaMode);
+	if (FAILED(hr))
+	{
+		pView->pView.Reset();
+		CUBE_ERROR(std::string("Failed to load a texture ") + path);
+		return pView;
+	}
+	pView->hasAlpha = !data.sourceDds && alphaMode != DirectX::DDS_ALPHA_MODE_OPAQUE;
+	pView->size = GetResourceSize(pView->pView.Get());
+	CUBE_TRACE(std::string("Successfully loaded texture ") + path);
+	return pView;
+}
+
+void TextureManager::Release(const TextureView& view) noexcept
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	--stats.textures;
+	stats.residentBytes -= view.size;
+	++stats.freed;
+	PurgeLocked();
+}
+
+void TextureManager::PurgeLocked()
+{
+	for (auto* pMap : { &byPath, &byContent })
+	{
+		for (auto i = pMap->begin(); i != pMap->end();)
+		{
+			i = i->second.expired() ? pMap->erase(i) : std::next(i);
+		}
+	}
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "../includes/Topology.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
 
 Topology::Topology(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type)
@@ -8,5 +10,21 @@ Topology::Topology(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type)
 
 void Topology::Bind(Graphics& gfx)  noexcept
 {
-	GetContext(gfx)->IASetPrimitiveTopology(type);
+	GetState(gfx).SetPrimitiveTopology(type);
+}
+
+std::shared_ptr<Topology> Topology::Resolve(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type)
+{
+	return BindableCodex::Resolve<Topology>(gfx, type);
+}
+
+std::string Topology::GenerateUID(D3D11_PRIMITIVE_TOPOLOGY type)
+{
+	using namespace std::string_literals;
+	return typeid(Topology).name() + "#"s + std::to_string(static_cast<int>(type));
+}
+
+std::string Topology::GetUID() const noexcept
+{
+	return GenerateUID(type);
 }
\ No newline at end of file
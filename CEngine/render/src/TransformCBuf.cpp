@@ -6,11 +6,17 @@
 		if (!pVcbuf)
 		{
 			pVcbuf = std::make_unique<VertexConstantBuffer<Transforms>>(gfx, slot);
+			pRing = std::make_unique<TransformRing>(gfx, slot);
 		}
 	}
 
 	void TransformCbuf::Bind(Graphics& gfx)  noexcept
 	{
+		if (pRing->Contains(gfx.GetTransformSlot()))
+		{
+			pRing->Bind(gfx);
+			return;
+		}
 		UpdateBindImpl(gfx, GetTransforms(gfx));
 	}
 
@@ -19,6 +25,20 @@
 		pParent = &parent;
 	}
 
+	std::unique_ptr<CloningBindable> TransformCbuf::Clone() const noexcept
+	{
+		return std::make_unique<TransformCbuf>(*this);
+	}
+
+	UINT TransformCbuf::WriteFrame(Graphics& gfx, const DirectX::XMFLOAT4X4* const* ppModels, UINT count) noexcept
+	{
+		if (!pRing)
+		{
+			return 0u;
+		}
+		return pRing->Write(gfx, ppModels, count);
+	}
+
 	void TransformCbuf::UpdateBindImpl(Graphics& gfx, const Transforms& tf)
 	{
 		assert(pParent != nullptr);
@@ -29,11 +49,12 @@
 	TransformCbuf::Transforms TransformCbuf::GetTransforms(Graphics& gfx)
 	{
 		assert(pParent != nullptr);
-		const auto modelView = pParent->GetTransformXM() * gfx.GetCamera();
+		const auto modelView = gfx.GetModelTransform() * gfx.GetCamera();
 		return {
 			DirectX::XMMatrixTranspose(modelView),
 			DirectX::XMMatrixTranspose(modelView * gfx.GetProjection())
 		};
 	}
 
-	std::unique_ptr<VertexConstantBuffer<TransformCbuf::Transforms>> TransformCbuf::pVcbuf;
\ No newline at end of file
+	std::unique_ptr<VertexConstantBuffer<TransformCbuf::Transforms>> TransformCbuf::pVcbuf;
+	std::unique_ptr<TransformRing> TransformCbuf::pRing;
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "../includes/TransformPacker.h"
+#include <cstdint>
+
+
+void TransformPacker::Pack(const DirectX::XMFLOAT4X4* const* ppModels, size_t count,
+	DirectX::FXMMATRIX view, DirectX::CXMMATRIX proj, void* pDst) noexcept
+{
+	namespace dx = DirectX;
+	//view * proj     ,      
+	//  ,    
+	const dx::XMMATRIX viewProj = view * proj;
+	auto pOut = static_cast<uint8_t*>(pDst);
+	for (size_t i = 0u; i < count; ++i, pOut += Stride)
+	{
+		const dx::XMMATRIX model = dx::XMLoadFloat4x4(ppModels[i]);
+		const dx::XMMATRIX modelView = dx::XMMatrixMultiplyTranspose(model, view);
+		const dx::XMMATRIX modelViewProj = dx::XMMatrixMultiplyTranspose(model, viewProj);
+		auto& out = *reinterpret_cast<Transforms*>(pOut);
+		dx::XMStoreFloat4x4A(&out.modelView, modelView);
+		dx::XMStoreFloat4x4A(&out.modelViewProj, modelViewProj);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "../includes/TransformRing.h"
+#include <algorithm>
+
+
+TransformRing::TransformRing(Graphics& gfx, UINT slot, UINT capacity)
+	:
+	slot(slot)
+{
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	GetDevice(gfx)->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+	supported = options.ConstantBufferOffsetting && GetState(gfx).SupportsConstantBufferOffsets();
+	noOverwrite = options.MapNoOverwriteOnDynamicConstantBuffer;
+	if (supported)
+	{
+		Create(gfx, capacity);
+	}
+}
+
+bool TransformRing::IsSupported() const noexcept
+{
+	return supported;
+}
+
+UINT TransformRing::Write(Graphics& gfx, const DirectX::XMFLOAT4X4* const* ppModels, UINT count) noexcept
+{
+	frameCount = 0u;
+	if (!supported || count == 0u)
+	{
+		return 0u;
+	}
+	if (count > capacity)
+	{
+		Create(gfx, std::max(count, capacity * 2u));
+	}
+	// NO_OVERWRITE       
+	D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+	if (!noOverwrite || cursor + count > capacity)
+	{
+		cursor = 0u;
+		mapType = D3D11_MAP_WRITE_DISCARD;
+	}
+	auto& backend = GetBackend(gfx);
+	const auto pData = backend.Map(pRingBuffer.Get(), mapType,
+		size_t(cursor) * TransformPacker::Stride, size_t(count) * TransformPacker::Stride);
+	if (!pData)
+	{
+		return 0u;
+	}
+	TransformPacker::Pack(ppModels, count, gfx.GetCamera(), gfx.GetProjection(),
+		static_cast<char*>(pData) + size_t(cursor) * TransformPacker::Stride);
+	backend.Unmap(pRingBuffer.Get());
+
+	frameFirst = cursor;
+	frameCount = count;
+	cursor += count;
+	return frameFirst;
+}
+
+bool TransformRing::Contains(UINT entry) const noexcept
+{
+	return entry >= frameFirst && entry - frameFirst < frameCount;
+}
+
+void TransformRing::Bind(Graphics& gfx) noexcept
+{
+	GetState(gfx).SetVSConstantBufferRange(slot, pRingBuffer.Get(),
+		gfx.GetTransformSlot() * TransformPacker::ConstantsPerEntry, TransformPacker::ConstantsPerEntry);
+}
+
+void TransformRing::Create(Graphics& gfx, UINT capacity_in)
+{
+	capacity = capacity_in;
+	cursor = 0u;
+	D3D11_BUFFER_DESC cbd = {};
+	cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	cbd.Usage = D3D11_USAGE_DYNAMIC;
+	cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	cbd.MiscFlags = 0u;
+	cbd.ByteWidth = UINT(capacity * TransformPacker::Stride);
+	cbd.StructureByteStride = 0u;
+	pRingBuffer.Reset();
+	GetDevice(gfx)->CreateBuffer(&cbd, nullptr, &pRingBuffer);
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "../includes/VertexBuffer.h"
+#include "../includes/BindableCodex.h"
+#include <typeinfo>
 
 
 
@@ -9,6 +11,33 @@ const CubeR::VertexLayout& VertexBuffer::GetLayout() const noexcept
 
 void VertexBuffer::Bind(Graphics& gfx) noexcept
 {
-	const UINT offset = 0u;
-	GetContext(gfx)->IASetVertexBuffers(0u, 1u, pVertexBuffer.GetAddressOf(), &stride, &offset);
+	GetState(gfx).SetVertexBuffer(0u, pVertexBuffer.Get(), stride, 0u);
+}
+
+std::shared_ptr<VertexBuffer> VertexBuffer::Resolve(Graphics& gfx, const std::string& tag, const CubeR::VertexBuffer& vbuf)
+{
+	return BindableCodex::ResolveWeak<VertexBuffer>(gfx, tag, vbuf);
+}
+
+std::shared_ptr<VertexBuffer> VertexBuffer::Resolve(Graphics& gfx, const std::string& tag, const CubeR::VertexLayout& layout, const char* pData, size_t vertexCount)
+{
+	return BindableCodex::ResolveWeak<VertexBuffer>(gfx, tag, layout, pData, vertexCount);
+}
+
+std::string VertexBuffer::GenerateUID(const std::string& tag, const CubeR::VertexBuffer&)
+{
+	using namespace std::string_literals;
+	return typeid(VertexBuffer).name() + "#"s + tag;
+}
+
+std::string VertexBuffer::GenerateUID(const std::string& tag, const CubeR::VertexLayout&, const char*, size_t)
+{
+	using namespace std::string_literals;
+	return typeid(VertexBuffer).name() + "#"s + tag;
+}
+
+std::string VertexBuffer::GetUID() const noexcept
+{
+	using namespace std::string_literals;
+	return tag.empty() ? std::string{} : typeid(VertexBuffer).name() + "#"s + tag;
 }
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include "../includes/VertexShader.h"
+#include "../includes/BindableCodex.h"
+#include <filesystem>
+#include <typeinfo>
 
 
 
 VertexShader::VertexShader(Graphics& gfx, const std::wstring& path)
+	:
+	path(path)
 {
 
 	D3DReadFileToBlob(path.c_str(), &pBytecodeBlob);
@@ -16,10 +21,26 @@ VertexShader::VertexShader(Graphics& gfx, const std::wstring& path)
 
 void VertexShader::Bind(Graphics& gfx)  noexcept
 {
-	GetContext(gfx)->VSSetShader(pVertexShader.Get(), nullptr, 0u);
+	GetState(gfx).SetVertexShader(pVertexShader.Get());
 }
 
 ID3DBlob* VertexShader::GetBytecode() const 
 {
 	return pBytecodeBlob.Get();
+}
+
+std::shared_ptr<VertexShader> VertexShader::Resolve(Graphics& gfx, const std::wstring& path)
+{
+	return BindableCodex::Resolve<VertexShader>(gfx, path);
+}
+
+std::string VertexShader::GenerateUID(const std::wstring& path)
+{
+	using namespace std::string_literals;
+	return typeid(VertexShader).name() + "#"s + std::filesystem::path(path).string();
+}
+
+std::string VertexShader::GetUID() const noexcept
+{
+	return GenerateUID(path);
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "../includes/WorkerPool.h"
+#include <windows.h>
+#include <objbase.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+
+WorkerPool::WorkerPool(size_t threadCount)
+{
+	threads.reserve(threadCount);
+	for (size_t i = 0u; i < threadCount; ++i)
+	{
+		threads.emplace_back(&WorkerPool::WorkerLoop, this);
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stopping = true;
+	}
+	cv.notify_all();
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+}
+
+WorkerPool& WorkerPool::Get()
+{
+	static WorkerPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1u);
+	return pool;
+}
+
+void WorkerPool::ParallelFor(size_t count, const std::function<void(size_t)>& f)
+{
+	if (count == 0u)
+	{
+		return;
+	}
+	struct Shared
+	{
+		std::atomic<size_t> next = 0u;
+		std::atomic<size_t> done = 0u;
+		std::mutex mtx;
+		std::condition_variable cv;
+		std::exception_ptr error;
+	};
+	auto pShared = std::make_shared<Shared>();
+	//,     ,     f  
+	const auto run = [pShared, count, &f]()
+	{
+		for (size_t i; (i = pShared->next.fetch_add(1u)) < count;)
+		{
+			try
+			{
+				f(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(pShared->mtx);
+				if (!pShared->error)
+				{
+					pShared->error = std::current_exception();
+				}
+			}
+			if (pShared->done.fetch_add(1u) + 1u == count)
+			{
+				std::lock_guard<std::mutex> lock(pShared->mtx);
+				pShared->cv.notify_all();
+			}
+		}
+	};
+	const size_t helpers = std::min(threads.size(), count - 1u);
+	for (size_t h = 0u; h < helpers; ++h)
+	{
+		Enqueue(run);
+	}
+	run();
+	std::unique_lock<std::mutex> lock(pShared->mtx);
+	pShared->cv.wait(lock, [&pShared, count]() { return pShared->done.load() == count; });
+	if (pShared->error)
+	{
+		std::rethrow_exception(pShared->error);
+	}
+}
+
+size_t WorkerPool::GetThreadCount() const noexcept
+{
+	return threads.size();
+}
+
+void WorkerPool::Enqueue(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		tasks.push_back(std::move(task));
+	}
+	cv.notify_one();
+}
+
+void WorkerPool::WorkerLoop()
+{
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (stopping && tasks.empty())
+			{
+				break;
+			}
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+	CoUninitialize();
+}
\ No newline at end of file